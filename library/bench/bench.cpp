@@ -0,0 +1,369 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// borealis_bench: microbenchmarks of the hot paths of the library, on a headless
+// platform (see null_platform.hpp) so that they can run on any machine without a GPU.
+//
+// Usage: borealis_bench [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>]
+//                       [--format=console|json] [--out=<file.json>] [--list]
+//
+// The JSON output follows the layout of Google Benchmark, to be compared between commits
+// with the usual tools (compare.py...). Times are in nanoseconds per iteration.
+
+#include <algorithm>
+#include <borealis.hpp>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <regex>
+#include <thread>
+
+#include "bench.hpp"
+#include "null_platform.hpp"
+
+namespace brls::bench
+{
+
+static constexpr size_t MAX_ITERATIONS = 1000000000;
+
+State::State(size_t iterations)
+    : iterations(iterations)
+    , remaining(iterations)
+{
+}
+
+bool State::keepRunning()
+{
+    if (!this->started)
+    {
+        this->started = true;
+        this->resumeTiming();
+    }
+
+    if (this->remaining > 0)
+    {
+        this->remaining--;
+        return true;
+    }
+
+    this->pauseTiming();
+    return false;
+}
+
+void State::pauseTiming()
+{
+    Clock::time_point realEnd = Clock::now();
+    std::clock_t cpuEnd       = std::clock();
+
+    this->realTime += std::chrono::duration<double, std::nano>(realEnd - this->realStart).count();
+    this->cpuTime += (double)(cpuEnd - this->cpuStart) * 1e9 / CLOCKS_PER_SEC;
+}
+
+void State::resumeTiming()
+{
+    this->cpuStart  = std::clock();
+    this->realStart = Clock::now();
+}
+
+size_t State::getIterations()
+{
+    return this->iterations;
+}
+
+double State::getRealTime()
+{
+    return this->realTime;
+}
+
+double State::getCpuTime()
+{
+    return this->cpuTime;
+}
+
+std::vector<Benchmark>& getBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool registerBenchmark(std::string name, BenchmarkFunction function)
+{
+    getBenchmarks().push_back({ name, function });
+    return true;
+}
+
+static FrameContext frameContext;
+
+FrameContext* beginFrame()
+{
+    frameContext            = FrameContext();
+    frameContext.vg         = Application::getNVGContext();
+    frameContext.pixelRatio = (float)Application::windowWidth / (float)Application::windowHeight;
+    frameContext.theme      = Application::getTheme();
+
+    nvgBeginFrame(frameContext.vg, Application::windowWidth, Application::windowHeight, 1.0f);
+    nvgScale(frameContext.vg, Application::windowScale, Application::windowScale);
+
+    return &frameContext;
+}
+
+void endFrame()
+{
+    nvgEndFrame(frameContext.vg);
+}
+
+struct Options
+{
+    std::string filter = ".*";
+    double minTime     = 0.5;
+    size_t repetitions = 1;
+    std::string format = "console";
+    std::string out;
+    bool list = false;
+};
+
+struct Result
+{
+    std::string name;
+    size_t iterations;
+    double realTime; // ns per iteration
+    double cpuTime; // ns per iteration
+};
+
+static Result runOnce(Benchmark& benchmark, double minTime)
+{
+    size_t iterations = 1;
+
+    while (true)
+    {
+        State state(iterations);
+        benchmark.function(state);
+
+        // Views deleted during the benchmark, and sync tasks left behind
+        Threading::performSyncTasks();
+
+        double elapsed = state.getRealTime();
+
+        if (elapsed >= minTime * 1e9 || iterations >= MAX_ITERATIONS)
+            return { benchmark.name, iterations, elapsed / iterations, state.getCpuTime() / iterations };
+
+        // Aim a bit above the min time to be done with the next run, at most 10 times more iterations
+        double multiplier = elapsed > 0 ? std::min(minTime * 1e9 * 1.4 / elapsed, 10.0) : 10.0;
+        iterations        = std::clamp((size_t)std::ceil(iterations * multiplier), iterations + 1, MAX_ITERATIONS);
+    }
+}
+
+static bool parseOptions(int argc, char* argv[], Options* options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        size_t equal    = arg.find('=');
+        std::string key = arg.substr(0, equal);
+        std::string value;
+
+        if (equal != std::string::npos)
+            value = arg.substr(equal + 1);
+
+        try
+        {
+            if (key == "--filter")
+                options->filter = value;
+            else if (key == "--min-time")
+                options->minTime = std::stod(value);
+            else if (key == "--repetitions")
+                options->repetitions = std::max(std::stoul(value), 1ul);
+            else if (key == "--format" && (value == "console" || value == "json"))
+                options->format = value;
+            else if (key == "--out")
+                options->out = value;
+            else if (key == "--list")
+                options->list = true;
+            else
+                return false;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static std::string currentDate()
+{
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    return date;
+}
+
+static nlohmann::ordered_json toJson(const Result& result, std::string runName, std::string runType, size_t repetitions, size_t index)
+{
+    nlohmann::ordered_json json = {
+        { "name", result.name },
+        { "run_name", runName },
+        { "run_type", runType },
+        { "repetitions", repetitions },
+        { "iterations", result.iterations },
+        { "real_time", result.realTime },
+        { "cpu_time", result.cpuTime },
+        { "time_unit", "ns" },
+    };
+
+    if (runType == "aggregate")
+        json["aggregate_name"] = "median";
+    else
+        json["repetition_index"] = index;
+
+    return json;
+}
+
+static void printResult(const Result& result)
+{
+    fmt::print("{:<48} {:>14.1f} ns {:>14.1f} ns {:>12}\n", result.name, result.realTime, result.cpuTime, result.iterations);
+}
+
+static int run(const Options& options, const std::string& executable)
+{
+    std::regex filter;
+    try
+    {
+        filter = std::regex(options.filter);
+    }
+    catch (const std::regex_error& e)
+    {
+        fmt::print(stderr, "Invalid filter \"{}\": {}\n", options.filter, e.what());
+        return 1;
+    }
+
+    std::vector<Benchmark*> selected;
+    for (Benchmark& benchmark : getBenchmarks())
+        if (std::regex_search(benchmark.name, filter))
+            selected.push_back(&benchmark);
+
+    if (options.list)
+    {
+        for (Benchmark* benchmark : selected)
+            fmt::print("{}\n", benchmark->name);
+        return 0;
+    }
+
+    bool console = options.format == "console";
+
+    if (console)
+    {
+        fmt::print("{:<48} {:>17} {:>17} {:>12}\n", "Benchmark", "Time", "CPU", "Iterations");
+        fmt::print("{:-<97}\n", "");
+    }
+
+    nlohmann::ordered_json results = nlohmann::ordered_json::array();
+
+    for (Benchmark* benchmark : selected)
+    {
+        std::vector<Result> repetitions;
+
+        for (size_t i = 0; i < options.repetitions; i++)
+        {
+            Result result = runOnce(*benchmark, options.minTime);
+            repetitions.push_back(result);
+            results.push_back(toJson(result, benchmark->name, "iteration", options.repetitions, i));
+
+            if (console)
+                printResult(result);
+        }
+
+        if (options.repetitions > 1)
+        {
+            auto byTime = [](const Result& a, const Result& b) { return a.realTime < b.realTime; };
+            std::sort(repetitions.begin(), repetitions.end(), byTime);
+
+            Result median = repetitions[repetitions.size() / 2];
+            median.name   = benchmark->name + "_median";
+            results.push_back(toJson(median, benchmark->name, "aggregate", options.repetitions, 0));
+
+            if (console)
+                printResult(median);
+        }
+    }
+
+    nlohmann::ordered_json document = {
+        { "context",
+            {
+                { "date", currentDate() },
+                { "executable", executable },
+                { "num_cpus", std::thread::hardware_concurrency() },
+#ifdef NDEBUG
+                { "library_build_type", "release" },
+#else
+                { "library_build_type", "debug" },
+#endif
+                { "platform", Application::getPlatform()->getName() },
+            } },
+        { "benchmarks", results },
+    };
+
+    if (!console)
+        std::cout << document.dump(2) << std::endl;
+
+    if (!options.out.empty())
+    {
+        std::ofstream file(options.out);
+        if (!file)
+        {
+            fmt::print(stderr, "Unable to write \"{}\"\n", options.out);
+            return 1;
+        }
+        file << document.dump(2) << std::endl;
+    }
+
+    return 0;
+}
+
+} // namespace brls::bench
+
+int main(int argc, char* argv[])
+{
+    brls::bench::Options options;
+    if (!brls::bench::parseOptions(argc, argv, &options))
+    {
+        fmt::print(stderr, "Usage: {} [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>] "
+                           "[--format=console|json] [--out=<file.json>] [--list]\n",
+            argv[0]);
+        return 1;
+    }
+
+    // Keep stdout for the results
+    brls::Logger::setLogOutput(stderr);
+    brls::Logger::setLogLevel(brls::LogLevel::LOG_WARNING);
+
+    if (!brls::Application::init(new brls::NullPlatform()))
+    {
+        brls::Logger::error("Unable to init borealis_bench");
+        return EXIT_FAILURE;
+    }
+
+    brls::Application::createWindow("borealis_bench");
+
+    int status = brls::bench::run(options, argv[0]);
+
+    brls::Application::quit();
+    brls::Application::mainLoop();
+
+    return status;
+}
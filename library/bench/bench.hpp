@@ -0,0 +1,118 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/frame_context.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace brls::bench
+{
+
+// Given to the benchmark functions, that run the measured code once per iteration:
+//
+//     while (state.keepRunning())
+//         doSomething();
+//
+// The clock starts with the first call of keepRunning() and stops once it returns false,
+// the setup before and the cleanup after the loop are not measured.
+class State
+{
+  public:
+    State(size_t iterations);
+
+    bool keepRunning();
+
+    /**
+     * Excludes what happens between pauseTiming() and resumeTiming() from the measure.
+     */
+    void pauseTiming();
+    void resumeTiming();
+
+    size_t getIterations();
+
+    double getRealTime(); // ns
+    double getCpuTime(); // ns
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    size_t iterations;
+    size_t remaining;
+    bool started = false;
+
+    Clock::time_point realStart;
+    std::clock_t cpuStart = 0;
+
+    double realTime = 0;
+    double cpuTime  = 0;
+};
+
+typedef std::function<void(State&)> BenchmarkFunction;
+
+struct Benchmark
+{
+    std::string name;
+    BenchmarkFunction function;
+};
+
+/**
+ * Registers a benchmark, run by borealis_bench if its name matches the filter.
+ * Returns true so that it can be used to register benchmarks statically.
+ */
+bool registerBenchmark(std::string name, BenchmarkFunction function);
+
+std::vector<Benchmark>& getBenchmarks();
+
+/**
+ * Frame context of the null video context, to draw views outside of the main loop.
+ * Views must be drawn between beginFrame() and endFrame().
+ */
+FrameContext* beginFrame();
+void endFrame();
+
+/**
+ * Prevents the compiler from optimizing the computation of value away.
+ */
+template <typename T>
+inline void doNotOptimize(T const& value)
+{
+#ifdef _MSC_VER
+    static const void* volatile sink;
+    sink = &value;
+#else
+    asm volatile(""
+                 :
+                 : "r,m"(value)
+                 : "memory");
+#endif
+}
+
+} // namespace brls::bench
+
+#define BRLS_BENCHMARK_CONCAT2(a, b) a##b
+#define BRLS_BENCHMARK_CONCAT(a, b) BRLS_BENCHMARK_CONCAT2(a, b)
+
+/**
+ * Registers the given function as a benchmark with the given name.
+ */
+#define BRLS_BENCHMARK(name, function) \
+    static bool BRLS_BENCHMARK_CONCAT(benchmarkRegistered, __LINE__) = brls::bench::registerBenchmark(name, function)
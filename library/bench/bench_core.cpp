@@ -0,0 +1,147 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Lookups and services used every frame: style, theme, i18n, sync tasks, texture cache
+
+#include <atomic>
+#include <borealis.hpp>
+#include <borealis/core/cache_helper.hpp>
+#include <random>
+#include <thread>
+
+#include "bench.hpp"
+
+using namespace brls::literals;
+
+namespace brls::bench
+{
+
+BRLS_BENCHMARK("style/lookup", [](State& state)
+    {
+        while (state.keepRunning())
+            doNotOptimize(Application::getStyle()["brls/sidebar/padding_left"]);
+    });
+
+BRLS_BENCHMARK("theme/lookup_name", [](State& state)
+    {
+        while (state.keepRunning())
+            doNotOptimize(Application::getTheme()["brls/text"]);
+    });
+
+BRLS_BENCHMARK("theme/lookup_id", [](State& state)
+    {
+        ThemeColor textColor = Theme::color("brls/text");
+
+        while (state.keepRunning())
+            doNotOptimize(Application::getTheme()[textColor]);
+    });
+
+BRLS_BENCHMARK("i18n/lookup", [](State& state)
+    {
+        while (state.keepRunning())
+            doNotOptimize("hints/ok"_i18n);
+    });
+
+BRLS_BENCHMARK("i18n/lookup_missing", [](State& state)
+    {
+        while (state.keepRunning())
+            doNotOptimize("borealis_bench/missing"_i18n);
+    });
+
+BRLS_BENCHMARK("i18n/format", [](State& state)
+    {
+        while (state.keepRunning())
+            doNotOptimize(getStr("hints/ok", 42));
+    });
+
+// Tasks posted and run on the UI thread, a batch at a time like the main loop does
+BRLS_BENCHMARK("sync/post", [](State& state)
+    {
+        size_t counter = 0;
+        size_t pending = 0;
+
+        while (state.keepRunning())
+        {
+            brls::sync([&counter]() { counter++; });
+
+            if (++pending == 64)
+            {
+                Threading::performSyncTasks();
+                pending = 0;
+            }
+        }
+
+        Threading::performSyncTasks();
+        doNotOptimize(counter);
+    });
+
+// Tasks posted from another thread while the UI thread runs them, one task per iteration
+BRLS_BENCHMARK("sync/cross_thread", [](State& state)
+    {
+        size_t tasks = state.getIterations();
+        std::atomic<size_t> counter(0);
+        std::thread producer;
+
+        size_t done = 0;
+        while (state.keepRunning())
+        {
+            if (done++ == 0)
+            {
+                producer = std::thread([tasks, &counter]()
+                    {
+                        for (size_t i = 0; i < tasks; i++)
+                            brls::sync([&counter]() { counter++; });
+                    });
+            }
+
+            while (counter.load() < done)
+                Threading::performSyncTasks();
+        }
+
+        producer.join();
+    });
+
+// Lookups of images by key, with more keys than the cache can hold: one miss creates
+// a texture and may evict another one
+BRLS_BENCHMARK("texture_cache/churn", [](State& state)
+    {
+        NVGcontext* vg                  = Application::getNVGContext();
+        TextureCache& cache             = TextureCache::instance();
+        unsigned char pixels[4 * 4 * 4] = { 0 };
+
+        std::vector<std::string> keys;
+        for (int i = 0; i < 300; i++)
+            keys.push_back(fmt::format("borealis_bench/texture/{}", i));
+
+        std::minstd_rand random(42);
+        std::uniform_int_distribution<size_t> distribution(0, keys.size() - 1);
+
+        while (state.keepRunning())
+        {
+            const std::string& key = keys[distribution(random)];
+
+            int texture = cache.getCache(key);
+            if (texture <= 0)
+            {
+                texture = nvgCreateImageRGBA(vg, 4, 4, 0, pixels);
+                cache.addCache(key, texture);
+            }
+
+            cache.removeCache(texture);
+        }
+    });
+
+} // namespace brls::bench
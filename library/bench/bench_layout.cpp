@@ -0,0 +1,243 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Layout and drawing of view trees: large Box trees, RecyclerFrame scrolling, Label text
+
+#include <borealis.hpp>
+
+#include "bench.hpp"
+
+namespace brls::bench
+{
+
+// Column of rows of leaves, with padding, margins and growing children: about `count` boxes
+static Box* createBoxTree(size_t count)
+{
+    Box* root = new Box(Axis::COLUMN);
+    root->setDimensions(1280, 720);
+    root->setPadding(20);
+
+    for (size_t row = 0; row < count / 10; row++)
+    {
+        Box* box = new Box(Axis::ROW);
+        box->setPadding(4);
+        box->setMarginBottom(2);
+        box->setBackgroundColor(nvgRGB(40, 40, 40));
+
+        for (size_t leaf = 0; leaf < 9; leaf++)
+        {
+            Box* child = new Box();
+            child->setHeight(20);
+            child->setGrow(1);
+            child->setMarginRight(2);
+            child->setBackgroundColor(nvgRGB(200, 200, 200));
+            box->addView(child);
+        }
+
+        root->addView(box);
+    }
+
+    root->invalidate();
+    return root;
+}
+
+static void layoutBoxTree(State& state, size_t count)
+{
+    Box* root = createBoxTree(count);
+
+    // Changing the width of the root dirties the whole tree
+    float width = 1280;
+    while (state.keepRunning())
+    {
+        width = width == 1280 ? 1279 : 1280;
+        root->setWidth(width);
+    }
+
+    delete root;
+}
+
+BRLS_BENCHMARK("layout/box_tree/1000", [](State& state) { layoutBoxTree(state, 1000); });
+BRLS_BENCHMARK("layout/box_tree/10000", [](State& state) { layoutBoxTree(state, 10000); });
+
+BRLS_BENCHMARK("layout/box_tree_cached/10000", [](State& state)
+    {
+        Box* root = createBoxTree(10000);
+
+        while (state.keepRunning())
+            root->invalidate();
+
+        delete root;
+    });
+
+static void drawBoxTree(State& state, size_t count, bool drawList)
+{
+    Box* root = createBoxTree(count);
+    DrawList::setEnabled(drawList);
+
+    while (state.keepRunning())
+    {
+        FrameContext* ctx = beginFrame();
+        root->frame(ctx);
+        endFrame();
+    }
+
+    DrawList::setEnabled(false);
+    delete root;
+}
+
+BRLS_BENCHMARK("draw/box_tree/1000", [](State& state) { drawBoxTree(state, 1000, false); });
+BRLS_BENCHMARK("draw/box_tree_draw_list/1000", [](State& state) { drawBoxTree(state, 1000, true); });
+
+class BenchCell : public RecyclerCell
+{
+  public:
+    BenchCell()
+    {
+        this->setAlignItems(AlignItems::CENTER);
+        this->setPadding(0, 20, 0, 20);
+
+        this->label = new Label();
+        this->label->setGrow(1);
+        this->addView(this->label);
+    }
+
+    Label* label;
+};
+
+class BenchDataSource : public RecyclerDataSource
+{
+  public:
+    static constexpr int ROWS       = 10000;
+    static constexpr float ROW_SIZE = 60;
+
+    int numberOfRows(RecyclerFrame* recycler, int section) override
+    {
+        return ROWS;
+    }
+
+    float heightForRow(RecyclerFrame* recycler, IndexPath index) override
+    {
+        return ROW_SIZE;
+    }
+
+    RecyclerCell* cellForRow(RecyclerFrame* recycler, IndexPath index) override
+    {
+        BenchCell* cell = (BenchCell*)recycler->dequeueReusableCell("Cell");
+        cell->label->setText(fmt::format("Row #{}", index.row));
+        return cell;
+    }
+};
+
+BRLS_BENCHMARK("recycler/scroll/10000", [](State& state)
+    {
+        Box* root = new Box(Axis::COLUMN);
+        root->setDimensions(1280, 720);
+
+        RecyclerFrame* recycler = new RecyclerFrame();
+        recycler->setGrow(1);
+        recycler->registerCell("Cell", []() { return new BenchCell(); });
+        recycler->setDataSource(new BenchDataSource());
+        root->addView(recycler);
+
+        // The recycler loads its data when its width changes
+        root->invalidate();
+        root->setWidth(1279);
+
+        float maxOffset = BenchDataSource::ROWS * BenchDataSource::ROW_SIZE - 720;
+        float offset    = 0;
+
+        // One frame per iteration, scrolling a bit more than a row every frame
+        while (state.keepRunning())
+        {
+            offset += BenchDataSource::ROW_SIZE * 1.5f;
+            if (offset > maxOffset)
+                offset = 0;
+
+            recycler->setContentOffsetY(offset, false);
+
+            FrameContext* ctx = beginFrame();
+            root->frame(ctx);
+            endFrame();
+        }
+
+        delete root;
+    });
+
+static const std::string shortText    = "Lorem ipsum";
+static const std::string shortTextAlt = "Dolor sit amet";
+
+static const std::string wrappedText = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore "
+                                       "et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+                                       "aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse.";
+
+static const std::string wrappedTextAlt = "Sed ut perspiciatis unde omnis iste natus error sit voluptatem accusantium doloremque laudantium, "
+                                          "totam rem aperiam, eaque ipsa quae ab illo inventore veritatis et quasi architecto beatae vitae "
+                                          "dicta sunt explicabo. Nemo enim ipsam voluptatem quia voluptas sit aspernatur aut odit aut fugit.";
+
+static Box* createLabelBox(Label** label, const std::string& text, bool fixedSize = false)
+{
+    Box* root = new Box(Axis::COLUMN);
+    root->setDimensions(600, 720);
+
+    *label = new Label();
+    (*label)->setText(text);
+    if (fixedSize)
+        (*label)->setDimensions(300, 40);
+    root->addView(*label);
+
+    root->invalidate();
+    return root;
+}
+
+// setText() measures the label and lays the tree out again, or only truncates the text if the label has a fixed size
+static void measureLabel(State& state, const std::string& text, const std::string& alternative, bool fixedSize = false)
+{
+    Label* label;
+    Box* root = createLabelBox(&label, text, fixedSize);
+
+    bool alternate = false;
+    while (state.keepRunning())
+    {
+        alternate = !alternate;
+        label->setText(alternate ? alternative : text);
+    }
+
+    delete root;
+}
+
+static void drawLabel(State& state, const std::string& text)
+{
+    Label* label;
+    Box* root = createLabelBox(&label, text);
+
+    while (state.keepRunning())
+    {
+        FrameContext* ctx = beginFrame();
+        root->frame(ctx);
+        endFrame();
+    }
+
+    delete root;
+}
+
+BRLS_BENCHMARK("label/measure/short", [](State& state) { measureLabel(state, shortText, shortTextAlt); });
+BRLS_BENCHMARK("label/measure/wrapped", [](State& state) { measureLabel(state, wrappedText, wrappedTextAlt); });
+BRLS_BENCHMARK("label/measure/fixed_size", [](State& state) { measureLabel(state, wrappedText, wrappedTextAlt, true); });
+BRLS_BENCHMARK("label/measure/same_text", [](State& state) { measureLabel(state, wrappedText, wrappedText); });
+BRLS_BENCHMARK("label/draw/short", [](State& state) { drawLabel(state, shortText); });
+BRLS_BENCHMARK("label/draw/wrapped", [](State& state) { drawLabel(state, wrappedText); });
+
+} // namespace brls::bench
@@ -0,0 +1,115 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Construction of the views, and inflation of the built-in XML layouts
+
+#include <borealis.hpp>
+
+#include "bench.hpp"
+
+namespace brls::bench
+{
+
+// Views registered for XML, created through their XML creator then deleted
+static const std::vector<std::string> constructedViews = {
+    "Box",
+    "Rectangle",
+    "Label",
+    "Image",
+    "Button",
+    "CheckBox",
+    "Header",
+    "Slider",
+    "ProgressSpinner",
+    "ScrollingFrame",
+    "HScrollingFrame",
+    "RecyclerFrame",
+    "DetailCell",
+    "BooleanCell",
+    "RadioCell",
+    "SelectorCell",
+    "InputCell",
+    "SliderCell",
+};
+
+static bool constructionRegistered = []()
+{
+    for (const std::string& name : constructedViews)
+    {
+        registerBenchmark("construct/" + name, [name](State& state)
+            {
+                XMLViewCreator creator = Application::getXMLViewCreator("brls:" + name);
+
+                while (state.keepRunning())
+                    delete creator();
+            });
+    }
+
+    return true;
+}();
+
+// Built-in views inflating their own XML layout in their constructor
+
+BRLS_BENCHMARK("inflate/AppletFrame", [](State& state)
+    {
+        while (state.keepRunning())
+            delete new AppletFrame();
+    });
+
+BRLS_BENCHMARK("inflate/Dialog", [](State& state)
+    {
+        while (state.keepRunning())
+            delete new Dialog("borealis_bench");
+    });
+
+BRLS_BENCHMARK("inflate/SidebarItem", [](State& state)
+    {
+        while (state.keepRunning())
+            delete new SidebarItem();
+    });
+
+BRLS_BENCHMARK("inflate/TabFrame", [](State& state)
+    {
+        while (state.keepRunning())
+            delete new TabFrame();
+    });
+
+static const std::string listXML = R"xml(
+    <brls:Box width="auto" height="auto" axis="column" paddingLeft="@style/brls/sidebar/padding_left">
+        <brls:Header title="Header" />
+        <brls:Box axis="row" alignItems="center" height="70">
+            <brls:Label text="First" grow="1" />
+            <brls:Rectangle width="40" height="40" color="#FF0000" />
+        </brls:Box>
+        <brls:Box axis="row" alignItems="center" height="70">
+            <brls:Label text="Second" grow="1" />
+            <brls:Rectangle width="40" height="40" color="#00FF00" />
+        </brls:Box>
+        <brls:Box axis="row" alignItems="center" height="70">
+            <brls:Label text="Third" grow="1" />
+            <brls:Rectangle width="40" height="40" color="#0000FF" />
+        </brls:Box>
+        <brls:Button text="Button" />
+    </brls:Box>
+)xml";
+
+BRLS_BENCHMARK("inflate/xml_string", [](State& state)
+    {
+        while (state.keepRunning())
+            delete View::createFromXMLString(listXML);
+    });
+
+} // namespace brls::bench
@@ -0,0 +1,173 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/logger.hpp>
+#include <cstring>
+
+#include "null_platform.hpp"
+
+namespace brls
+{
+
+NullVideoContext::NullVideoContext()
+{
+    NVGparams params;
+    memset(&params, 0, sizeof(params));
+
+    params.userPtr                   = this;
+    params.edgeAntiAlias             = 1;
+    params.renderCreate              = NullVideoContext::renderCreate;
+    params.renderCreateTexture       = NullVideoContext::renderCreateTexture;
+    params.renderDeleteTexture       = NullVideoContext::renderDeleteTexture;
+    params.renderUpdateTexture       = NullVideoContext::renderUpdateTexture;
+    params.renderUpdateTextureRegion = NullVideoContext::renderUpdateTexture; // nothing is uploaded anyway
+    params.renderGetTextureSize      = NullVideoContext::renderGetTextureSize;
+    params.renderViewport            = NullVideoContext::renderViewport;
+    params.renderCancel              = NullVideoContext::renderCancel;
+    params.renderFlush               = NullVideoContext::renderFlush;
+    params.renderFill                = NullVideoContext::renderFill;
+    params.renderStroke              = NullVideoContext::renderStroke;
+    params.renderTriangles           = NullVideoContext::renderTriangles;
+    params.renderDelete              = NullVideoContext::renderDelete;
+
+    this->nvgContext = nvgCreateInternal(&params);
+
+    if (!this->nvgContext)
+        fatal("Unable to init nanovg");
+}
+
+NullVideoContext::~NullVideoContext()
+{
+    if (this->nvgContext)
+        nvgDeleteInternal(this->nvgContext);
+}
+
+size_t NullVideoContext::getTexturesCount()
+{
+    return this->textures.size();
+}
+
+size_t NullVideoContext::getDrawCallsCount()
+{
+    return this->drawCalls;
+}
+
+int NullVideoContext::renderCreate(void* uptr)
+{
+    return 1;
+}
+
+int NullVideoContext::renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+    NullVideoContext* self = (NullVideoContext*)uptr;
+
+    int image             = self->nextTexture++;
+    self->textures[image] = { w, h };
+    return image;
+}
+
+int NullVideoContext::renderDeleteTexture(void* uptr, int image)
+{
+    NullVideoContext* self = (NullVideoContext*)uptr;
+    return self->textures.erase(image) > 0;
+}
+
+int NullVideoContext::renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+    NullVideoContext* self = (NullVideoContext*)uptr;
+    return self->textures.count(image) > 0;
+}
+
+int NullVideoContext::renderGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+    NullVideoContext* self = (NullVideoContext*)uptr;
+
+    auto it = self->textures.find(image);
+    if (it == self->textures.end())
+        return 0;
+
+    *w = it->second.width;
+    *h = it->second.height;
+    return 1;
+}
+
+void NullVideoContext::renderViewport(void* uptr, float width, float height, float devicePixelRatio)
+{
+}
+
+void NullVideoContext::renderCancel(void* uptr)
+{
+}
+
+void NullVideoContext::renderFlush(void* uptr)
+{
+}
+
+void NullVideoContext::renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+    ((NullVideoContext*)uptr)->drawCalls++;
+}
+
+void NullVideoContext::renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+    ((NullVideoContext*)uptr)->drawCalls++;
+}
+
+void NullVideoContext::renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe)
+{
+    ((NullVideoContext*)uptr)->drawCalls++;
+}
+
+void NullVideoContext::renderDelete(void* uptr)
+{
+}
+
+void NullInputManager::updateUnifiedControllerState(ControllerState* state)
+{
+    for (bool& button : state->buttons)
+        button = false;
+
+    for (float& axis : state->axes)
+        axis = 0.0f;
+}
+
+void NullInputManager::updateControllerState(ControllerState* state, int controller)
+{
+    this->updateUnifiedControllerState(state);
+}
+
+void NullInputManager::updateMouseStates(RawMouseState* state)
+{
+    *state = RawMouseState();
+}
+
+NullPlatform::NullPlatform()
+{
+}
+
+NullPlatform::~NullPlatform()
+{
+    delete this->videoContext;
+}
+
+void NullPlatform::createWindow(std::string title, uint32_t width, uint32_t height, float windowXPos, float windowYPos)
+{
+    this->videoContext = new NullVideoContext();
+    Application::setWindowSize(width, height);
+}
+
+} // namespace brls
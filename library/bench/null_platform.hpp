@@ -0,0 +1,166 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/audio.hpp>
+#include <borealis/core/ime.hpp>
+#include <borealis/core/input.hpp>
+#include <borealis/core/platform.hpp>
+#include <borealis/core/video.hpp>
+#include <borealis/platforms/desktop/desktop_font.hpp>
+#include <unordered_map>
+
+namespace brls
+{
+
+// Video context without window nor GPU: nanovg runs on a backend that keeps track
+// of the textures and drops every draw call, so that only the CPU side of a frame is measured
+class NullVideoContext : public VideoContext
+{
+  public:
+    NullVideoContext();
+    ~NullVideoContext() override;
+
+    void clear(NVGcolor color) override { }
+    void beginFrame() override { }
+    void endFrame() override { }
+    void resetState() override { }
+    double getScaleFactor() override { return 1.0; }
+    NVGcontext* getNVGContext() override { return this->nvgContext; }
+
+    /**
+     * Number of textures currently allocated by the backend.
+     */
+    size_t getTexturesCount();
+
+    /**
+     * Number of fill, stroke and triangles calls submitted since the beginning.
+     */
+    size_t getDrawCallsCount();
+
+  private:
+    NVGcontext* nvgContext = nullptr;
+
+    struct Texture
+    {
+        int width;
+        int height;
+    };
+
+    std::unordered_map<int, Texture> textures;
+    int nextTexture  = 1;
+    size_t drawCalls = 0;
+
+    static int renderCreate(void* uptr);
+    static int renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data);
+    static int renderDeleteTexture(void* uptr, int image);
+    static int renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data);
+    static int renderGetTextureSize(void* uptr, int image, int* w, int* h);
+    static void renderViewport(void* uptr, float width, float height, float devicePixelRatio);
+    static void renderCancel(void* uptr);
+    static void renderFlush(void* uptr);
+    static void renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths);
+    static void renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths);
+    static void renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe);
+    static void renderDelete(void* uptr);
+};
+
+class NullInputManager : public InputManager
+{
+  public:
+    short getControllersConnectedCount() override { return 0; }
+    void updateUnifiedControllerState(ControllerState* state) override;
+    void updateControllerState(ControllerState* state, int controller) override;
+    bool getKeyboardKeyState(BrlsKeyboardScancode state) override { return false; }
+    void updateTouchStates(std::vector<RawTouchState>* states) override { }
+    void updateMouseStates(RawMouseState* state) override;
+    void sendRumble(unsigned short controller, unsigned short lowFreqMotor, unsigned short highFreqMotor) override { }
+};
+
+class NullImeManager : public ImeManager
+{
+  public:
+    bool openForText(std::function<void(std::string)> f, std::string headerText = "",
+        std::string subText = "", int maxStringLength = 32, std::string initialText = "",
+        int kbdDisableBitmask = KeyboardKeyDisableBitmask::KEYBOARD_DISABLE_NONE) override
+    {
+        return false;
+    }
+
+    bool openForNumber(std::function<void(long)> f, std::string headerText = "",
+        std::string subText = "", int maxStringLength = 18, std::string initialText = "",
+        std::string leftButton = "", std::string rightButton = "",
+        int kbdDisableBitmask = KeyboardKeyDisableBitmask::KEYBOARD_DISABLE_NONE) override
+    {
+        return false;
+    }
+};
+
+// Headless platform, given to Application::init(Platform*)
+// The fonts are read from the resources like on desktop
+class NullPlatform : public Platform
+{
+  public:
+    NullPlatform();
+    ~NullPlatform() override;
+
+    void createWindow(std::string title, uint32_t width, uint32_t height, float windowXPos = NAN, float windowYPos = NAN) override;
+
+    std::string getName() override { return "Null"; }
+
+    int getWirelessLevel() override { return 0; }
+    std::string getIpAddress() override { return "-"; }
+    std::string getDnsServer() override { return "-"; }
+    bool canShowBatteryLevel() override { return false; }
+    bool canShowWirelessLevel() override { return false; }
+    int getBatteryLevel() override { return 100; }
+    bool isBatteryCharging() override { return false; }
+
+    void disableScreenDimming(bool disable, const std::string& reason, const std::string& app) override { }
+    bool isScreenDimmingDisabled() override { return false; }
+    void setBacklightBrightness(float brightness) override { }
+    float getBacklightBrightness() override { return 1.0f; }
+    bool canSetBacklightBrightness() override { return false; }
+
+    bool mainLoopIteration() override { return true; }
+
+    ThemeVariant getThemeVariant() override { return this->themeVariant; }
+    void setThemeVariant(ThemeVariant theme) override { this->themeVariant = theme; }
+    std::string getLocale() override { return LOCALE_EN_US; }
+
+    AudioPlayer* getAudioPlayer() override { return &this->audioPlayer; }
+    VideoContext* getVideoContext() override { return this->videoContext; }
+    InputManager* getInputManager() override { return &this->inputManager; }
+    ImeManager* getImeManager() override { return &this->imeManager; }
+    FontLoader* getFontLoader() override { return &this->fontLoader; }
+
+    bool isApplicationMode() override { return true; }
+    void exitToHomeMode(bool value) override { }
+    void forceEnableGamePlayRecording() override { }
+    void openBrowser(std::string url) override { }
+
+  private:
+    ThemeVariant themeVariant = ThemeVariant::LIGHT;
+
+    NullVideoContext* videoContext = nullptr;
+    NullAudioPlayer audioPlayer;
+    NullInputManager inputManager;
+    NullImeManager imeManager;
+    DesktopFontLoader fontLoader;
+};
+
+} // namespace brls
@@ -52,13 +52,27 @@ option(USE_GLES3 "using OpenGL ES 3.0" OFF)
 # or if you do not want others to modify the resource files, you can also enable this option
 option(USE_LIBROMFS "using libromfs to bundle resources" OFF)
 
+# Compress the resources bundled with libromfs, they are decompressed when first used.
+# Already compressed formats (LIBROMFS_STORED_EXTENSIONS) are kept as is
+option(LIBROMFS_COMPRESS "compress the resources bundled with libromfs" OFF)
+
 # Disable highlight border animation (Useful for low-end devices like PSVita)
 option(SIMPLE_HIGHLIGHT "Simple highlight" OFF)
 
+# Remove log calls below this level at compile time: 0 error, 1 warning, 2 info, 3 debug, 4 verbose
+# Empty keeps every level (Useful for release builds on low-end devices)
+set(BRLS_LOG_MIN_LEVEL "" CACHE STRING "Lowest log level compiled in")
+
 # Enable unity build, using -DCMAKE_UNITY_BUILD_BATCH_SIZE=8 to set the batch size
 # https://cmake.org/cmake/help/latest/prop_tgt/UNITY_BUILD.html
 option(BRLS_UNITY_BUILD "Unity build" OFF)
 
+# Build the borealis_bench microbenchmarks (desktop only), see library/bench
+option(BRLS_BENCH "Build the borealis_bench target" OFF)
+
+# Record BRLS_TRACE_SCOPE events, dumped in the Chrome trace format (see core/trace.hpp)
+option(BRLS_TRACE "Trace instrumentation" OFF)
+
 
 if (NOT DEFINED APP_PLATFORM_INCLUDE)
     set(APP_PLATFORM_INCLUDE)
@@ -118,6 +118,16 @@ if (SIMPLE_HIGHLIGHT)
     add_definitions(-DSIMPLE_HIGHLIGHT)
 endif ()
 
+if (BRLS_TRACE)
+    message(STATUS "Enable BRLS_TRACE")
+    add_definitions(-DBRLS_TRACE)
+endif ()
+
+if (NOT BRLS_LOG_MIN_LEVEL STREQUAL "")
+    message(STATUS "Log level stripped below ${BRLS_LOG_MIN_LEVEL}")
+    add_definitions(-DBRLS_LOG_MIN_LEVEL=${BRLS_LOG_MIN_LEVEL})
+endif ()
+
 if (USE_STD_THREAD)
     message(STATUS "Enable std thread")
     add_definitions(-DBOREALIS_USE_STD_THREAD)
@@ -22,29 +22,44 @@
 #include <borealis/core/activity.hpp>
 #include <borealis/core/animation.hpp>
 #include <borealis/core/application.hpp>
+#include <borealis/core/asset_store.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/core/audio.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/draw_list.hpp>
 #include <borealis/core/event.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/frame_context.hpp>
+#include <borealis/core/frame_pacer.hpp>
 #include <borealis/core/geometry.hpp>
+#include <borealis/core/gif_decoder.hpp>
+#include <borealis/core/glyph_atlas.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/image_scaler.hpp>
 #include <borealis/core/input.hpp>
+#include <borealis/core/input_replay.hpp>
 #include <borealis/core/logger.hpp>
+#include <borealis/core/memory.hpp>
 #include <borealis/core/platform.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/render_pipeline.hpp>
+#include <borealis/core/shadow_cache.hpp>
+#include <borealis/core/sprite_atlas.hpp>
 #include <borealis/core/style.hpp>
+#include <borealis/core/system_status.hpp>
 #include <borealis/core/task.hpp>
 #include <borealis/core/theme.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/core/time.hpp>
 #include <borealis/core/timer.hpp>
+#include <borealis/core/trace.hpp>
 #include <borealis/core/video.hpp>
 #include <borealis/core/view.hpp>
 
 // Views
+#include <borealis/views/animated_image.hpp>
 #include <borealis/views/applet_frame.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/dialog.hpp>
@@ -21,12 +21,15 @@
 namespace brls
 {
 
-#define CONTENT_FROM_XML_RES(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLResource(x); }
-#define CONTENT_FROM_XML_FILE(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLFile(x); }
-#define CONTENT_FROM_XML_STR(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLString(x); }
+#define CONTENT_FROM_XML_RES(x)                                                            \
+    brls::View* createContentView() override { return brls::View::createFromXMLResource(x); } \
+    tinyxml2::XMLDocument* loadContentDocument() override { return brls::View::loadXMLDocumentFromResource(x); }
+#define CONTENT_FROM_XML_FILE(x)                                                       \
+    brls::View* createContentView() override { return brls::View::createFromXMLFile(x); } \
+    tinyxml2::XMLDocument* loadContentDocument() override { return brls::View::loadXMLDocumentFromFile(x); }
+#define CONTENT_FROM_XML_STR(x)                                                          \
+    brls::View* createContentView() override { return brls::View::createFromXMLString(x); } \
+    tinyxml2::XMLDocument* loadContentDocument() override { return brls::View::loadXMLDocumentFromString(x); }
 
 // An activity is a "screen" of your app in which the library adds
 // the UI components. The app is made of a stack of activities, each activity
@@ -72,6 +75,52 @@ class Activity
      */
     virtual void onContentAvailable() {};
 
+    /**
+     * Called on a worker thread by Application::pushActivityAsync(), before any view is created.
+     * Should return the parsed XML document of the activity content, if any.
+     *
+     * The CONTENT_FROM_XML_FILE, CONTENT_FROM_XML_RES, CONTENT_FROM_XML_STR macros
+     * override it along with createContentView().
+     *
+     * Returning nullptr means createContentView() will be used instead, on the UI thread.
+     */
+    virtual tinyxml2::XMLDocument* loadContentDocument()
+    {
+        return nullptr;
+    }
+
+    /**
+     * Called on a worker thread by Application::pushActivityAsync(), right after
+     * loadContentDocument(). Use it to load or compute the data the activity needs.
+     *
+     * The views tree must not be touched from there.
+     */
+    virtual void onPrepareContent() {};
+
+    /**
+     * Returns the lightweight view shown by Application::pushActivityAsync()
+     * while the real content is being prepared. Default is a centered spinner.
+     */
+    virtual View* createPlaceholderView();
+
+    /**
+     * Token that is set to false when the activity is deleted, to be
+     * captured by asynchronous tasks working on the activity.
+     */
+    std::shared_ptr<bool> getAliveToken()
+    {
+        return this->aliveToken;
+    }
+
+    /**
+     * Returns the arena the views of this activity are allocated from,
+     * freed all at once when the activity is deleted.
+     */
+    ViewArena* getViewArena()
+    {
+        return this->viewArena;
+    }
+
     View* getContentView();
 
     /**
@@ -154,6 +203,7 @@ class Activity
     ActionIdentifier registerExitAction(enum ControllerButton button = brls::BUTTON_START);
 
     void onWindowSizeChanged();
+    void onThemeChanged();
 
     View* getDefaultFocus();
 
@@ -162,6 +212,10 @@ class Activity
   private:
     View* constructorView = nullptr;
     View* contentView     = nullptr;
+
+    std::shared_ptr<bool> aliveToken = std::make_shared<bool>(true);
+
+    ViewArena* viewArena = ViewPool::createArena();
 };
 
 } // namespace brls
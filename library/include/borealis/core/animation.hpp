@@ -20,12 +20,60 @@
 #include <tweeny.h>
 
 #include <borealis/core/time.hpp>
+#include <vector>
 
 namespace brls
 {
 
 using EasingFunction = tweeny::easing::enumerated;
 
+class Animatable;
+
+// Central system updating all running animatables at once.
+//
+// The current step of every running animatable is kept as a "track" in a
+// structure of arrays, so that advancing, easing and interpolating all of them
+// are simple loops over contiguous data the compiler can vectorize.
+// Animatables only get called back when they have a tick callback or when their step is over.
+//
+// Time is counted in microseconds, from the timestamp of the frame being updated.
+//
+// Must only be used from the UI thread.
+class AnimationSystem
+{
+  public:
+    /**
+     * Called internally by the main loop to advance all running animatables
+     * to the given time, in microseconds.
+     */
+    static void update(Time now);
+
+    /**
+     * Returns the number of running animatables.
+     */
+    static size_t getActiveTracks();
+
+  private:
+    friend class Animatable;
+
+    // Tracks are removed by moving the last one in their place
+    static size_t addTrack(Animatable* owner);
+    static void removeTrack(size_t track);
+
+    // One element per track, elapsed times and durations are
+    // those of the current step, in microseconds
+    inline static std::vector<Animatable*> owners;
+    inline static std::vector<float> fromValues;
+    inline static std::vector<float> toValues;
+    inline static std::vector<double> elapsed;
+    inline static std::vector<double> durations;
+    inline static std::vector<EasingFunction> easings;
+    inline static std::vector<float> progress;
+    inline static std::vector<uint32_t> updates; // last update that called the owner back
+
+    inline static uint32_t currentUpdate = 0;
+};
+
 // An animatable is a float which value can be animated from an initial value to a target value,
 // during a given amount of time. An easing function can also be specified.
 //
@@ -38,6 +86,8 @@ using EasingFunction = tweeny::easing::enumerated;
 //
 // An animatable has overloads for float conversion, comparison (==) and assignment operator (=) to allow
 // basic usage as a simple float. Assignment operator is a shortcut to the reset() method.
+//
+// Running animatables are updated by AnimationSystem.
 class Animatable : public FiniteTicking
 {
   public:
@@ -46,6 +96,8 @@ class Animatable : public FiniteTicking
      */
     Animatable(float value = 0.0f);
 
+    ~Animatable() override;
+
     /**
      * Returns the current animatable value.
      */
@@ -94,9 +146,34 @@ class Animatable : public FiniteTicking
     void onReset() override;
     void onRewind() override;
 
+    void schedule() override;
+    void unschedule() override;
+
   private:
+    friend class AnimationSystem;
+
+    struct Step
+    {
+        float target;
+        Time duration; // in us
+        EasingFunction easing;
+    };
+
+    // Called by AnimationSystem when the current step is over
+    void onStepEnd();
+
+    // Loads the current step in the track
+    void loadStep();
+
     float currentValue = 0.0f;
-    tweeny::tween<float> tween;
+    float initialValue = 0.0f;
+
+    std::vector<Step> steps;
+    size_t currentStep = 0;
+    Time stepElapsed   = 0; // saved while stopped, in us
+    Time totalDuration = 0;
+
+    size_t track = 0; // valid while running
 };
 
 void updateHighlightAnimation();
@@ -31,6 +31,7 @@
 #include <borealis/core/theme.hpp>
 #include <borealis/core/view.hpp>
 #include <borealis/views/label.hpp>
+#include <atomic>
 #include <deque>
 #include <vector>
 
@@ -68,6 +69,14 @@ class Application
      */
     static bool init();
 
+    /**
+     * Inits the borealis application with the given platform instead of
+     * the one of the build, for instance a headless platform for benchmarks.
+     * The application takes ownership of the platform.
+     * Returns true if it succeeded, false otherwise.
+     */
+    static bool init(Platform* platform);
+
     /**
      * Creates the application window with the given title.
      * Must be called after calling init().
@@ -81,6 +90,21 @@ class Application
     static bool mainLoop();
 
     static Platform* getPlatform();
+
+    /**
+     * Returns the input manager the input is read from: the platform one,
+     * or the one replaying a recording while an InputReplay is running.
+     */
+    static InputManager* getInputManager();
+
+    /**
+     * Returns the time the current frame started at, animations and tickings are updated with it.
+     * During an InputReplay this is the recorded time, not the real one.
+     */
+    static Time getFrameStartTime()
+    {
+        return frameStartTime;
+    }
     static AudioPlayer* getAudioPlayer();
 
     static NVGcontext* getNVGContext();
@@ -91,7 +115,9 @@ class Application
     inline static int windowXPos, windowYPos;
 
     /**
-     * Called by the video context when the content window is resized
+     * Called by the video context when the content window is resized, from any thread:
+     * only the size is stored. It is applied at the beginning of the next frame, which
+     * is then marked active, and the window size changed event is fired once the size is stable.
      */
     static void onWindowResized(int width, int height);
 
@@ -126,6 +152,41 @@ class Application
      */
     static void pushActivity(Activity* view, TransitionAnimation animation = TransitionAnimation::FADE);
 
+    /**
+     * Pushes an activity without stalling the current frame.
+     *
+     * The activity is pushed right away with its placeholder view (see Activity::createPlaceholderView()).
+     * Its XML document is then parsed and Activity::onPrepareContent() is called on a worker thread.
+     * Back on the UI thread, the views are instantiated in slices of at most
+     * getActivityInflateBudget() microseconds per frame, and the real content view
+     * replaces the placeholder once it's ready.
+     *
+     * The slices are cut between XML elements, going down the tree through every view
+     * that accepts its children one at a time (see View::canAddXMLChildView()). The subtree of a view
+     * that doesn't, such as a TabFrame, is instantiated at once with View::handleXMLElement().
+     *
+     * If another activity is pushed on top in the meantime, the content only appears
+     * (and gains focus) once that activity is popped.
+     *
+     * Inputs are blocked until the content is available. The time to interactive
+     * is reported to the FrameProfiler as "activity/tti".
+     *
+     * During an input replay, the content is prepared on the UI thread and inflated
+     * REPLAY_INFLATE_ELEMENTS XML elements per frame, so that it's ready on the same frame every run.
+     */
+    static void pushActivityAsync(Activity* activity, TransitionAnimation animation = TransitionAnimation::FADE);
+
+    /**
+     * Sets the time (in microseconds) spent each frame instantiating
+     * the views of activities pushed with pushActivityAsync().
+     *
+     * Default is 4000us.
+     */
+    static void setActivityInflateBudget(Time budget);
+    static Time getActivityInflateBudget();
+
+    static constexpr unsigned REPLAY_INFLATE_ELEMENTS = 16;
+
     /**
      * Pops the last pushed activity from the stack
      * and gives focus back where it was before.
@@ -146,13 +207,22 @@ class Application
         return brls::getStyle();
     }
 
+    /**
+     * Returns the theme of the current variant, resolved once per frame.
+     */
     static Theme getTheme();
     static ThemeVariant getThemeVariant();
 
+    /**
+     * Changes the theme variant, applied to the views right away.
+     */
+    static void setThemeVariant(ThemeVariant variant);
+
     static ImeManager* getImeManager();
 
     /**
      * Loads a font from a given file and stores it in the font stash.
+     * The file is memory-mapped when possible, and kept open until exit.
      * Returns true if the operation succeeded.
      */
     static bool loadFontFromFile(std::string fontName, std::string filePath);
@@ -171,6 +241,11 @@ class Application
 
     static int getDefaultFont();
 
+    /**
+     * Returns the total size of the fonts loaded in the font stash, in bytes.
+     */
+    static size_t getFontDataSize();
+
     static void notify(std::string text);
 
     static void onControllerButtonPressed(enum ControllerButton button, bool repeating);
@@ -208,6 +283,11 @@ class Application
     static void setFPSStatus(bool enabled);
     static bool getFPSStatus();
     static size_t getFPS();
+
+    /**
+     * Limits the frame rate, 0 to disable. The frames are paced by the FramePacer,
+     * which can also late-latch the input.
+     */
     static void setLimitedFPS(size_t fps);
 
     /**
@@ -235,6 +315,7 @@ class Application
     static VoidEvent* getWindowCreationDoneEvent();
     static VoidEvent* getWindowShouldCloseEvent();
     static Event<bool>* getWindowFocusChangedEvent();
+    static Event<ThemeVariant>* getThemeChangedEvent();
 
     static View* getCurrentFocus();
 
@@ -310,6 +391,8 @@ class Application
     inline static std::string title;
 
     inline static FontStash fontStash;
+    inline static std::vector<std::shared_ptr<Asset>> fontFiles;
+    inline static size_t fontDataSize = 0;
 
     inline static std::vector<Activity*> activitiesStack;
     inline static std::vector<View*> focusStack;
@@ -329,6 +412,8 @@ class Application
 
     inline static void updateFPS();
 
+    static void applyPendingWindowSize();
+
     inline static unsigned blockInputsTokens = 0; // any value > 0 means inputs are blocked
     inline static bool muteSounds            = false;
 
@@ -338,7 +423,6 @@ class Application
     inline static ActionIdentifier gloablQuitIdentifier = ACTION_NONE;
     inline static bool globalFPSToggleEnabled           = false;
     inline static size_t globalFPS                      = 60;
-    inline static Time limitedFrameTime                 = 0;
     inline static Time frameStartTime                   = 0;
 
     inline static bool deactivatedBehavior = false;
@@ -349,6 +433,13 @@ class Application
 
     inline static View* repetitionOldFocus = nullptr;
 
+    inline static Time activityInflateBudget = 4000; // 4ms
+
+    inline static std::atomic<uint64_t> pendingWindowSize { 0 }; // width << 32 | height, 0 if none
+    inline static bool windowResizing             = false; // counting the layout work of a resize
+    inline static int64_t resizeMeasuredNodes     = 0;
+    inline static int64_t resizeMeasureCallbacks  = 0;
+
     inline static GenericEvent globalFocusChangeEvent;
     inline static VoidEvent globalHintsUpdateEvent;
     inline static Event<InputType> globalInputTypeChangeEvent;
@@ -359,11 +450,34 @@ class Application
     inline static VoidEvent windowCreationDoneEvent;
     inline static VoidEvent windowShouldCloseEvent;
     inline static Event<bool> windowFocusChangedEvent;
+    inline static Event<ThemeVariant> themeChangedEvent;
+
+    inline static Theme currentTheme               = nullptr;
+    inline static ThemeVariant currentThemeVariant = ThemeVariant::LIGHT;
+    inline static uint64_t currentThemeGeneration  = 0;
+
+    static void updateTheme();
 
     inline static std::unordered_map<std::string, XMLViewCreator> xmlViewsRegister;
 
     static void navigate(FocusDirection direction, bool repeating);
 
+    static void pushActivity(Activity* activity, TransitionAnimation animation, bool createContent);
+    // A view being inflated by inflateActivityAsync(), and its next child XML element
+    struct XMLInflateFrame
+    {
+        View* view;
+        tinyxml2::XMLElement* next;
+        unsigned count;
+    };
+
+    // Activities whose async content became available while they were covered by another one
+    inline static std::vector<Activity*> pendingContentActivities;
+
+    static void inflateActivityAsync(Activity* activity, std::shared_ptr<bool> alive, tinyxml2::XMLDocument* document,
+        std::vector<XMLInflateFrame> stack, Time startTime);
+    static void setActivityContentAsync(Activity* activity, View* content, Time startTime);
+
     static void frame();
     static void clear();
     static void exit();
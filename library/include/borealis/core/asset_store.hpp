@@ -0,0 +1,133 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/mapped_file.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace brls
+{
+
+// Immutable bytes of a file or of a resource, valid as long as the asset is referenced.
+// Files are memory-mapped, resources embedded with libromfs are used in place.
+class Asset
+{
+  public:
+    const uint8_t* data() const
+    {
+        return this->address;
+    }
+
+    size_t size() const
+    {
+        return this->length;
+    }
+
+    /**
+     * Returns the data as text, which is not null-terminated.
+     */
+    std::string_view string() const
+    {
+        return std::string_view((const char*)this->address, this->length);
+    }
+
+    const std::string& getPath() const
+    {
+        return this->path;
+    }
+
+    /**
+     * Asks the system to read the whole asset ahead, to be called from
+     * a background thread before the data is needed.
+     */
+    void prefetch() const;
+
+  private:
+    friend class AssetStore;
+
+    std::string path;
+    const uint8_t* address = nullptr;
+    size_t length          = 0;
+
+    std::shared_ptr<MappedFile> file; // nullptr for embedded resources
+    std::vector<uint8_t> buffer; // big compressed resources, decompressed for this asset only
+};
+
+// Single entry point to read files and resources without copying them.
+//
+// Paths starting with "@res/" are resources: embedded in the executable with libromfs,
+// or in the BRLS_RESOURCES directory otherwise. Any other path is a file.
+//
+// Resources compressed by libromfs (LIBROMFS_COMPRESS) are decompressed on first access
+// and kept by libromfs, except the ones bigger than LARGE_RESOURCE_SIZE which are
+// decompressed again every time they are opened and freed with their asset.
+//
+// Resources opened again while still referenced are shared, and whether a resource exists
+// is remembered so that looking for optional resources only hits the disk once.
+// Files are opened again every time, as they can be modified, created or deleted at any time.
+//
+// Can be used from any thread.
+class AssetStore
+{
+  public:
+    static constexpr size_t LARGE_RESOURCE_SIZE = 512 * 1024;
+
+    /**
+     * Returns the asset at the given path, or nullptr if it doesn't exist.
+     * Empty files and resources are returned with no data.
+     */
+    static std::shared_ptr<Asset> open(const std::string& path);
+
+    /**
+     * Opens and reads ahead the asset at the given path on the async thread, then calls the
+     * callback with it (or nullptr) on the same thread so that it can be decoded right away.
+     * Use brls::sync() to get back to the UI thread.
+     */
+    static void openAsync(const std::string& path, std::function<void(std::shared_ptr<Asset>)> callback);
+
+    /**
+     * Returns true if there is an asset at the given path.
+     */
+    static bool exists(const std::string& path);
+
+    /**
+     * Returns the paths of the assets in the given directory, which can be opened with open().
+     */
+    static std::vector<std::string> list(const std::string& directory);
+
+    /**
+     * Forgets which resources exist, to be called after the resources directory changes.
+     */
+    static void clearCache();
+
+  private:
+    static bool isResource(const std::string& path);
+    static bool fileExists(const std::string& path);
+
+    inline static std::mutex mutex;
+    inline static std::unordered_map<std::string, std::weak_ptr<Asset>> assets;
+    inline static std::unordered_map<std::string, bool> existing;
+    inline static size_t pruneSize = 64; // assets count above which the expired ones are removed
+};
+
+} // namespace brls
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <borealis/core/draw_list.hpp>
 #include <borealis/core/view.hpp>
 
 namespace brls
@@ -72,6 +73,7 @@ class Box : public View
     void willAppear(bool resetState) override;
     void willDisappear(bool resetState) override;
     void onWindowSizeChanged() override;
+    void onThemeChanged() override;
     void onFocusGained() override;
     void onFocusLost() override;
     void onParentFocusGained(View* focusedView) override;
@@ -184,6 +186,19 @@ class Box : public View
      */
     virtual void getCullingBounds(float* top, float* right, float* bottom, float* left);
 
+    /**
+     * Returns true if the box only draws its decorations and its children, in which case
+     * its children are drawn directly by the draw list of its parents.
+     * Only true for plain boxes: subclasses overriding neither draw() nor frame() can return true.
+     */
+    virtual bool isFlattenable();
+
+    /**
+     * Rebuilds the draw lists including the children of this box before the next frame.
+     * Called when the children change.
+     */
+    void invalidateDrawList();
+
     /**
      * Registers an XML attribute to be forwarded to the given view. Works regardless of the target attribute type.
      * Useful to expose attributes of children views in the parent box without copy pasting them individually.
@@ -236,6 +251,8 @@ class Box : public View
 
     std::vector<View*> children;
 
+    DrawList drawList;
+
     size_t defaultFocusedIndex = 0;
     View* lastFocusedView      = nullptr;
 
@@ -293,6 +310,9 @@ class Box : public View
      * to the children of the Box.
      */
     void handleXMLElement(tinyxml2::XMLElement* element) override;
+
+    bool canAddXMLChildView() override;
+    void addXMLChildView(View* view) override;
 };
 
 // An empty view that has auto x auto and grow=1.0 to push
@@ -19,10 +19,22 @@
 #include <stdexcept>
 
 #include "borealis/core/singleton.hpp"
+#include "borealis/core/sprite_atlas.hpp"
 
 namespace brls
 {
 
+/**
+ * Deletes a cached texture, or releases it from the sprite atlas
+ */
+inline void deleteCachedTexture(NVGcontext* vg, size_t texture)
+{
+    if (SpriteAtlas::isSprite(texture))
+        SpriteAtlas::release(texture);
+    else
+        nvgDeleteImage(vg, texture);
+}
+
 template <typename K, typename T>
 struct Node
 {
@@ -209,7 +221,7 @@ class LRUCache
             if (i->count <= 0)
             {
                 num--;
-                nvgDeleteImage(vg, i->value);
+                deleteCachedTexture(vg, i->value);
                 cacheMap.erase(i->key);
                 valueMap.erase(i->value);
                 cacheList.erase(std::next(i).base());
@@ -290,7 +302,7 @@ class TextureCache : public Singleton<TextureCache>
         auto vg = brls::Application::getNVGContext();
         for (auto& i : cache.getCacheList())
         {
-            nvgDeleteImage(vg, i.value);
+            deleteCachedTexture(vg, i.value);
         }
     }
 
@@ -0,0 +1,101 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/frame_context.hpp>
+#include <borealis/core/geometry.hpp>
+#include <vector>
+
+namespace brls
+{
+
+class Box;
+class View;
+
+enum class DrawItemKind
+{
+    BOX, // plain box, drawn by the list along with its children
+    VIEW, // any other view, drawn with its own frame()
+};
+
+struct DrawItem
+{
+    View* view;
+    DrawItemKind kind;
+    bool cullable; // leaf views are culled, boxes cull their children
+
+    int parent; // index of the item of the parent box, -1 for the children of the list owner
+    size_t end; // index of the item following the subtree of this one
+
+    // Updated every frame
+    Rect frame; // absolute
+    Rect cullingBounds; // intersection of the culling bounds of the box and all its parents
+};
+
+// Flattened draw order of the subtree of a Box.
+//
+// Plain boxes only draw their decorations and their children: instead of walking the tree
+// recursively through frame() and draw() every frame, the descendants of a box are listed once
+// in a contiguous array, in draw order, and drawn linearly. The list goes through nested plain
+// boxes and stops at any other view, which is drawn with its own frame() as before.
+//
+// The list is built again when the children of one of the listed boxes change. Frames, culling,
+// visibility and alpha are evaluated every frame from the items, without going up the tree.
+// nanovg state is only saved around the boxes clipping their children or overriding the theme.
+//
+// Disabled by default.
+class DrawList
+{
+  public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Marks the list to be built again before the next draw.
+     */
+    void invalidate();
+
+    /**
+     * Draws the children of the owner, frame being the absolute frame of the owner.
+     */
+    void draw(FrameContext* ctx, Box* owner, Rect frame);
+
+    size_t size();
+
+  private:
+    // Box whose clipping, theme or wireframe is to be reset after its subtree
+    struct Scope
+    {
+        size_t item;
+        bool restore;
+        bool wireframe;
+        bool restoreTheme;
+        Theme theme = nullptr;
+    };
+
+    void build(Box* owner);
+    void append(Box* box, int parent);
+    void closeScopes(FrameContext* ctx, size_t index);
+
+    std::vector<DrawItem> items;
+    std::vector<Scope> scopes;
+    bool dirty = true;
+
+    inline static bool enabled = false;
+};
+
+} // namespace brls
@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <borealis/core/asset_store.hpp>
 #include <borealis/core/assets.hpp>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace brls
 {
@@ -36,6 +40,23 @@ static const std::string FONT_EMOJI                  = "emoji";
 
 typedef std::unordered_map<std::string, int> FontStash;
 
+// Inclusive codepoint range
+typedef std::pair<uint32_t, uint32_t> CodepointRange;
+
+static const std::vector<CodepointRange> CODEPOINTS_CJK = {
+    { 0x2E80, 0x9FFF }, // radicals, punctuation, kana, unified ideographs
+    { 0xF900, 0xFAFF }, // compatibility ideographs
+    { 0xFE30, 0xFE4F }, // compatibility forms
+    { 0xFF00, 0xFFEF }, // half and full width forms
+    { 0x20000, 0x2FA1F }, // supplementary ideographs
+};
+
+static const std::vector<CodepointRange> CODEPOINTS_HANGUL = {
+    { 0x1100, 0x11FF }, // jamo
+    { 0x3130, 0x318F }, // compatibility jamo
+    { 0xAC00, 0xD7AF }, // syllables
+};
+
 // Platform interface to load fonts from disk or other sources (system / shared font...)
 class FontLoader
 {
@@ -44,7 +65,7 @@ class FontLoader
     inline static std::string USER_ICON_PATH = BRLS_ASSET("font/icon.ttf");
     inline static std::string USER_EMOJI_PATH;
 
-    virtual ~FontLoader() { }
+    virtual ~FontLoader();
     /**
      * Called once on init to load every font in the font stash.
      *
@@ -54,7 +75,34 @@ class FontLoader
      */
     virtual void loadFonts() = 0;
 
+    /**
+     * Called before the window is created. Opens the files returned by getPreloadPaths()
+     * on a background thread, so that reading them overlaps the window creation.
+     */
+    void preloadFonts();
+
+    /**
+     * Returns the content of a font file or resource, opened by preloadFonts() if possible.
+     * Waits for preloadFonts() to be done.
+     */
+    std::shared_ptr<Asset> openFontFile(const std::string& filePath);
+
   protected:
+    /**
+     * Paths of the fonts loadFonts() is going to load from files, to be preloaded.
+     */
+    virtual std::vector<std::string> getPreloadPaths()
+    {
+        return {};
+    }
+
+    /**
+     * Registers a font file as a fallback of baseFont, without loading it.
+     * The font is only opened the first time a codepoint in the given ranges (any codepoint if empty)
+     * is missing from baseFont and its other fallbacks.
+     */
+    void addLazyFallbackFont(std::string fontName, std::string filePath, std::string baseFont, std::vector<CodepointRange> ranges = {});
+
     /**
      * Convenience method to load a font from a file path
      * with some more logging.
@@ -66,6 +114,26 @@ class FontLoader
      * Returns true if the operation succeeds.
      */
     bool loadMaterialFromResources();
+
+  private:
+    struct LazyFont
+    {
+        std::string name;
+        std::string path;
+        std::string baseFont;
+        std::vector<CodepointRange> ranges;
+        bool opened = false;
+    };
+
+    static int onMissingGlyph(void* loader, int baseFont, unsigned int codepoint);
+
+    static void* preloadTask(void* loader);
+    void waitForPreload();
+
+    std::vector<LazyFont> lazyFonts;
+
+    std::vector<std::string> preloadPaths;
+    std::unordered_map<std::string, std::shared_ptr<Asset>> preloadedFiles;
 };
 
 } // namespace brls
@@ -0,0 +1,93 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <borealis/core/time.hpp>
+
+namespace brls
+{
+
+// Schedules the frames of the main loop on a fixed cadence when the FPS are limited.
+//
+// Frames are aligned on absolute deadlines rather than on "frame time minus work time" sleeps,
+// so that the error of one wait isn't carried over to the next frames. The pacer sleeps until
+// shortly before the deadline, then spins for the remainder: the spin margin follows the
+// measured oversleep of the system scheduler, up to a small fraction of the frame time
+// so that handhelds don't burn their battery spinning.
+//
+// With late-latching, the deadline is one frame after the measured present of the last frame,
+// and the wait is moved from after the frame to before the next one: the main loop samples
+// the input and lays the views out as late as possible, just in time to present on the deadline,
+// using the measured duration of the last frames.
+//
+// The intervals between two presented frames are recorded by the FrameProfiler as "frame/present",
+// and their deviation from the target (or from the previous interval when the FPS are not
+// limited) as "frame/jitter". Missed deadlines are counted in "frame/missed".
+class FramePacer
+{
+  public:
+    static constexpr Time MIN_SPIN_MARGIN   = 500;
+    static constexpr Time MAX_SPIN_MARGIN   = 4000;
+    static constexpr Time SPIN_FRACTION     = 8; // the spin margin is at most 1/8 of the frame time
+    static constexpr Time LATE_LATCH_MARGIN = 1000;
+
+    /**
+     * Sets the duration of a frame, in microseconds. 0 disables the pacing.
+     */
+    static void setTargetFrameTime(Time frameTime);
+    static Time getTargetFrameTime();
+
+    /**
+     * Enables late-latching of the input and layout, disabled by default.
+     * Only has an effect when the FPS are limited.
+     */
+    static void setLateLatching(bool enabled);
+    static bool getLateLatching();
+
+    /**
+     * Called right after a frame has been swapped, from the thread presenting it.
+     */
+    static void framePresented(Time time);
+
+    /**
+     * Called by the main loop once the frame has been submitted, frameStart being
+     * the time the frame started. Waits until the next frame should start.
+     */
+    static void endFrame(Time frameStart);
+
+    /**
+     * Forgets the current deadline, the next frame starts a new cadence.
+     */
+    static void reset();
+
+  private:
+    static void waitUntil(Time time);
+
+    inline static Time targetFrameTime = 0;
+    inline static bool lateLatching    = false;
+
+    inline static Time deadline       = 0;
+    inline static Time lastPresent    = 0;
+    inline static Time lastInterval   = 0;
+    inline static Time spinMargin     = 2000;
+    inline static double workEstimate = 0;
+
+    inline static std::atomic<Time> presentTime = 0;
+};
+
+} // namespace brls
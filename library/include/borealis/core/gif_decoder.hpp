@@ -0,0 +1,84 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/asset_store.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Decodes the frames of a GIF one after the other, going back to the first one
+// after the last one, so that only the frames being displayed are in memory.
+//
+// A decoder can be used from any thread, but only from one at a time.
+class GifDecoder
+{
+  public:
+    /**
+     * Returns a decoder for the GIF at the given file or resource path (see AssetStore),
+     * or nullptr if the file cannot be read or is not a GIF.
+     */
+    static std::unique_ptr<GifDecoder> openFile(const std::string& path);
+
+    /**
+     * Returns a decoder for a copy of the given GIF data, or nullptr if it is not a GIF.
+     */
+    static std::unique_ptr<GifDecoder> openMemory(const unsigned char* data, size_t size);
+
+    ~GifDecoder();
+
+    int getWidth();
+    int getHeight();
+
+    /**
+     * Returns the number of frames, or 0 if not known yet because
+     * the last frame has not been decoded yet.
+     */
+    size_t getFrameCount();
+
+    /**
+     * Decodes the next frame into the given buffer of width * height * 4 bytes,
+     * and returns how long it must be shown in ms.
+     * Returns false if the data is invalid.
+     */
+    bool decodeFrame(unsigned char* pixels, int* delay);
+
+  private:
+    struct State;
+
+    GifDecoder() = default;
+
+    bool init(const uint8_t* data, size_t size);
+    void rewind();
+
+    std::shared_ptr<Asset> file;
+    std::vector<uint8_t> buffer; // copy of the data if not read from a file
+
+    const uint8_t* data = nullptr;
+    size_t size         = 0;
+
+    int width         = 0;
+    int height        = 0;
+    size_t frameCount = 0;
+
+    std::unique_ptr<State> state;
+};
+
+} // namespace brls
@@ -0,0 +1,65 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Fills the text atlas ahead of time, so that the first frames showing
+// a lot of new text don't have to rasterize every glyph.
+//
+// Glyphs are rasterized on the async thread and added to the atlas on the UI thread.
+// They can also be saved to a cache directory, to be loaded from the disk
+// on the next launches instead of being rasterized again.
+//
+// Must only be used from the UI thread, after the fonts are loaded.
+class GlyphAtlas
+{
+  public:
+    /**
+     * Enables the on-disk glyph cache, in the given existing directory.
+     * Cache files are keyed by the font data, the sizes and the characters.
+     * Set to an empty string to disable the cache (default).
+     */
+    static void setCacheDirectory(const std::string& path);
+    static std::string getCacheDirectory();
+
+    /**
+     * Rasterizes the glyphs of the given UTF-8 characters at the given font sizes,
+     * then adds them to the atlas. Characters missing from the font and its fallbacks are ignored.
+     *
+     * Sizes are the ones given to Label, the window scale and the
+     * display scale factor are applied. Prewarmed glyphs won't be used anymore if they change.
+     *
+     * The atlas grows if needed, up to its maximum size.
+     */
+    static void prewarm(const std::string& fontName, const std::string& characters, const std::vector<float>& sizes);
+
+    /**
+     * Returns the number of prewarm() calls whose glyphs are not in the atlas yet.
+     */
+    static size_t getPendingJobs();
+
+  private:
+    inline static std::string cacheDirectory;
+    inline static size_t pendingJobs = 0;
+};
+
+} // namespace brls
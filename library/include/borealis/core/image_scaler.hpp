@@ -0,0 +1,58 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <vector>
+
+namespace brls
+{
+
+enum class ImageFilter
+{
+    // Averages the source pixels covered by every destination pixel, fast
+    BOX,
+    // Lanczos with 3 lobes, sharper but about 3 times slower
+    LANCZOS,
+};
+
+// Resizes RGBA8 images on the CPU, in two separable passes with fixed-point weights.
+// The inner loops work on whole rows of interleaved channels so that
+// the compiler can vectorize them.
+class ImageScaler
+{
+  public:
+    /**
+     * Resizes the given RGBA8 image, whose alpha is not premultiplied, into the given
+     * destination buffer of dstWidth * dstHeight * 4 bytes.
+     * Colors are premultiplied while filtering so that transparent pixels don't bleed.
+     */
+    static void resize(const unsigned char* src, int srcWidth, int srcHeight, unsigned char* dst, int dstWidth, int dstHeight, ImageFilter filter);
+
+  private:
+    // Source pixels contributing to every destination pixel of one axis
+    struct Contributions
+    {
+        std::vector<int> first; // first source pixel of every destination pixel
+        std::vector<int> count;
+        std::vector<int> offset; // in weights
+        std::vector<int> weights;
+    };
+
+    static Contributions getContributions(int srcSize, int dstSize, ImageFilter filter);
+};
+
+} // namespace brls
@@ -0,0 +1,166 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/event.hpp>
+#include <borealis/core/input.hpp>
+#include <borealis/core/time.hpp>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Input read by the application during one iteration of the main loop
+struct InputFrame
+{
+    Time time                 = 0; // since the first frame of the recording, in microseconds
+    bool hasInput             = false; // false if the inputs were blocked during that frame
+    bool escape               = false; // state of the escape key, which the application maps to BUTTON_B
+    bool buttons[_BUTTON_MAX] = {};
+    float axes[_AXES_MAX]     = {};
+    std::vector<RawTouchState> touches;
+    RawMouseState mouse;
+};
+
+// Summary of the duration of the frames of a replay, all values are in microseconds
+struct ReplayFrameStats
+{
+    double avg = 0;
+    Time p50   = 0;
+    Time p95   = 0;
+    Time p99   = 0;
+    Time worst = 0;
+};
+
+struct ReplayReport
+{
+    size_t frames = 0;
+    Time duration = 0; // real time the replay took
+
+    ReplayFrameStats frameTime; // between the beginning of two frames
+    ReplayFrameStats workTime; // spent in a frame before waiting for the next one
+
+    /**
+     * Returns the report as JSON, to be compared between builds.
+     */
+    std::string toJSON() const;
+};
+
+// Records the input of every frame to be replayed later by InputReplay.
+//
+// Recordings are saved in a compact binary file: every frame only stores the time elapsed
+// since the previous one and the states that changed.
+//
+// Must only be used from the UI thread.
+class InputRecorder
+{
+  public:
+    /**
+     * Starts recording the input from the next frame, dropping the previous recording.
+     */
+    static void start();
+
+    /**
+     * Stops recording and saves the recorded frames to the given file.
+     * Returns false if the file could not be written.
+     */
+    static bool stop(const std::string& path);
+
+    static bool isRecording();
+
+    /**
+     * Called internally by the main loop at the beginning of every frame,
+     * and by Application::processInput() with the input it read from the platform.
+     */
+    static void frameStart(Time now);
+    static void recordInput(const ControllerState& controller, const std::vector<RawTouchState>& touches, const RawMouseState& mouse, bool escape);
+
+  private:
+    inline static bool recording = false;
+    inline static Time startTime = 0;
+    inline static std::vector<InputFrame> frames;
+};
+
+// Feeds recorded input back to the application, one recorded frame per frame.
+//
+// During a replay, Application::getInputManager() returns an input manager reading the
+// recorded frames, and getUITimeUsec() follows the recorded clock: animations, tickings,
+// delays and blinking see the recorded time, so that the same interactions happen at the
+// same frames from one run to another.
+// Frame times are still measured with the real clock, and summed up in a ReplayReport
+// once every frame has been replayed.
+//
+// Must only be used from the UI thread.
+class InputReplay
+{
+  public:
+    /**
+     * Loads a recording made by InputRecorder and starts replaying it from the next frame.
+     * Returns false if the file could not be read.
+     */
+    static bool start(const std::string& path);
+
+    /**
+     * Stops the replay early, without firing the finished event.
+     */
+    static void stop();
+
+    static bool isRunning();
+
+    /**
+     * Fired once every recorded frame has been replayed, with the frame times of the run.
+     */
+    static Event<ReplayReport>* getFinishedEvent();
+
+    /**
+     * Returns the input manager reading the recorded frames.
+     */
+    static InputManager* getInputManager();
+
+    /**
+     * Called internally by the main loop at the beginning of every frame with the real time,
+     * returns the time to update the frame with.
+     */
+    static Time frameStart(Time now);
+
+    /**
+     * Called internally by the main loop once the frame is done, before waiting for the next one.
+     */
+    static void frameEnd(Time now);
+
+    static const InputFrame& getCurrentFrame();
+
+  private:
+    static ReplayReport buildReport();
+
+    inline static bool running = false;
+    inline static std::vector<InputFrame> frames;
+    inline static size_t current = 0;
+
+    inline static Time startTime     = 0; // time of the first replayed frame, recorded times are added to it
+    inline static Time realStartTime = 0; // real time of the first replayed frame
+    inline static Time lastFrameTime = 0; // last time returned by frameStart()
+    inline static Time frameRealTime = 0; // real time of the beginning of the current frame
+
+    inline static std::vector<Time> frameTimes;
+    inline static std::vector<Time> workTimes;
+
+    inline static Event<ReplayReport> finishedEvent;
+};
+
+} // namespace brls
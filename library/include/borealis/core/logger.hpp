@@ -33,8 +33,14 @@
 #include <fmt/core.h>
 #include <fmt/chrono.h>
 
+#include <atomic>
 #include <borealis/core/event.hpp>
+#include <chrono>
+#include <cstddef>
+#include <new>
 #include <string>
+#include <tuple>
+#include <type_traits>
 
 namespace brls
 {
@@ -62,12 +68,48 @@ enum class LogLevel
 #define BRLS_VERBOSE_COLOR "[0;37m"
 #endif
 
-#define BRLS_LOG_ERROR(format, ...) brls::Logger::error("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__)
-#define BRLS_LOG_WARNING(format, ...) brls::Logger::warning("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__)
-#define BRLS_LOG_INFO(format, ...) brls::Logger::info("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__)
-#define BRLS_LOG_DEBUG(format, ...) brls::Logger::debug("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__)
-#define BRLS_LOG_VERBOSE(format, ...) brls::Logger::verbose("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__)
+// Lowest priority level compiled in, as a LogLevel value: calls below this level
+// are removed at compile time, including the evaluation of their arguments
+// when using the macros below or Logger::deferred()
+#ifndef BRLS_LOG_MIN_LEVEL
+#define BRLS_LOG_MIN_LEVEL 4 // LOG_VERBOSE
+#endif
+
+// True if a message of the given level would be printed,
+// use it to skip computing expensive arguments such as View::describe()
+#define BRLS_LOG_ENABLED(level) ((int)brls::LogLevel::level <= BRLS_LOG_MIN_LEVEL && brls::Logger::isEnabled(brls::LogLevel::level))
+
+#define BRLS_LOG_ERROR(format, ...) do { if (BRLS_LOG_ENABLED(LOG_ERROR)) brls::Logger::error("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__); } while (0)
+#define BRLS_LOG_WARNING(format, ...) do { if (BRLS_LOG_ENABLED(LOG_WARNING)) brls::Logger::warning("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__); } while (0)
+#define BRLS_LOG_INFO(format, ...) do { if (BRLS_LOG_ENABLED(LOG_INFO)) brls::Logger::info("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__); } while (0)
+#define BRLS_LOG_DEBUG(format, ...) do { if (BRLS_LOG_ENABLED(LOG_DEBUG)) brls::Logger::debug("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__); } while (0)
+#define BRLS_LOG_VERBOSE(format, ...) do { if (BRLS_LOG_ENABLED(LOG_VERBOSE)) brls::Logger::verbose("{}:{} " format, __FILE__, __LINE__, ##__VA_ARGS__); } while (0)
+
+// Formats the arguments of a deferred record into its message
+typedef void (*LogFormatter)(std::string& message, fmt::string_view format, const void* args);
+
+// Slot of the logger ring buffer
+struct LogRecord
+{
+    static constexpr size_t DEFERRED_ARGS_SIZE = 64;
 
+    std::atomic<size_t> sequence = 0;
+
+    std::chrono::system_clock::time_point time;
+    LogLevel level;
+    std::string message;
+
+    // Deferred records are formatted by the writer thread
+    LogFormatter formatter = nullptr;
+    fmt::string_view format;
+    alignas(std::max_align_t) unsigned char args[DEFERRED_ARGS_SIZE];
+};
+
+// Log messages are formatted by the calling thread directly into a ring buffer, and
+// printed by a background writer thread so that logging never waits for the output.
+// Errors are printed synchronously, after every pending message, in case they precede a crash.
+//
+// The log event is fired from the writer thread, once the message has been printed.
 class Logger
 {
   public:
@@ -79,90 +121,166 @@ class Logger
 
     static void setLogOutput(std::FILE *logOut);
 
+    /**
+     * Enables or disables the writer thread (enabled by default).
+     * When disabled, messages are printed synchronously by the calling thread.
+     */
+    static void setAsync(bool async);
+
+    /**
+     * Waits until every pending message has been printed.
+     */
+    static void flush();
+
+    inline static bool isEnabled(LogLevel level)
+    {
+        return (int)level <= BRLS_LOG_MIN_LEVEL && Logger::logLevel >= level;
+    }
+
     template <typename... Args>
-    inline static void log(LogLevel level, std::string prefix, std::string color, fmt::format_string<Args...> format, Args&&... args)
+    inline static void log(LogLevel level, fmt::format_string<Args...> format, Args&&... args)
     {
-        if (Logger::logLevel < level)
+        if (!Logger::isEnabled(level))
             return;
 
-        TimePoint now = std::chrono::system_clock::now();
-        uint64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()).count() % 1000;
-#ifdef PS4
-        OrbisDateTime lt{};
-        if (sceRtcGetCurrentClockLocalTime)
-            sceRtcGetCurrentClockLocalTime(&lt);
-#else
-        std::tm time_tm = fmt::localtime(std::chrono::system_clock::to_time_t(now));
-#endif
-        std::string log = fmt::format(format, std::forward<Args>(args)...);
+        TimePoint now      = std::chrono::system_clock::now();
+        LogRecord* record = Logger::beginRecord(now, level);
 
         try
         {
-#ifdef IOS
-            fmt::print(logOut, "{:%H:%M:%S}.{:03d} {} {}\n", time_tm, (int)ms, color, log);
-#elif defined(ANDROID)
-            __android_log_print(6 - (int)level, "borealis", "%02d:%02d:%02d.%03d %s\n", time_tm.tm_hour, time_tm.tm_min, time_tm.tm_sec, (int)ms, log.c_str());
-#elif defined(__PSV__)
-            sceClibPrintf("%02d:%02d:%02d.%03d\033%s[%s]\033[0m %s\n", time_tm.tm_hour, time_tm.tm_min, time_tm.tm_sec, (int)ms, color.c_str(), prefix.c_str(), log.c_str());
-#elif defined(PS4)
-            sceKernelDebugOutText(0, fmt::format("{:02d}:{:02d}:{:02d}.{:03d}\033{}[{}]\033[0m {}\n", lt.hour, lt.minute, lt.second, (int)ms, color, prefix, log).c_str());
-#else
-            fmt::print(logOut, "{:%H:%M:%S}.{:03d}\033{}[{}]\033[0m {}\n", time_tm, (int)ms, color, prefix, log);
-#endif
-
-            logEvent.fire(now, level, log);
+            if (record)
+                fmt::format_to(std::back_inserter(record->message), format, std::forward<Args>(args)...);
+            else
+                Logger::write(now, level, fmt::format(format, std::forward<Args>(args)...));
         }
         catch (const std::exception& e)
         {
-            // will be printed after the first fmt::print (so after the log tag)
-            printf("! Invalid log format string: \"%s\": %s\n", fmt::basic_string_view<char>(format).data(), e.what());
+            std::string error = fmt::format("! Invalid log format string: \"{}\": {}", fmt::string_view(format).data(), e.what());
+
+            if (record)
+                record->message = error;
+            else
+                Logger::write(now, level, error);
         }
 
-#ifdef __MINGW32__
-        fflush(logOut);
-#endif
+        if (record)
+            Logger::commitRecord(record);
+    }
+
+    /**
+     * Logs a message whose formatting is deferred to the writer thread, for the hottest call sites.
+     *
+     * Only accepts numbers, which are copied as-is into the record. The format string
+     * must be a string literal. Removed at compile time if level is below BRLS_LOG_MIN_LEVEL.
+     */
+    template <LogLevel level, typename... Args>
+    inline static void deferred(fmt::format_string<Args...> format, Args... args)
+    {
+        static_assert((std::is_arithmetic_v<Args> && ...), "deferred log arguments must be numbers");
+        static_assert(sizeof(std::tuple<Args...>) <= LogRecord::DEFERRED_ARGS_SIZE, "too many deferred log arguments");
+
+        if constexpr ((int)level > BRLS_LOG_MIN_LEVEL)
+            return;
+
+        if (!Logger::isEnabled(level))
+            return;
+
+        TimePoint now      = std::chrono::system_clock::now();
+        LogRecord* record = Logger::beginRecord(now, level);
+
+        if (!record)
+        {
+            Logger::write(now, level, fmt::format(format, args...));
+            return;
+        }
+
+        new (record->args) std::tuple<Args...>(args...);
+        record->format    = format;
+        record->formatter = [](std::string& message, fmt::string_view format, const void* args)
+        {
+            std::apply([&](const Args&... values)
+                { fmt::format_to(std::back_inserter(message), fmt::runtime(format), values...); },
+                *(const std::tuple<Args...>*)args);
+        };
+
+        Logger::commitRecord(record);
     }
 
     template <typename... Args>
     inline static void error(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(LogLevel::LOG_ERROR, "ERROR", BRLS_ERROR_COLOR, format, std::forward<Args>(args)...);
+        Logger::log(LogLevel::LOG_ERROR, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     inline static void warning(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(LogLevel::LOG_WARNING, "WARNING", BRLS_WARNING_COLOR, format, std::forward<Args>(args)...);
+        if constexpr ((int)LogLevel::LOG_WARNING <= BRLS_LOG_MIN_LEVEL)
+            Logger::log(LogLevel::LOG_WARNING, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     inline static void info(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(LogLevel::LOG_INFO, "INFO", BRLS_INFO_COLOR, format, std::forward<Args>(args)...);
+        if constexpr ((int)LogLevel::LOG_INFO <= BRLS_LOG_MIN_LEVEL)
+            Logger::log(LogLevel::LOG_INFO, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     inline static void debug(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(LogLevel::LOG_DEBUG, "DEBUG", BRLS_DEBUG_COLOR, format, std::forward<Args>(args)...);
+        if constexpr ((int)LogLevel::LOG_DEBUG <= BRLS_LOG_MIN_LEVEL)
+            Logger::log(LogLevel::LOG_DEBUG, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     inline static void verbose(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(LogLevel::LOG_VERBOSE, "VERBOSE", BRLS_VERBOSE_COLOR, format, std::forward<Args>(args)...);
+        if constexpr ((int)LogLevel::LOG_VERBOSE <= BRLS_LOG_MIN_LEVEL)
+            Logger::log(LogLevel::LOG_VERBOSE, format, std::forward<Args>(args)...);
     }
 
+    /**
+     * Subscribes to every printed message, can be called from any thread.
+     * The callback is called from the writer thread, or from the logging thread
+     * when the message is printed synchronously.
+     */
+    static Event<TimePoint, LogLevel, std::string>::Subscription subscribeLogEvent(Event<TimePoint, LogLevel, std::string>::Callback callback);
+    static void unsubscribeLogEvent(Event<TimePoint, LogLevel, std::string>::Subscription subscription);
+
+    /**
+     * Returns the log event itself, which isn't synchronized with the writer thread:
+     * only subscribe to it directly before logging anything, use subscribeLogEvent() otherwise.
+     */
     static Event<TimePoint, LogLevel, std::string>* getLogEvent()
     {
         return &logEvent;
     }
 
   private:
+    /**
+     * Claims a ring buffer slot for a new message, starting the writer thread if needed.
+     * Returns nullptr if the message must be printed synchronously.
+     */
+    static LogRecord* beginRecord(TimePoint time, LogLevel level);
+    static void commitRecord(LogRecord* record);
+
+    /**
+     * Prints a message and fires the log event.
+     */
+    static void write(TimePoint time, LogLevel level, const std::string& log);
+    static void print(TimePoint time, LogLevel level, const std::string& log);
+    static void fireLogEvent(TimePoint time, LogLevel level, const std::string& log);
+
+    static bool drainRing();
+
+    static void* writerLoop(void*);
+
     inline static std::FILE *logOut = stdout;
     inline static LogLevel logLevel = LogLevel::LOG_INFO;
     inline static Event<TimePoint, LogLevel, std::string> logEvent;
+
+    inline static std::atomic<bool> async = true;
 };
 
 } // namespace brls
@@ -0,0 +1,83 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Read-only view of a whole file, memory-mapped on platforms supporting it
+// so that pages are only read from disk when accessed, and shared with the page cache.
+// Falls back to reading the file into a heap buffer elsewhere.
+class MappedFile
+{
+  public:
+    /**
+     * Opens the file at the given path, returns nullptr if it cannot be read.
+     * Empty files are opened with no data.
+     */
+    static std::shared_ptr<MappedFile> open(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const
+    {
+        return this->address;
+    }
+
+    size_t size() const
+    {
+        return this->length;
+    }
+
+    /**
+     * Returns true if the file is memory-mapped, false if it was read into memory.
+     */
+    bool isMapped() const
+    {
+        return this->mapped;
+    }
+
+    /**
+     * Asks the system to read the whole file ahead, to be called from
+     * a background thread before the data is needed.
+     */
+    void prefetch() const;
+
+  private:
+    MappedFile() = default;
+
+    const uint8_t* address = nullptr;
+    size_t length          = 0;
+    bool mapped            = false;
+
+    std::vector<uint8_t> buffer; // used when the file cannot be mapped
+
+#if defined(_WIN32) && !defined(__WINRT__)
+    void* mappingHandle = nullptr;
+#endif
+};
+
+} // namespace brls
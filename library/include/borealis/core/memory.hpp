@@ -0,0 +1,101 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+class Activity;
+
+// Memory held by the views created for an activity, see MemoryTracker::getStats()
+struct ActivityMemoryStats
+{
+    Activity* activity = nullptr; // nullptr for the views created outside of any activity
+    std::string name;
+
+    size_t views        = 0;
+    size_t viewBytes    = 0; // reserved by the view arena of the activity
+    size_t xmlDocuments = 0; // bound with View::bindXMLDocument()
+
+    size_t cachedImages      = 0; // images showing a texture of the TextureCache
+    size_t ownedTextures     = 0; // textures deleted with their image, see Image::setFreeTexture()
+    size_t ownedTextureBytes = 0;
+};
+
+// Memory held by the library, sizes are in bytes.
+// Texture sizes are estimated from their dimensions, as RGBA without mipmaps.
+struct MemoryStats
+{
+    size_t views     = 0;
+    size_t viewBytes = 0; // reserved by all the view arenas
+    size_t yogaNodes = 0; // used by views and waiting to be reused
+    std::map<std::string, size_t> viewsByClass;
+    size_t xmlDocuments = 0;
+
+    size_t cachedTextures     = 0; // in the TextureCache, sprites included
+    size_t cachedTextureBytes = 0; // sprites excluded, they are part of the sprite atlas
+    size_t ownedTextures      = 0;
+    size_t ownedTextureBytes  = 0;
+    size_t spriteAtlasBytes   = 0;
+    size_t fontBytes          = 0; // font files loaded in the font stash
+    size_t fontAtlasBytes     = 0; // glyphs texture of the font stash
+
+    size_t syncTasks  = 0;
+    size_t asyncTasks = 0;
+    size_t delayTasks = 0;
+
+    size_t leakedViews = 0; // still alive after the activity they were created for has been deleted
+
+    // From the bottom to the top of the activities stack, then the views created outside of any activity
+    std::vector<ActivityMemoryStats> activities;
+};
+
+// Accounting of the memory used by views, textures, fonts and tasks.
+//
+// Views are attributed to the activity that was on top of the stack when they were created,
+// the one whose view arena they are allocated from (see ViewPool).
+// Views still alive once that activity has been deleted are leaks: the application checks
+// for them after every deletion of views and logs them as warnings.
+//
+// Must only be used from the UI thread.
+class MemoryTracker
+{
+  public:
+    /**
+     * Walks all the live views and caches to count the memory they hold.
+     * Meant for debugging, too slow to be called every frame.
+     */
+    static MemoryStats getStats();
+
+    /**
+     * Logs the views still alive after their activity has been deleted, and returns them.
+     * Views of an activity are only reported once.
+     */
+    static std::vector<std::string> checkLeaks();
+
+    /**
+     * Returns a human readable summary of the given stats.
+     */
+    static std::string describe(const MemoryStats& stats);
+};
+
+} // namespace brls
@@ -0,0 +1,100 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Summary of a series of samples, all values are in microseconds
+struct ProfilerStats
+{
+    size_t count = 0;
+    Time last    = 0;
+    Time min     = 0;
+    Time max     = 0;
+    double avg   = 0;
+};
+
+// Ring buffer keeping the last SAMPLES_CAPACITY values of a series
+class ProfilerSeries
+{
+  public:
+    static constexpr size_t SAMPLES_CAPACITY = 240;
+
+    void push(Time value);
+    ProfilerStats stats() const;
+
+  private:
+    std::vector<Time> values;
+    size_t next  = 0;
+    size_t total = 0;
+};
+
+// Lightweight profiler fed by the main loop and by the library internals.
+//
+// Frame times are recorded automatically at the beginning of every frame.
+// Any other duration (time to interactive of an activity, layout passes...) can be
+// recorded as a named sample with addSample(), and plain numbers with setCounter().
+// Only the last ProfilerSeries::SAMPLES_CAPACITY values of every series are kept.
+//
+// Must only be used from the UI thread.
+class FrameProfiler
+{
+  public:
+    /**
+     * Called internally by the main loop at the beginning of every frame.
+     */
+    static void frameStart(Time now);
+
+    /**
+     * Records a named duration sample, in microseconds.
+     */
+    static void addSample(const std::string& name, Time value);
+
+    /**
+     * Sets or increments a named counter.
+     */
+    static void setCounter(const std::string& name, int64_t value);
+    static void addCounter(const std::string& name, int64_t value = 1);
+    static int64_t getCounter(const std::string& name);
+
+    /**
+     * Returns the stats of the frame times or of a named series.
+     */
+    static ProfilerStats getFrameStats();
+    static ProfilerStats getStats(const std::string& name);
+
+    static const std::map<std::string, int64_t>& getCounters();
+
+    /**
+     * Clears all the recorded frame times, samples and counters.
+     */
+    static void reset();
+
+  private:
+    inline static Time lastFrameStart = 0;
+    inline static ProfilerSeries frameTimes;
+    inline static std::map<std::string, ProfilerSeries> samples;
+    inline static std::map<std::string, int64_t> counters;
+};
+
+} // namespace brls
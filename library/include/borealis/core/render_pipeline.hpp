@@ -0,0 +1,82 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <borealis/core/video.hpp>
+
+namespace brls
+{
+
+// Renders the frames on a dedicated render thread, overlapping with the next frame on the UI thread.
+//
+// The UI thread records every frame: the calls nanovg makes to its backend (fills, strokes,
+// triangles and texture operations) are captured into a command list instead of reaching the GPU.
+// The render thread, which owns the graphics context, replays the list, flushes it and
+// presents while the UI thread handles the input and layout of the next frame.
+//
+// Texture creation, updates and deletions are recorded with a copy of their data, in order with
+// the draw calls: images get an id right away and can be drawn in the frame they are created in.
+// nanovg must only be used from the UI thread.
+//
+// Disabled by default. The video context has to install the pipeline on its nanovg context and
+// be able to move its graphics context to another thread (GLFW with OpenGL), otherwise frames
+// keep being rendered on the UI thread.
+class RenderPipeline
+{
+  public:
+    static constexpr int MAX_DEPTH = 2;
+
+    /**
+     * Sets how many frames the UI thread can record ahead of the render thread:
+     * 0 renders the frames on the UI thread (default), 1 or 2 enables the render thread.
+     * Applied at the beginning of the next frame.
+     */
+    static void setDepth(int depth);
+    static int getDepth();
+
+    /**
+     * Returns true if the frames are currently rendered on the render thread.
+     */
+    static bool isRunning();
+
+    /**
+     * Called by the video context right after creating its nanovg context, to route the backend
+     * calls through the pipeline. Rendering stays on the calling thread until enabled with setDepth().
+     */
+    static void install(NVGcontext* vg);
+
+    /**
+     * Called by the application around every frame, instead of the video context begin / clear / end.
+     * endFrame() blocks while more than getDepth() frames are waiting to be rendered.
+     */
+    static void beginFrame(VideoContext* videoContext, NVGcolor clearColor);
+    static void endFrame(VideoContext* videoContext);
+
+    /**
+     * Waits for the render thread to render the pending frames and gives the graphics context
+     * back to the UI thread. Called by the application on exit.
+     */
+    static void stop();
+
+  private:
+    static void start(VideoContext* videoContext);
+    static void* renderTask(void* arg);
+};
+
+} // namespace brls
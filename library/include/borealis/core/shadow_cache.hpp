@@ -0,0 +1,93 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace brls
+{
+
+// Parameters of a drop shadow, as drawn around views and the highlight
+struct ShadowStyle
+{
+    float cornerRadius = 0.0f; // of the view casting the shadow
+    float width        = 0.0f; // vertical offset of the shadow
+    float feather      = 0.0f;
+    float opacity      = 0.0f;
+    float offset       = 0.0f; // how far the shadow extends around the view
+
+    bool operator==(const ShadowStyle& other) const;
+};
+
+// Draws drop shadows from pre-rendered textures.
+//
+// A shadow is a box gradient filling the area around a rounded rectangle, which nanovg
+// can only draw as a stencil fill. Instead, every shadow style is rendered once to a small
+// texture holding its four corners, which is then stretched
+// to any size as eight nine-slice quads, without the middle one.
+//
+// Textures are kept for the last MAX_ENTRIES styles and display scales, and
+// dropped by the application when the theme changes. Dropped textures are only
+// deleted at the end of the frame, once the shadows drawn with them have been flushed.
+//
+// Must only be used from the UI thread.
+class ShadowCache
+{
+  public:
+    /**
+     * Draws the shadow of the given view frame, at the given alpha.
+     * Returns false if the frame is too small for the shadow to be sliced,
+     * in which case nothing is drawn and the caller has to draw the shadow itself.
+     */
+    static bool draw(NVGcontext* vg, float x, float y, float width, float height, ShadowStyle style, float alpha);
+
+    /**
+     * Deletes all the cached textures.
+     */
+    static void clear();
+
+    /**
+     * Deletes the textures dropped during the frame. Called by the application
+     * after the frame has been flushed.
+     */
+    static void endFrame(NVGcontext* vg);
+
+  private:
+    static constexpr size_t MAX_ENTRIES = 16;
+
+    struct Entry
+    {
+        ShadowStyle style;
+        float scale;
+
+        int image;
+        int inner; // texels of a quadrant inside of the gradient corner
+        int outer; // texels of a quadrant outside of the gradient corner
+        uint64_t lastUse;
+    };
+
+    static Entry* getEntry(NVGcontext* vg, ShadowStyle style, float scale);
+
+    inline static std::vector<Entry> entries;
+    inline static std::vector<int> retiredImages; // to delete at the end of the frame
+    inline static uint64_t uses = 0;
+};
+
+} // namespace brls
@@ -0,0 +1,152 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace brls
+{
+
+struct SpriteAtlasStats
+{
+    size_t pages;
+    size_t sprites;
+    size_t compactions;
+    size_t bytes; // of the page textures and of the sprites copies
+};
+
+// Packs small images into shared textures, so that views showing a lot of
+// icons don't each bind their own texture.
+//
+// Every sprite is packed with a skyline algorithm into a page, with a border of
+// duplicated edge pixels so that linear filtering doesn't sample its neighbours.
+// Space freed by released sprites is not reused by the skyline, so when no page has room
+// for a new sprite, the sprites of the pages that are mostly empty are packed again into new pages.
+// Only the sprites are kept in memory to do so, pages have no CPU side copy.
+//
+// Sprites are identified by handles, which are never valid nanovg images.
+// Image uses them as TextureCache values, which releases the sprites
+// once they are not used anymore.
+//
+// Pages are freed at the end of the frame, as draw calls recorded earlier in the
+// frame can still use them until nanovg flushes them.
+//
+// Must only be used from the UI thread.
+class SpriteAtlas
+{
+  public:
+    // Images bigger than that in any dimension are not packed
+    static constexpr int MAX_SPRITE_SIZE = 128;
+
+    struct Sprite
+    {
+        int image; // page texture
+        int x, y, width, height; // in the page, without the border
+        int pageSize;
+    };
+
+    /**
+     * Enables or disables the atlas for the images loaded from now on. Default is enabled.
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Packs the given RGBA8 image into a page, returns its handle.
+     * Returns 0 if the image is too big or the atlas is disabled.
+     */
+    static int add(NVGcontext* vg, const unsigned char* pixels, int width, int height);
+
+    /**
+     * Returns the location of the given sprite, which changes if its page is compacted.
+     * Returns nullptr if the handle is not a valid sprite.
+     */
+    static const Sprite* get(int handle);
+
+    /**
+     * Frees the given sprite, its page is deleted once empty.
+     */
+    static void release(int handle);
+
+    /**
+     * Creates a texture holding a copy of the given sprite, to be deleted by the caller.
+     * Returns 0 if the handle is not a valid sprite.
+     */
+    static int createTexture(NVGcontext* vg, int handle);
+
+    /**
+     * Deletes the pages released during the frame. Called by the application
+     * after the frame has been flushed.
+     */
+    static void endFrame(NVGcontext* vg);
+
+    /**
+     * Returns true if the given value is a sprite handle, not a nanovg image.
+     */
+    static bool isSprite(size_t value);
+
+    static SpriteAtlasStats getStats();
+
+  private:
+    static constexpr int PAGE_SIZE   = 1024;
+    static constexpr int BORDER      = 1;
+    static constexpr int HANDLE_FLAG = 1 << 30;
+
+    // Pages using less than that of their area are packed again
+    static constexpr float COMPACT_THRESHOLD = 0.5f;
+
+    struct SkylineNode
+    {
+        int x, y, width;
+    };
+
+    struct Page
+    {
+        int image;
+        std::vector<SkylineNode> skyline;
+        size_t sprites;
+        int usedArea; // by live sprites, with their border
+    };
+
+    struct Entry
+    {
+        Sprite sprite;
+        int page; // index in pages, -1 if not packed
+        bool used;
+        std::vector<unsigned char> pixels; // copy of the sprite, to move it when compacting
+
+    };
+
+    static int createPage(NVGcontext* vg);
+    static int fit(const Page& page, size_t index, int width, int height);
+    static bool pack(Page* page, int width, int height, int* x, int* y);
+    static bool insert(NVGcontext* vg, int pageIndex, int entryIndex);
+    static void compact(NVGcontext* vg);
+    static void deletePage(NVGcontext* vg, int index);
+
+    inline static bool enabled = true;
+    inline static std::vector<Page> pages;
+    inline static std::vector<Entry> entries;
+    inline static std::vector<int> freeEntries;
+    inline static std::vector<int> retiredImages; // page textures to delete at the end of the frame
+    inline static size_t compactions = 0;
+};
+
+} // namespace brls
@@ -0,0 +1,92 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/event.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace brls
+{
+
+// Battery and network state, as shown by the status widgets
+struct SystemStatus
+{
+    bool batteryAvailable = false;
+    int batteryLevel      = 100; // percentage
+    bool batteryCharging  = false;
+
+    bool wirelessAvailable = false;
+    bool wirelessConnected = false;
+    int wirelessLevel      = 3; // 0 to 3
+    bool ethernetConnected = false;
+
+    bool operator==(const SystemStatus& other) const;
+    bool operator!=(const SystemStatus& other) const;
+};
+
+typedef Event<std::shared_ptr<const SystemStatus>> SystemStatusEvent;
+
+// Queries the platform for the battery and network state on a background thread,
+// so that the widgets showing it never wait on the system.
+//
+// The state is polled every POLL_INTERVAL ms, and right away when the system notifies a
+// change where possible (netlink on Linux). Every state is published as an immutable snapshot,
+// the change event is only fired, on the UI thread, when the state is different.
+//
+// The service starts with the first subscriber and stops when the application exits.
+class SystemStatusService
+{
+  public:
+    static constexpr long POLL_INTERVAL = 5000;
+
+    /**
+     * Returns the last known state. Can be called from any thread.
+     */
+    static std::shared_ptr<const SystemStatus> getSnapshot();
+
+    /**
+     * Subscribes to the state changes, starting the service if needed.
+     * The callback is called on the UI thread.
+     */
+    static SystemStatusEvent::Subscription subscribe(SystemStatusEvent::Callback callback);
+    static void unsubscribe(SystemStatusEvent::Subscription subscription);
+
+    /**
+     * Queries the state again as soon as possible.
+     */
+    static void refresh();
+
+    static void start();
+    static void stop();
+
+  private:
+    static SystemStatus query();
+    static void publish(const SystemStatus& status);
+    static void* serviceTask(void* arg);
+
+    inline static std::mutex mutex;
+    inline static std::condition_variable wakeUp;
+    inline static bool running        = false;
+    inline static bool refreshPending = false;
+
+    inline static std::shared_ptr<const SystemStatus> snapshot = std::make_shared<SystemStatus>();
+    inline static SystemStatusEvent changeEvent;
+};
+
+} // namespace brls
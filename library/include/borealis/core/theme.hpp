@@ -19,9 +19,10 @@
 
 #include <nanovg.h>
 
+#include <cstdint>
 #include <initializer_list>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace brls
 {
@@ -32,31 +33,96 @@ enum class ThemeVariant
     DARK
 };
 
+// Interned theme color name, an index in the palettes
+// Get one with Theme::color() once and keep it to skip the name lookup
+typedef uint32_t ThemeColor;
+
+// Palette of a theme: colors stored densely, indexed by ThemeColor
 class ThemeValues
 {
   public:
     ThemeValues(std::initializer_list<std::pair<std::string, NVGcolor>> list);
 
     void addColor(const std::string&, NVGcolor color);
+    void addColor(ThemeColor id, NVGcolor color);
     NVGcolor getColor(const std::string&);
 
+    inline NVGcolor getColor(ThemeColor id)
+    {
+        if (id >= this->defined.size() || !this->defined[id])
+            unknownColor(id);
+
+        return this->palette[id];
+    }
+
+    bool hasColor(ThemeColor id);
+
   private:
-    std::unordered_map<std::string, NVGcolor> values;
+    [[noreturn]] void unknownColor(ThemeColor id);
+
+    std::vector<NVGcolor> palette;
+    std::vector<bool> defined;
 };
 
 // Simple wrapper around ThemeValues for the array operator
+// Only holds a pointer to the palette: copying it is free
 class Theme
 {
   public:
     Theme(ThemeValues* values);
     NVGcolor operator[](const std::string& name);
+    NVGcolor operator[](ThemeColor id)
+    {
+        return this->values->getColor(id);
+    }
 
     void addColor(const std::string&, NVGcolor color);
     NVGcolor getColor(const std::string& name);
+    NVGcolor getColor(ThemeColor id)
+    {
+        return this->values->getColor(id);
+    }
+
+    ThemeValues* getValues()
+    {
+        return this->values;
+    }
+
+    bool operator==(const Theme& other) const
+    {
+        return this->values == other.values;
+    }
+
+    bool operator!=(const Theme& other) const
+    {
+        return this->values != other.values;
+    }
 
     static Theme& getLightTheme();
     static Theme& getDarkTheme();
 
+    /**
+     * Returns the interned id of the given color name, creating it if needed.
+     * Can be called from any thread, but still hashes the name: prefer keeping the id.
+     */
+    static ThemeColor color(const std::string& name);
+    static std::string colorName(ThemeColor id);
+
+    /**
+     * Adds or replaces colors of the light and / or dark themes from JSON:
+     * { "light": { "brls/text": "#2D2D2D", ... }, "dark": { ... } }
+     * Colors are "#RRGGBB" or "#RRGGBBAA". The change is applied on the next frame.
+     * Returns false if the JSON is invalid, in which case no color is changed.
+     */
+    static bool loadFromJSON(const char* data, size_t size);
+    static bool loadFromFile(const std::string& path);
+
+    /**
+     * Incremented every time a color of any palette changes, to invalidate
+     * state computed from the colors.
+     */
+    static uint64_t getGeneration();
+
   private:
     ThemeValues* values;
 };
@@ -18,6 +18,7 @@
 
 #include <unistd.h>
 
+#include <borealis/core/time.hpp>
 #include <chrono>
 #include <functional>
 #include <mutex>
@@ -30,12 +31,8 @@ namespace brls
 
 struct DelayOperation
 {
-#ifdef PS4
-    uint64_t startPoint;
-#else
-    std::chrono::high_resolution_clock::time_point startPoint;
-#endif
-    long delayMilliseconds;
+    Time startPoint; // from getUITimeUsec()
+    Time delay; // in microseconds
     size_t index;
     std::function<void()> func;
 };
@@ -107,6 +104,13 @@ class Threading
         return &m_async_tasks;
     }
 
+    /**
+     * Returns the number of tasks waiting in each queue.
+     */
+    static size_t getSyncTasksCount();
+    static size_t getAsyncTasksCount();
+    static size_t getDelayTasksCount();
+
   private:
     inline static std::mutex m_sync_mutex;
     inline static std::vector<std::function<void()>> m_sync_functions;
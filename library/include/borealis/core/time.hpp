@@ -35,6 +35,20 @@ inline Time getCPUTimeUsec()
     return cpu_features_get_time_usec();
 }
 
+/**
+ * Returns the current time of the user interface in microseconds, to be used for
+ * everything changing what is displayed: animations, tickings, delays, cursor blinking...
+ * It's the CPU time, except during an input replay where it follows the recorded clock.
+ * Use getCPUTimeUsec() to measure durations.
+ */
+Time getUITimeUsec();
+
+/**
+ * Makes getUITimeUsec() return the given time instead of the CPU time, 0 to go back
+ * to the CPU time. Used by input replays.
+ */
+void setUITimeOverride(Time time);
+
 typedef std::function<void()> TickingGenericCallback;
 
 typedef std::function<void(bool)> TickingEndCallback;
@@ -86,9 +100,12 @@ class Ticking
     /**
      * Called internally by the main loop. Takes all running tickings
      * and updates them.
+     * Now is the time of the frame being updated, in microseconds.
      */
+    static void updateTickings(Time now);
     static void updateTickings();
 
+    // Stopped tickings leave a nullptr until the end of the next update
     inline static std::vector<Ticking*> runningTickings;
 
   protected:
@@ -113,13 +130,28 @@ class Ticking
      */
     virtual void onStop() {};
 
-  private:
+    /**
+     * Adds the ticking to, or removes it from, the running tickings.
+     * Overridden by tickings updated by another system than updateTickings(),
+     * in which case they are responsible for calling tick() and stop(true).
+     */
+    virtual void schedule();
+    virtual void unschedule();
+
+    /**
+     * Executes the tick callback, if any.
+     */
+    void tick();
+    bool hasTickCallback();
+
     void stop(bool finished);
 
-    bool running = false;
+  private:
+    bool running        = false;
+    size_t runningIndex = 0;
 
-    TickingEndCallback endCallback   = [](bool finished) {};
-    TickingTickCallback tickCallback = [] {};
+    TickingEndCallback endCallback = [](bool finished) {};
+    TickingTickCallback tickCallback;
 };
 
 // Represents a "finite" ticking that runs for a known amount of time
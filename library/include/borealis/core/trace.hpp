@@ -0,0 +1,138 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <borealis/core/time.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Recorded events of one thread, written by that thread only.
+// The last CAPACITY events are kept: older ones are overwritten.
+class TraceBuffer
+{
+  public:
+    static constexpr size_t CAPACITY = 4096;
+
+    struct Event
+    {
+        // Atomic so that a dump can read the events while they are written
+        std::atomic<const char*> name { nullptr };
+        std::atomic<Time> begin { 0 };
+        std::atomic<Time> end { 0 };
+    };
+
+    void push(const char* name, Time begin, Time end);
+
+    int threadId = 0;
+    std::atomic<const char*> threadName { nullptr };
+    bool owned = false; // false once the thread ended, to be reused by another one
+
+    std::atomic<size_t> head { 0 }; // index of the next event
+    std::atomic<size_t> start { 0 }; // index of the first event, after a clear
+
+    Event events[CAPACITY];
+};
+
+// Scoped trace instrumentation, exported in the Chrome trace format
+// (chrome://tracing, https://ui.perfetto.dev).
+//
+// Every thread records its events in its own buffer, without locking: only the first
+// event of a thread takes a lock, to get a buffer. Buffers act as flight recorders,
+// dump() writes the last events of every thread at any time.
+//
+// The instrumentation macros are compiled out unless BRLS_TRACE is defined (-DBRLS_TRACE=ON).
+// With it, pressing both sticks (BUTTON_LSB + BUTTON_RSB) dumps the trace to DUMP_PATH.
+class Tracer
+{
+  public:
+    inline static std::string DUMP_PATH = "borealis_trace.json";
+
+    /**
+     * Records an event of the current thread, name must outlive the tracer (string literal).
+     * Times are in microseconds, from getCPUTimeUsec().
+     */
+    static void addEvent(const char* name, Time begin, Time end);
+
+    /**
+     * Names the current thread in the trace.
+     */
+    static void setThreadName(const char* name);
+
+    /**
+     * Returns the recorded events in the Chrome trace JSON format.
+     */
+    static std::string toJSON();
+
+    /**
+     * Writes the recorded events to the given file, in the Chrome trace JSON format.
+     * Returns false if the file could not be written.
+     */
+    static bool dump(const std::string& path = Tracer::DUMP_PATH);
+
+    /**
+     * Forgets all the recorded events.
+     */
+    static void clear();
+
+  private:
+    static TraceBuffer* getThreadBuffer();
+    static void releaseThreadBuffer(TraceBuffer* buffer);
+
+    friend struct ThreadTraceBuffer;
+
+    inline static std::mutex buffersMutex;
+    inline static std::vector<TraceBuffer*> buffers;
+    inline static int nextThreadId = 1;
+};
+
+// Records the time spent between its construction and its destruction
+class TraceScope
+{
+  public:
+    TraceScope(const char* name)
+        : name(name)
+        , begin(getCPUTimeUsec())
+    {
+    }
+
+    ~TraceScope()
+    {
+        Tracer::addEvent(this->name, this->begin, getCPUTimeUsec());
+    }
+
+  private:
+    const char* name;
+    Time begin;
+};
+
+} // namespace brls
+
+#define BRLS_TRACE_CONCAT2(a, b) a##b
+#define BRLS_TRACE_CONCAT(a, b) BRLS_TRACE_CONCAT2(a, b)
+
+#ifdef BRLS_TRACE
+#define BRLS_TRACE_SCOPE(name) ::brls::TraceScope BRLS_TRACE_CONCAT(brlsTraceScope, __LINE__)(name)
+#define BRLS_TRACE_THREAD_NAME(name) ::brls::Tracer::setThreadName(name)
+#else
+#define BRLS_TRACE_SCOPE(name) ((void)0)
+#define BRLS_TRACE_THREAD_NAME(name) ((void)0)
+#endif
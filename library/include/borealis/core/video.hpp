@@ -19,6 +19,7 @@
 #include <nanovg.h>
 
 #include <cmath>
+#include <cstdint>
 
 // A VideoContext is responsible for providing a nanovg context for the app
 // (so by extension it manages all the graphics state as well as the window / context).
@@ -52,6 +53,13 @@ class VideoContext
      */
     virtual void resetState() = 0;
 
+    /**
+     * Binds (or releases) the graphics context to the calling thread, for
+     * the render pipeline to render on its own thread.
+     * Returns false if the context cannot be moved to another thread.
+     */
+    virtual bool makeCurrent(bool current) { return false; }
+
     /*
      * scale factor between window size and drawable size
      */
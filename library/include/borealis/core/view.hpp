@@ -32,6 +32,8 @@
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/core/view_pool.hpp>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <set>
@@ -230,8 +232,11 @@ float ntz(float value);
 class View
 {
   private:
+    friend class DrawList;
+
     ViewBackground background = ViewBackground::NONE;
 
+    void drawDecorations(FrameContext* ctx, Style style, Rect frame);
     void drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame);
     void drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame);
     void drawBorder(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame);
@@ -294,11 +299,18 @@ class View
     std::unordered_map<std::string, FloatAttributeHandler> floatAttributes;
     std::unordered_map<std::string, StringAttributeHandler> stringAttributes;
     std::unordered_map<std::string, ColorAttributeHandler> colorAttributes;
+    std::unordered_map<std::string, ThemeColor> themedAttributes; // color attributes set from "@theme/"
     std::unordered_map<std::string, BoolAttributeHandler> boolAttributes;
     std::unordered_map<std::string, FilePathAttributeHandler> filePathAttributes;
 
     std::set<std::string> knownAttributes;
 
+    Rect layoutFrame; // frame of the last layout pass, relative to the parent
+    bool layoutFrameValid  = false;
+    bool layoutEventQueued = false;
+
+    inline static std::deque<View*> layoutEventQueue;
+
     void registerCommonAttributes();
     void printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value);
 
@@ -389,6 +401,20 @@ class View
     View();
     virtual ~View();
 
+    /**
+     * Views are allocated from the ViewPool, in the arena
+     * of the activity on top of the stack.
+     */
+    static void* operator new(size_t size)
+    {
+        return ViewPool::allocate(size);
+    }
+
+    static void operator delete(void* ptr)
+    {
+        ViewPool::deallocate(ptr);
+    }
+
     void setBackground(ViewBackground background);
 
     void shakeHighlight(FocusDirection direction);
@@ -414,10 +440,31 @@ class View
     virtual void invalidate();
 
     /**
-     * Called when a layout pass ends on that view.
+     * Called when a layout pass ends on that view, if its size changed
+     * since the previous one (or after invalidateLayoutFrame()).
      */
     virtual void onLayout() {};
 
+    /**
+     * Called when a layout pass ends on that view, if it moved
+     * without being resized. onLayout() is not called in that case.
+     */
+    virtual void onPositionChanged() {};
+
+    /**
+     * Forgets the frame of the last layout pass, so that onLayout() is called
+     * after the next one even if the size of the view didn't change.
+     * For views whose layout depends on more than their size (text, content...).
+     */
+    void invalidateLayoutFrame();
+
+    /**
+     * Called by the application for every view laid out by Yoga, then once the layout pass
+     * ends to call onLayout() or onPositionChanged() on the views whose frame changed.
+     */
+    static void queueLayoutEvent(View* view);
+    static void dispatchLayoutEvents();
+
     /**
      * Returns the view with the corresponding id in the view or its children,
      * or nullptr if it hasn't been found.
@@ -987,6 +1034,26 @@ class View
      */
     static View* createFromXMLResource(std::string name);
 
+    /**
+     * Creates a view from the given XML element, applying its attributes but
+     * without handling its children XML elements.
+     *
+     * The children can then be handled one by one with handleXMLElement(), which
+     * allows the inflation of a large XML to be split across multiple frames.
+     */
+    static View* createFromXMLElementShallow(tinyxml2::XMLElement* element);
+
+    /**
+     * Parses an XML string, file or resource without creating any view.
+     *
+     * These methods don't touch the views tree, so they are safe to be called
+     * from another thread (see Application::pushActivityAsync()).
+     * Throws if the XML is invalid or has no root element.
+     */
+    static tinyxml2::XMLDocument* loadXMLDocumentFromString(std::string_view xml);
+    static tinyxml2::XMLDocument* loadXMLDocumentFromFile(std::string path);
+    static tinyxml2::XMLDocument* loadXMLDocumentFromResource(std::string name);
+
     /**
      * Handles a child XML element.
      *
@@ -998,6 +1065,22 @@ class View
      */
     virtual void handleXMLElement(tinyxml2::XMLElement* element);
 
+    /**
+     * Returns true if the next child XML element can be instantiated
+     * separately and given to addXMLChildView() once its own children are handled.
+     * Application::pushActivityAsync() uses it to spread the inflation of a
+     * subtree across several frames. Otherwise, the element is given to handleXMLElement().
+     *
+     * Views overriding one of handleXMLElement(), canAddXMLChildView() or addXMLChildView()
+     * must keep handleXMLElement() equivalent to addXMLChildView(createFromXMLElement(element)).
+     */
+    virtual bool canAddXMLChildView();
+
+    /**
+     * Adds a view instantiated from a child XML element, see canAddXMLChildView().
+     */
+    virtual void addXMLChildView(View* view);
+
     /**
      * Applies the attributes of the given XML element to the view.
      *
@@ -1087,6 +1170,11 @@ class View
      */
     void bindXMLDocument(tinyxml2::XMLDocument* document);
 
+    /**
+     * Returns the number of XML documents bound to the view.
+     */
+    size_t getBoundXMLDocumentsCount();
+
     /**
      * Returns if the given XML attribute name is valid for that view.
      */
@@ -1459,6 +1547,13 @@ class View
         // Nothing by default
     }
 
+    /**
+     * Fired when the theme variant or colors change, before the next frame.
+     * Reapplies the "@theme/" XML attributes by default, views resolving
+     * theme colors in code have to resolve them again.
+     */
+    virtual void onThemeChanged();
+
     GenericEvent* getFocusEvent();
     GenericEvent* getFocusLostEvent();
 
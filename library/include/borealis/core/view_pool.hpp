@@ -0,0 +1,182 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <yoga/Yoga.h>
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace brls
+{
+
+class View;
+
+// Occupancy of the view pool, see ViewPool::getStats()
+struct ViewPoolStats
+{
+    size_t liveViews     = 0; // View instances currently alive
+    size_t usedBlocks    = 0; // pool blocks currently holding a view
+    size_t freeBlocks    = 0; // pool blocks waiting to be reused
+    size_t slabs         = 0; // slabs allocated from the system heap
+    size_t reservedBytes = 0; // total size of the slabs
+    size_t arenas        = 0; // activity arenas still holding memory
+    size_t heapViews     = 0; // views too large for the pool, allocated from the system heap
+    size_t freeNodes     = 0; // Yoga nodes waiting to be reused
+    size_t leakedViews   = 0; // views alive after the arena they were created in has been released
+};
+
+// A set of slabs views are allocated from. Every activity owns one, so that
+// its whole views tree lives in the same memory and is given back
+// to the system at once when the activity is deleted.
+//
+// Arenas are created and released through ViewPool.
+class ViewArena
+{
+  public:
+    // Every size class is BLOCK_GRANULARITY bytes bigger than the previous one
+    static constexpr size_t BLOCK_GRANULARITY = 64;
+    static constexpr size_t SIZE_CLASSES      = 64; // up to 4KB
+    static constexpr size_t SLAB_SIZE         = 16 * 1024;
+
+  private:
+    friend class ViewPool;
+
+    ~ViewArena();
+
+    void* allocate(size_t sizeClass);
+    void deallocate(void* block, size_t sizeClass);
+
+    std::array<void*, SIZE_CLASSES> freeLists = {};
+    std::vector<void*> slabs;
+
+    size_t usedBlocks    = 0;
+    size_t freeBlocks    = 0;
+    size_t reservedBytes = 0;
+
+    size_t views = 0; // live views created while the arena was the current one
+
+    bool released      = false;
+    bool leaksReported = false;
+};
+
+// Allocator used by every View (see View::operator new) and their Yoga nodes.
+//
+// Views are allocated from size-classed slabs instead of individually from the system heap,
+// which keeps the heap from being fragmented by thousands of small views on
+// platforms with little memory. Blocks go back to the arena they come from when the view is deleted.
+//
+// Yoga nodes of deleted views are reset and kept to be reused by the next views.
+//
+// Thread safe, although views should only be created and deleted from the UI thread.
+class ViewPool
+{
+  public:
+    /**
+     * Allocates memory for a view of the given size from the current arena.
+     * Falls back to the system heap for views larger than the biggest size class.
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * Gives back memory returned by allocate().
+     */
+    static void deallocate(void* ptr);
+
+    /**
+     * Creates a new arena. Must be released with releaseArena().
+     */
+    static ViewArena* createArena();
+
+    /**
+     * Releases an arena. Its slabs are freed as soon as the
+     * last view allocated from it is deleted, which can be immediately.
+     */
+    static void releaseArena(ViewArena* arena);
+
+    /**
+     * Sets the arena new views are allocated from.
+     * Set to nullptr to use the global arena.
+     *
+     * Called by Application when the top activity changes.
+     */
+    static void setCurrentArena(ViewArena* arena);
+    static ViewArena* getCurrentArena();
+
+    /**
+     * Returns a ready to use Yoga node, reused from a deleted view if possible.
+     */
+    static YGNodeRef acquireNode();
+
+    /**
+     * Detaches the given node from its owner and children and keeps it for reuse.
+     */
+    static void recycleNode(YGNodeRef node);
+
+    /**
+     * Frees the Yoga nodes waiting to be reused.
+     */
+    static void trim();
+
+    /**
+     * Called by View constructor and destructor to keep track of the live views.
+     */
+    static void viewCreated(View* view);
+    static void viewDestroyed(View* view);
+
+    /**
+     * Returns every live view, with the arena that was current when it was created
+     * (nullptr for the global arena).
+     */
+    static std::vector<std::pair<View*, ViewArena*>> getLiveViews();
+
+    /**
+     * Returns the views still alive after the arena they were created in has been
+     * released, meaning that their activity has been deleted.
+     * Only the arenas that haven't been reported by a previous call are checked.
+     */
+    static std::vector<View*> takeLeakedViews();
+
+    static ViewPoolStats getStats();
+
+    /**
+     * Returns the stats of the given arena only, nullptr for the global arena.
+     */
+    static ViewPoolStats getStats(ViewArena* arena);
+
+  private:
+    static constexpr size_t MAX_FREE_NODES = 1024;
+
+    inline static std::mutex poolMutex;
+
+    inline static ViewArena* globalArena  = nullptr;
+    inline static ViewArena* currentArena = nullptr;
+    inline static std::vector<ViewArena*> arenas;
+
+    inline static std::vector<YGNodeRef> freeNodes;
+
+    // Live views and the arena that was current when they were created
+    inline static std::unordered_map<View*, ViewArena*> liveViews;
+    inline static size_t heapViews = 0;
+
+    static void deleteArenaIfUnused(ViewArena* arena);
+};
+
+} // namespace brls
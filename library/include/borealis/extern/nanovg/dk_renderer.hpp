@@ -203,6 +203,7 @@ namespace nvg {
             int CreateTexture(const DKNVGcontext &ctx, int type, int w, int h, int image_flags, const u8 *data);
             int DeleteTexture(const DKNVGcontext &ctx, int id);
             int UpdateTexture(const DKNVGcontext &ctx, int id, int x, int y, int w, int h, const u8 *data);
+            int UpdateTextureRegion(const DKNVGcontext &ctx, int id, int x, int y, int w, int h, const u8 *data); // borealis addition
             int GetTextureSize(const DKNVGcontext &ctx, int id, int *w, int *h);
             const DKNVGtextureDescriptor *GetTextureDescriptor(const DKNVGcontext &ctx, int id);
 
@@ -87,19 +87,39 @@ struct FONStextIter {
 };
 typedef struct FONStextIter FONStextIter;
 
+// Glyph rasterized outside of the atlas, see fonsRasterizeGlyph().
+struct FONSglyphImage {
+	unsigned int codepoint;
+	short size; // font size * 10, as stored in the glyph cache
+	int index; // glyph index in the font that rendered it
+	short xadv, xoff, yoff;
+	short width, height; // padding included
+	unsigned char* data; // width * height bytes, released by fonsFreeGlyphImage()
+};
+typedef struct FONSglyphImage FONSglyphImage;
+
 typedef struct FONScontext FONScontext;
+typedef struct FONSrasterizer FONSrasterizer;
 
 // Constructor and destructor.
 FONScontext* fonsCreateInternal(FONSparams* params);
 void fonsDeleteInternal(FONScontext* s);
 
 void fonsSetErrorCallback(FONScontext* s, void (*callback)(void* uptr, int error, int val), void* uptr);
+// Called when a codepoint is found neither in a font nor in its fallbacks, before caching an empty glyph.
+// The callback can add fallback fonts to the given font and return non-zero to have them searched.
+void fonsSetMissingGlyphCallback(FONScontext* s, int (*callback)(void* uptr, int font, unsigned int codepoint), void* uptr);
 // Returns current atlas size.
 void fonsGetAtlasSize(FONScontext* s, int* width, int* height);
 // Expands the atlas size.
 int fonsExpandAtlas(FONScontext* s, int width, int height);
 // Resets the whole stash.
 int fonsResetAtlas(FONScontext* stash, int width, int height);
+// Resets the atlas to the given size, keeping the most recently used glyphs as long as they fit in half of it.
+// The other glyphs keep their metrics and are rasterized again when needed.
+int fonsEvictAtlas(FONScontext* stash, int width, int height);
+// Advances the frame counter used to find the least recently used glyphs.
+void fonsNextFrame(FONScontext* s);
 
 // Add fonts
 int fonsAddFont(FONScontext* s, const char* name, const char* path, int fontIndex);
@@ -136,6 +156,21 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, struct FONSquad* qu
 const unsigned char* fonsGetTextureData(FONScontext* stash, int* width, int* height);
 int fonsValidateTexture(FONScontext* s, int* dirty);
 
+// Off-thread rasterization.
+// A rasterizer works on a snapshot of a font and its fallbacks and can be used from any thread, one at a time.
+// Create and delete it from the thread owning the stash. Fonts data must outlive it.
+FONSrasterizer* fonsCreateRasterizer(FONScontext* s, int font);
+void fonsDeleteRasterizer(FONSrasterizer* r);
+// Returns the data of the fonts used by the rasterizer, the font itself being the first one.
+int fonsRasterizerFontCount(FONSrasterizer* r);
+const unsigned char* fonsRasterizerFontData(FONSrasterizer* r, int i, int* size);
+// Renders a glyph without blur nor dilate. Returns 0 if no font of the rasterizer has the glyph.
+int fonsRasterizeGlyph(FONSrasterizer* r, unsigned int codepoint, float size, FONSglyphImage* image);
+void fonsFreeGlyphImage(FONSglyphImage* image);
+// Adds a glyph rendered by fonsRasterizeGlyph() to the atlas and to the glyph cache of the given font.
+// Returns 1 if added or already in the atlas, 0 if the atlas is full.
+int fonsAddGlyphImage(FONScontext* s, int font, const FONSglyphImage* image);
+
 // Draws the stash texture for debugging
 void fonsDrawDebug(FONScontext* s, float x, float y);
 
@@ -229,6 +264,7 @@ struct FONSglyph
 	short size, blur, dilate;
 	short x0,y0,x1,y1;
 	short xadv,xoff,yoff;
+	unsigned int lastUsed;
 };
 typedef struct FONSglyph FONSglyph;
 
@@ -297,6 +333,9 @@ struct FONScontext
 	int nstates;
 	void (*handleError)(void* uptr, int error, int val);
 	void* errorUptr;
+	int (*handleMissingGlyph)(void* uptr, int font, unsigned int codepoint);
+	void* missingGlyphUptr;
+	unsigned int frame;
 #ifdef FONS_USE_FREETYPE
 	FT_Library ftLibrary;
 #endif
@@ -1249,7 +1288,11 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 			&& font->glyphs[i].dilate == idilate
 		) {
 			glyph = &font->glyphs[i];
-			if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL || (glyph->x0 >= 0 && glyph->y0 >= 0)) {
+			if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL) {
+			  return glyph;
+			}
+			if (glyph->x0 >= 0 && glyph->y0 >= 0) {
+			  glyph->lastUsed = stash->frame;
 			  return glyph;
 			}
 			// At this point, glyph exists but the bitmap data is not yet created.
@@ -1271,6 +1314,24 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 				break;
 			}
 		}
+		// Give a chance to add fallback fonts on demand, then search the new ones.
+		if (g == 0 && stash->handleMissingGlyph != NULL) {
+			int fontIndex, nfallbacks = font->nfallbacks;
+			for (fontIndex = 0; fontIndex < stash->nfonts; ++fontIndex)
+				if (stash->fonts[fontIndex] == font) break;
+			if (stash->handleMissingGlyph(stash->missingGlyphUptr, fontIndex, codepoint)) {
+				stash->nscratch = 0;
+				for (i = nfallbacks; i < font->nfallbacks; ++i) {
+					FONSfont* fallbackFont = stash->fonts[font->fallbacks[i]];
+					int fallbackIndex = fons__tt_getGlyphIndex(&fallbackFont->font, codepoint);
+					if (fallbackIndex != 0) {
+						g = fallbackIndex;
+						renderFont = fallbackFont;
+						break;
+					}
+				}
+			}
+		}
 		// It is possible that we did not find a fallback glyph.
 		// In that case the glyph index 'g' is 0, and we'll proceed below and cache empty glyph.
 	}
@@ -1316,6 +1377,7 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	glyph->xadv = (short)(scale * advance * 10.0f);
 	glyph->xoff = (short)(x0 - pad);
 	glyph->yoff = (short)(y0 - pad);
+	glyph->lastUsed = stash->frame;
 
 	if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL) {
 		return glyph;
@@ -1839,6 +1901,13 @@ void fonsSetErrorCallback(FONScontext* stash, void (*callback)(void* uptr, int e
 	stash->errorUptr = uptr;
 }
 
+void fonsSetMissingGlyphCallback(FONScontext* stash, int (*callback)(void* uptr, int font, unsigned int codepoint), void* uptr)
+{
+	if (stash == NULL) return;
+	stash->handleMissingGlyph = callback;
+	stash->missingGlyphUptr = uptr;
+}
+
 void fonsGetAtlasSize(FONScontext* stash, int* width, int* height)
 {
 	if (stash == NULL) return;
@@ -1949,5 +2018,319 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 	return 1;
 }
 
+static int fons__compareGlyphUse(const void* a, const void* b)
+{
+	const FONSglyph* ga = *(const FONSglyph* const*)a;
+	const FONSglyph* gb = *(const FONSglyph* const*)b;
+	// Most recently used first
+	if (ga->lastUsed != gb->lastUsed)
+		return ga->lastUsed > gb->lastUsed ? -1 : 1;
+	return 0;
+}
+
+int fonsEvictAtlas(FONScontext* stash, int width, int height)
+{
+	int i, j, y, n = 0, area = 0;
+	FONSglyph** glyphs;
+	unsigned char* oldData;
+	int oldWidth;
+
+	if (stash == NULL) return 0;
+
+	// Flush pending glyphs.
+	fons__flush(stash);
+
+	// Collect the glyphs having a bitmap in the atlas.
+	for (i = 0; i < stash->nfonts; i++)
+		n += stash->fonts[i]->nglyphs;
+	glyphs = (FONSglyph**)malloc(sizeof(FONSglyph*) * (n > 0 ? n : 1));
+	if (glyphs == NULL)
+		return fonsResetAtlas(stash, width, height);
+	n = 0;
+	for (i = 0; i < stash->nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		for (j = 0; j < font->nglyphs; j++) {
+			if (font->glyphs[j].x0 >= 0 && font->glyphs[j].y0 >= 0)
+				glyphs[n++] = &font->glyphs[j];
+		}
+	}
+	qsort(glyphs, n, sizeof(FONSglyph*), fons__compareGlyphUse);
+
+	// Create new texture
+	if (stash->params.renderResize != NULL) {
+		if (stash->params.renderResize(stash->params.userPtr, width, height) == 0) {
+			free(glyphs);
+			return 0;
+		}
+	}
+
+	oldData = stash->texData;
+	oldWidth = stash->params.width;
+	stash->texData = (unsigned char*)malloc(width * height);
+	if (stash->texData == NULL) {
+		stash->texData = oldData;
+		free(glyphs);
+		return 0;
+	}
+	memset(stash->texData, 0, width * height);
+
+	fons__atlasReset(stash->atlas, width, height);
+	stash->params.width = width;
+	stash->params.height = height;
+	stash->itw = 1.0f/stash->params.width;
+	stash->ith = 1.0f/stash->params.height;
+
+	// Add white rect at 0,0 for debug drawing.
+	fons__addWhiteRect(stash, 2,2);
+
+	// Move the most recently used glyphs to the new atlas, the others will be rasterized again when needed.
+	for (i = 0; i < n; i++) {
+		FONSglyph* glyph = glyphs[i];
+		int gw = glyph->x1 - glyph->x0;
+		int gh = glyph->y1 - glyph->y0;
+		int gx, gy;
+
+		if (area + gw*gh <= width*height/2 && fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy)) {
+			for (y = 0; y < gh; y++)
+				memcpy(&stash->texData[gx + (gy+y) * width], &oldData[glyph->x0 + (glyph->y0+y) * oldWidth], gw);
+			glyph->x0 = (short)gx;
+			glyph->y0 = (short)gy;
+			area += gw*gh;
+		} else {
+			// Same as a glyph only measured, see FONS_GLYPH_BITMAP_OPTIONAL
+			glyph->x0 = -1;
+			glyph->y0 = -1;
+		}
+		glyph->x1 = (short)(glyph->x0 + gw);
+		glyph->y1 = (short)(glyph->y0 + gh);
+	}
+
+	free(oldData);
+	free(glyphs);
+
+	// The whole texture has to be uploaded
+	stash->dirtyRect[0] = 0;
+	stash->dirtyRect[1] = 0;
+	stash->dirtyRect[2] = width;
+	stash->dirtyRect[3] = height;
+
+	return 1;
+}
+
+void fonsNextFrame(FONScontext* stash)
+{
+	stash->frame++;
+}
+
+#ifndef FONS_USE_FREETYPE
+
+struct FONSrasterizer
+{
+	FONSttFontImpl fonts[FONS_MAX_FALLBACKS+1];
+	const unsigned char* data[FONS_MAX_FALLBACKS+1];
+	int dataSize[FONS_MAX_FALLBACKS+1];
+	int nfonts;
+	// Own context for the temporary allocations of stb_truetype, see fons__tmpalloc()
+	FONScontext scratch;
+};
+
+FONSrasterizer* fonsCreateRasterizer(FONScontext* stash, int font)
+{
+	FONSrasterizer* r;
+	FONSfont* base;
+	int i;
+
+	if (stash == NULL || font < 0 || font >= stash->nfonts) return NULL;
+
+	r = (FONSrasterizer*)calloc(1, sizeof(FONSrasterizer));
+	if (r == NULL) return NULL;
+	r->scratch.scratch = (unsigned char*)malloc(FONS_SCRATCH_BUF_SIZE);
+	if (r->scratch.scratch == NULL) {
+		free(r);
+		return NULL;
+	}
+
+	base = stash->fonts[font];
+	for (i = -1; i < base->nfallbacks; i++) {
+		FONSfont* f = i < 0 ? base : stash->fonts[base->fallbacks[i]];
+		r->fonts[r->nfonts] = f->font;
+		r->fonts[r->nfonts].font.userdata = &r->scratch;
+		r->data[r->nfonts] = f->data;
+		r->dataSize[r->nfonts] = f->dataSize;
+		r->nfonts++;
+	}
+
+	return r;
+}
+
+void fonsDeleteRasterizer(FONSrasterizer* r)
+{
+	if (r == NULL) return;
+	free(r->scratch.scratch);
+	free(r);
+}
+
+int fonsRasterizerFontCount(FONSrasterizer* r)
+{
+	return r != NULL ? r->nfonts : 0;
+}
+
+const unsigned char* fonsRasterizerFontData(FONSrasterizer* r, int i, int* size)
+{
+	if (r == NULL || i < 0 || i >= r->nfonts) return NULL;
+	if (size) *size = r->dataSize[i];
+	return r->data[i];
+}
+
+int fonsRasterizeGlyph(FONSrasterizer* r, unsigned int codepoint, float size, FONSglyphImage* image)
+{
+	int i, g = 0, advance, lsb, x0, y0, x1, y1, gw, gh;
+	const int pad = 2; // anti-alias bonus of fons__getGlyph()
+	short isize = (short)(size*10.0f);
+	FONSttFontImpl* renderFont = NULL;
+	float scale;
+
+	if (r == NULL || isize < 2) return 0;
+	size = isize/10.0f;
+
+	for (i = 0; i < r->nfonts; i++) {
+		g = fons__tt_getGlyphIndex(&r->fonts[i], codepoint);
+		if (g != 0) {
+			renderFont = &r->fonts[i];
+			break;
+		}
+	}
+	if (renderFont == NULL) return 0;
+
+	// Reset allocator.
+	r->scratch.nscratch = 0;
+
+	scale = fons__tt_getPixelHeightScale(renderFont, size);
+	fons__tt_buildGlyphBitmap(renderFont, g, size, scale, &advance, &lsb, &x0, &y0, &x1, &y1);
+	gw = x1-x0 + pad*2;
+	gh = y1-y0 + pad*2;
+
+	// Padding is left empty
+	image->data = (unsigned char*)calloc(gw * gh, 1);
+	if (image->data == NULL) return 0;
+	fons__tt_renderGlyphBitmap(renderFont, &image->data[pad + pad * gw], gw-pad*2, gh-pad*2, gw, scale, scale, g);
+
+	image->codepoint = codepoint;
+	image->size = isize;
+	image->index = g;
+	image->xadv = (short)(scale * advance * 10.0f);
+	image->xoff = (short)(x0 - pad);
+	image->yoff = (short)(y0 - pad);
+	image->width = (short)gw;
+	image->height = (short)gh;
+
+	return 1;
+}
+
+#else
+
+// FreeType faces cannot be shared between threads
+FONSrasterizer* fonsCreateRasterizer(FONScontext* stash, int font)
+{
+	FONS_NOTUSED(stash);
+	FONS_NOTUSED(font);
+	return NULL;
+}
+
+void fonsDeleteRasterizer(FONSrasterizer* r)
+{
+	FONS_NOTUSED(r);
+}
+
+int fonsRasterizerFontCount(FONSrasterizer* r)
+{
+	FONS_NOTUSED(r);
+	return 0;
+}
+
+const unsigned char* fonsRasterizerFontData(FONSrasterizer* r, int i, int* size)
+{
+	FONS_NOTUSED(r);
+	FONS_NOTUSED(i);
+	FONS_NOTUSED(size);
+	return NULL;
+}
+
+int fonsRasterizeGlyph(FONSrasterizer* r, unsigned int codepoint, float size, FONSglyphImage* image)
+{
+	FONS_NOTUSED(r);
+	FONS_NOTUSED(codepoint);
+	FONS_NOTUSED(size);
+	FONS_NOTUSED(image);
+	return 0;
+}
+
+#endif
+
+void fonsFreeGlyphImage(FONSglyphImage* image)
+{
+	if (image == NULL) return;
+	free(image->data);
+	image->data = NULL;
+}
+
+int fonsAddGlyphImage(FONScontext* stash, int font, const FONSglyphImage* image)
+{
+	FONSfont* f;
+	FONSglyph* glyph = NULL;
+	unsigned int h;
+	int i, y, gx, gy;
+
+	if (stash == NULL || font < 0 || font >= stash->nfonts || image == NULL || image->data == NULL) return 0;
+	f = stash->fonts[font];
+
+	// Find code point and size.
+	h = fons__hashint(image->codepoint) & (FONS_HASH_LUT_SIZE-1);
+	for (i = f->lut[h]; i != -1; i = f->glyphs[i].next) {
+		if (f->glyphs[i].codepoint == image->codepoint && f->glyphs[i].size == image->size
+			&& f->glyphs[i].blur == 0 && f->glyphs[i].dilate == 0) {
+			glyph = &f->glyphs[i];
+			if (glyph->x0 >= 0 && glyph->y0 >= 0)
+				return 1;
+			break;
+		}
+	}
+
+	if (!fons__atlasAddRect(stash->atlas, image->width, image->height, &gx, &gy))
+		return 0;
+
+	if (glyph == NULL) {
+		glyph = fons__allocGlyph(f);
+		if (glyph == NULL) return 0;
+		glyph->codepoint = image->codepoint;
+		glyph->size = image->size;
+		glyph->blur = 0;
+		glyph->dilate = 0;
+
+		// Insert char to hash lookup.
+		glyph->next = f->lut[h];
+		f->lut[h] = f->nglyphs-1;
+	}
+	glyph->index = image->index;
+	glyph->x0 = (short)gx;
+	glyph->y0 = (short)gy;
+	glyph->x1 = (short)(gx + image->width);
+	glyph->y1 = (short)(gy + image->height);
+	glyph->xadv = image->xadv;
+	glyph->xoff = image->xoff;
+	glyph->yoff = image->yoff;
+	glyph->lastUsed = stash->frame;
+
+	for (y = 0; y < image->height; y++)
+		memcpy(&stash->texData[gx + (gy+y) * stash->params.width], &image->data[y * image->width], image->width);
+
+	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], glyph->x0);
+	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], glyph->y0);
+	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], glyph->x1);
+	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], glyph->y1);
+
+	return 1;
+}
+
 
 #endif
@@ -390,6 +390,10 @@ int nvgCreateImageRGBA(NVGcontext* ctx, int w, int h, int imageFlags, const unsi
 // Updates image data specified by image handle.
 void nvgUpdateImage(NVGcontext* ctx, int image, const unsigned char* data);
 
+// Updates a region of image data specified by image handle.
+// Data only holds the pixels of the region, row after row.
+void nvgUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data);
+
 // Returns the dimensions of a created image.
 void nvgImageSize(NVGcontext* ctx, int image, int* w, int* h);
 
@@ -576,6 +580,17 @@ int nvgAddFallbackFont(NVGcontext* ctx, const char* baseFont, const char* fallba
 // Resets fallback fonts by handle.
 void nvgResetFallbackFontsId(NVGcontext* ctx, int baseFont);
 
+// Sets a callback called when a codepoint is missing from a font and all its fallbacks.
+// It can add fallback fonts to baseFont and return non-zero for them to be searched.
+void nvgSetMissingGlyphCallback(NVGcontext* ctx, int (*callback)(void* uptr, int baseFont, unsigned int codepoint), void* uptr);
+
+// Returns the font stash of the context, to add pre-rasterized glyphs with fontstash.h.
+struct FONScontext* nvgGetFontStash(NVGcontext* ctx);
+
+// Moves text rendering to a bigger atlas texture, keeping the most recently used glyphs.
+// Returns 0 if the atlas already has the maximum size or no more texture can be used this frame.
+int nvgGrowTextAtlas(NVGcontext* ctx);
+
 // Resets fallback fonts by name.
 void nvgResetFallbackFonts(NVGcontext* ctx, const char* baseFont);
 
@@ -686,6 +701,7 @@ struct NVGparams {
 	int (*renderCreateTexture)(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data);
 	int (*renderDeleteTexture)(void* uptr, int image);
 	int (*renderUpdateTexture)(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data);
+	int (*renderUpdateTextureRegion)(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data); // data only holds the region
 	int (*renderGetTextureSize)(void* uptr, int image, int* w, int* h);
 	void (*renderViewport)(void* uptr, float width, float height, float devicePixelRatio);
 	void (*renderCancel)(void* uptr);
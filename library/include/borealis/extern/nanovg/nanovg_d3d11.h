@@ -785,6 +785,37 @@ static int D3Dnvg__renderUpdateTexture(void* uptr, int image, int x, int y, int
 	return 1;
 }
 
+static int D3Dnvg__renderUpdateTextureRegion(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	struct D3DNVGcontext* D3D = (struct D3DNVGcontext*)uptr;
+	struct D3DNVGtexture* tex = D3Dnvg__findTexture(D3D, image);
+	D3D11_BOX box;
+	unsigned int pixelWidthBytes;
+
+	if (tex == NULL)
+	{
+		return 0;
+	}
+
+	// The staging texture path already reads the region only
+	if (tex->flags & NVG_IMAGE_COPY_SWAP)
+	{
+		return D3Dnvg__renderUpdateTexture(uptr, image, x, y, w, h, data);
+	}
+
+	box.left = x;
+	box.right = (x + w);
+	box.top = y;
+	box.bottom = (y + h);
+	box.front = 0;
+	box.back = 1;
+
+	pixelWidthBytes = tex->type == NVG_TEXTURE_RGBA ? 4 : 1;
+
+	D3D_API_6(D3D->pDeviceContext, UpdateSubresource, (ID3D11Resource*)tex->tex, 0, &box, data, w * pixelWidthBytes, w * h * pixelWidthBytes);
+	return 1;
+}
+
 static int D3Dnvg__renderGetTextureSize(void* uptr, int image, int* w, int* h)
 {
 	struct D3DNVGcontext* D3D = (struct D3DNVGcontext*)uptr;
@@ -1523,6 +1554,7 @@ struct NVGcontext* nvgCreateD3D11(ID3D11Device* pDevice, int flags)
 	params.renderCreateTexture = D3Dnvg__renderCreateTexture;
 	params.renderDeleteTexture = D3Dnvg__renderDeleteTexture;
 	params.renderUpdateTexture = D3Dnvg__renderUpdateTexture;
+	params.renderUpdateTextureRegion = D3Dnvg__renderUpdateTextureRegion;
 	params.renderGetTextureSize = D3Dnvg__renderGetTextureSize;
 	params.renderViewport = D3Dnvg__renderViewport;
 	params.renderCancel = D3Dnvg__renderCancel;
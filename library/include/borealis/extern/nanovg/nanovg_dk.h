@@ -41,6 +41,11 @@ static int dknvg__renderUpdateTexture(void* uptr, int image, int x, int y, int w
     return dk->renderer->UpdateTexture(*dk, image, x, y, w, h, data);
 }
 
+static int dknvg__renderUpdateTextureRegion(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data) {
+    DKNVGcontext *dk = (DKNVGcontext*)uptr;
+    return dk->renderer->UpdateTextureRegion(*dk, image, x, y, w, h, data);
+}
+
 static int dknvg__renderGetTextureSize(void* uptr, int image, int* w, int* h) {
     DKNVGcontext *dk = (DKNVGcontext*)uptr;
     return dk->renderer->GetTextureSize(*dk, image, w, h);
@@ -485,6 +490,7 @@ NVGcontext* nvgCreateDk(nvg::DkRenderer *renderer, int flags) {
     params.renderCreateTexture = dknvg__renderCreateTexture;
     params.renderDeleteTexture = dknvg__renderDeleteTexture;
     params.renderUpdateTexture = dknvg__renderUpdateTexture;
+    params.renderUpdateTextureRegion = dknvg__renderUpdateTextureRegion;
     params.renderGetTextureSize = dknvg__renderGetTextureSize;
     params.renderViewport = dknvg__renderViewport;
     params.renderCancel = dknvg__renderCancel;
@@ -27,8 +27,12 @@ class DesktopFontLoader : public FontLoader
 {
   public:
     void loadFonts() override;
+
+  protected:
+    std::vector<std::string> getPreloadPaths() override;
+
   private:
-    bool loadFontsExist(NVGcontext* vg, std::vector<std::string> fontPaths, std::string fontName, std::string fallbackFont);
+    bool loadFontsExist(NVGcontext* vg, std::vector<std::string> fontPaths, std::string fontName, std::string fallbackFont, std::vector<CodepointRange> ranges = {});
 
     bool loadFont(const std::string& name, const std::string& path);
 };
@@ -41,6 +41,7 @@ class GLFWVideoContext : public VideoContext
     void beginFrame() override;
     void endFrame() override;
     void resetState() override;
+    bool makeCurrent(bool current) override;
     double getScaleFactor() override;
     void fullScreen(bool fs) override;
     int getCurrentMonitorIndex() override;
@@ -0,0 +1,88 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <borealis/core/audio.hpp>
+#include <vector>
+
+namespace brls
+{
+
+// AudioPlayer implementation mixing the sounds itself, on an SDL audio device.
+//
+// Every sound is loaded from resources/sounds/<name>.wav, or generated if the
+// file doesn't exist, and converted to the device format when the player is created.
+// play() only pushes the sound to a lock-free queue read by the audio callback, which
+// mixes up to MAX_VOICES sounds at once without allocating or locking anything.
+//
+// The audio driver can be chosen with the SDL_AUDIODRIVER environment variable,
+// "dummy" and "disk" work without any audio device.
+class SDLAudioPlayer : public AudioPlayer
+{
+  public:
+    SDLAudioPlayer();
+    ~SDLAudioPlayer();
+
+    bool load(enum Sound sound) override;
+    bool play(enum Sound sound, float pitch) override;
+
+  private:
+    static constexpr int SAMPLE_RATE       = 48000;
+    static constexpr Uint16 BUFFER_SAMPLES = 256; // about 5ms
+    static constexpr size_t MAX_VOICES     = 8;
+    static constexpr size_t QUEUE_SIZE     = 32;
+    static constexpr float VOLUME          = 0.5f;
+
+    struct PlayRequest
+    {
+        enum Sound sound;
+        float pitch;
+    };
+
+    struct Voice
+    {
+        const float* samples = nullptr; // nullptr if not playing
+        size_t length        = 0;
+        double position      = 0;
+        float step           = 1;
+    };
+
+    static void SDLCALL audioCallback(void* userdata, Uint8* stream, int length);
+
+    void loadSound(enum Sound sound);
+    void mix(float* output, size_t frames);
+    void startVoice(PlayRequest request);
+
+    SDL_AudioDeviceID device = 0;
+
+    // Mono PCM at the device sample rate, never modified once the device is started
+    std::vector<float> sounds[_SOUND_MAX];
+
+    // Written by play(), read by the audio callback
+    std::array<PlayRequest, QUEUE_SIZE> queue;
+    std::atomic<size_t> queueHead { 0 }; // next request to read
+    std::atomic<size_t> queueTail { 0 }; // next request to write
+
+    // Only used by the audio callback
+    std::array<Voice, MAX_VOICES> voices;
+};
+
+} // namespace brls
@@ -19,6 +19,7 @@
 #include <SDL2/SDL.h>
 
 #include <borealis/platforms/desktop/desktop_platform.hpp>
+#include <borealis/platforms/sdl/sdl_audio.hpp>
 #include <borealis/platforms/sdl/sdl_input.hpp>
 #include <borealis/platforms/sdl/sdl_video.hpp>
 #include <borealis/platforms/sdl/sdl_ime.hpp>
@@ -52,7 +53,7 @@ class SDLPlatform : public DesktopPlatform
     ImeManager* getImeManager() override;
     bool processEvent(SDL_Event* event);
 protected:
-    NullAudioPlayer* audioPlayer  = nullptr;
+    SDLAudioPlayer* audioPlayer   = nullptr;
     SDLVideoContext* videoContext = nullptr;
     SDLInputManager* inputManager = nullptr;
     SDLImeManager* imeManager     = nullptr;
@@ -0,0 +1,118 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/gif_decoder.hpp>
+#include <borealis/core/time.hpp>
+#include <borealis/views/image.hpp>
+#include <deque>
+
+namespace brls
+{
+
+class AnimatedImage;
+
+// Advances the frames of an AnimatedImage with the other tickings
+class AnimatedImageTicking : public Ticking
+{
+  public:
+    AnimatedImageTicking(AnimatedImage* image);
+
+  protected:
+    bool onUpdate(Time delta) override;
+
+  private:
+    AnimatedImage* image;
+};
+
+// An image playing an animated GIF, in a loop.
+//
+// Frames are decoded one after the other on the async thread, a few frames ahead
+// of the one displayed, and uploaded to the same texture when it's their time.
+// Decoding stops while the view is not drawn, for instance when
+// it's scrolled out of its frame or its activity is hidden.
+//
+// Other formats are displayed as still images, like Image.
+class AnimatedImage : public Image
+{
+  public:
+    AnimatedImage();
+    ~AnimatedImage();
+
+    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+
+    /**
+     * Same as the Image methods, for animated images.
+     */
+    void setImageFromRes(const std::string& name);
+    void setImageFromFile(const std::string& path);
+    void setImageFromMem(const unsigned char* data, int size);
+
+    void clear();
+
+    /**
+     * Resumes or pauses the animation. Default is playing.
+     */
+    void setPlaying(bool playing);
+    bool isPlaying();
+
+    static View* create();
+
+  private:
+    friend class AnimatedImageTicking;
+
+    // Decoded frames not displayed yet
+    static constexpr size_t BUFFERED_FRAMES = 3;
+
+    // GIFs are often saved with no delay to be played as fast as possible,
+    // browsers show them at 10 fps instead
+    static constexpr int MIN_FRAME_DELAY     = 20;
+    static constexpr int DEFAULT_FRAME_DELAY = 100;
+
+    struct Frame
+    {
+        std::vector<unsigned char> pixels;
+        int delay = 0;
+    };
+
+    // Shared with the decoding tasks, which only run one at a time
+    struct Stream
+    {
+        std::unique_ptr<GifDecoder> decoder;
+        AnimatedImage* owner; // nullptr once not displayed anymore
+
+        std::deque<std::shared_ptr<Frame>> frames; // ready to be displayed
+        std::vector<std::shared_ptr<Frame>> spareFrames;
+        bool decoding = false;
+    };
+
+    void play(std::unique_ptr<GifDecoder> decoder);
+    void stopStream();
+    void decodeNextFrame();
+    void showFrame(std::shared_ptr<Frame> frame);
+    bool onTick(Time delta);
+
+    std::shared_ptr<Stream> stream;
+    AnimatedImageTicking ticking;
+
+    bool playing    = true;
+    bool drawn      = false; // since the last tick
+    Time frameDelay = 0;
+    Time elapsed    = 0;
+};
+
+} // namespace brls
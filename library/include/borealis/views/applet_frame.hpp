@@ -47,6 +47,8 @@ class AppletFrame : public Box
     }
 
     void handleXMLElement(tinyxml2::XMLElement* element) override;
+    bool canAddXMLChildView() override;
+    void addXMLChildView(View* view) override;
 
     void pushContentView(View* view);
     void popContentView(std::function<void(void)> cb = [] {});
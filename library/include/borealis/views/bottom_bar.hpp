@@ -35,6 +35,7 @@ class BottomBar : public Box
   private:
     void updateText();
     std::string bottomText;
+    long lastTime = -1;
     BRLS_BIND(Box, hints, "brls/hints");
     BRLS_BIND(Label, time, "brls/hints/time");
     BRLS_BIND(View, battery, "brls/battery");
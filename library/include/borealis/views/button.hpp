@@ -149,6 +149,7 @@ class Button : public Box
 
     void onFocusGained() override;
     void onFocusLost() override;
+    void onThemeChanged() override;
 
     static View* create();
 
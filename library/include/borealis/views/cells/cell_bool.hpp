@@ -43,6 +43,8 @@ class BooleanCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
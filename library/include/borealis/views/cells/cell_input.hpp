@@ -60,6 +60,8 @@ class InputCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
@@ -71,6 +73,7 @@ class InputCell : public DetailCell
 
     Event<std::string> event;
     void updateUI();
+    void updateTextColor();
 };
 
 class InputNumericCell : public DetailCell
@@ -101,6 +104,8 @@ class InputNumericCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
@@ -41,6 +41,8 @@ class RadioCell : public RecyclerCell
     void setSelected(bool selected);
     bool getSelected();
 
+    void onThemeChanged() override;
+
     BRLS_BIND(Label, title, "brls/rediocell/title");
     BRLS_BIND(Label, subtitle, "brls/rediocell/subtitle");
     BRLS_BIND(CheckBox, checkbox, "brls/rediocell/checkbox");
@@ -17,14 +17,24 @@
 #pragma once
 
 #include <borealis/core/box.hpp>
+#include <borealis/core/timer.hpp>
 
 namespace brls
 {
 
+class Label;
+
+// Shows the logs and the memory used by the application (see MemoryTracker)
 class DebugLayer : public Box
 {
   public:
     DebugLayer();
+
+  private:
+    Label* memoryLabel;
+    RepeatingTimer memoryTimer;
+
+    void updateMemory();
 };
 
 } // namespace brls
@@ -17,6 +17,7 @@ class EditTextDialog : public Box
     void setCursor(int cursor);
     bool isTranslucent() override;
     void onLayout() override;
+    void onPositionChanged() override;
     Event<Point>* getLayoutEvent();
     Event<>* getBackspaceEvent();
     Event<>* getCancelEvent();
@@ -37,6 +37,7 @@ class HScrollingFrame : public Box
     void onChildFocusGained(View* directChild, View* focusedView) override;
     void onChildFocusLost(View* directChild, View* focusedView) override;
     void willAppear(bool resetState) override;
+    void onThemeChanged() override;
     void addView(View* view) override;
     void removeView(View* view, bool free = true) override;
     void onLayout() override;
@@ -108,7 +109,6 @@ class HScrollingFrame : public Box
     float getContentWidth();
 
     ScrollingBehavior behavior = ScrollingBehavior::NATURAL;
-    InputManager* input;
     bool naturalScrollingCanScroll = false;
     void naturalScrollingBehaviour();
     void naturalScrollingButtonProcessing(FocusDirection focusDirection, bool* repeat);
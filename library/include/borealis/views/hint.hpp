@@ -31,8 +31,11 @@ class Hint : public Box
     Hint(Action action, bool allowAButtonTouch = false);
     static std::string getKeyIcon(ControllerButton button, bool ignoreKeysSwap = false);
 
+    void onThemeChanged() override;
+
   private:
     Action action;
+    bool disabled = false;
 
     BRLS_BIND(Label, icon, "icon");
     BRLS_BIND(Label, hint, "hint");
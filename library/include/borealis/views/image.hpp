@@ -55,10 +55,23 @@ enum class ImageAlignment
     CENTER,
 };
 
+// What resolution to decode the image at, see Image::setDecodeQuality()
+enum class ImageDecodeQuality
+{
+    // Decoded at the resolution of the file
+    ORIGINAL,
+    // Downscaled to the displayed size with a box filter
+    FAST,
+    // Downscaled to the displayed size with a Lanczos filter, sharper but slower
+    HIGH,
+};
+
 // An image. The view will try to grow as much
 // as possible to fit the image. The scaling type dictates
 // what to do with the image if there is not enough or too much space
 // for the view compared to the image inside.
+// Small images loaded from files or resources are packed into the SpriteAtlas
+// and drawn from their atlas page.
 // Supported formats are: JPG, PNG, TGA, BMP and GIF (not animated).
 class Image : public View
 {
@@ -81,6 +94,41 @@ class Image : public View
      */
     void setInterpolation(ImageInterpolation interpolation);
 
+    /**
+     * Sets how the image is decoded. Default is FAST.
+     *
+     * Unless ORIGINAL, images bigger than their displayed size are downscaled on the CPU
+     * before being uploaded, which saves texture memory and looks better than
+     * minifying them on the GPU. The displayed size is the decode size if set, otherwise
+     * the size of the view if known when the image is set (fixed size in the style
+     * or view already laid out). Images are never upscaled, and the layout always uses
+     * the dimensions of the file.
+     *
+     * Images set from a file or a resource are decoded again if the view later
+     * grows bigger than their texture.
+     *
+     * Like the interpolation, this only takes effect after (re) loading the image.
+     */
+    void setDecodeQuality(ImageDecodeQuality quality);
+    ImageDecodeQuality getDecodeQuality();
+
+    /**
+     * Sets the size the image is going to be displayed at, to downscale it to
+     * when decoding instead of the size of the view. Set to 0 to use the size of the view again.
+     *
+     * Like the interpolation, this only takes effect after (re) loading the image.
+     */
+    void setDecodeSize(float width, float height);
+
+    /**
+     * Generates mipmaps for the image texture, so that it is still
+     * smooth when drawn smaller than its size, for instance when animating
+     * its scale. Default is false.
+     *
+     * Like the interpolation, this only takes effect after (re) loading the image.
+     */
+    void setMipmaps(bool mipmaps);
+
     /**
      * Sets the image from the given resource name.
      *
@@ -135,7 +183,26 @@ class Image : public View
     void setFreeTexture(bool value);
     bool getFreeTexture();
 
+    /**
+     * Returns true if the current texture is deleted with the image,
+     * false if it belongs to the TextureCache or if there is none.
+     */
+    bool ownsTexture();
+
+    /**
+     * Returns the texture of the image. For images packed into the SpriteAtlas,
+     * a texture holding only the image is created on the first call and kept
+     * until the image changes.
+     */
     int getTexture();
+
+    /**
+     * Returns true if an image is loaded, without creating a texture for atlas sprites.
+     */
+    bool hasTexture();
+
+    int getTextureWidth();
+    int getTextureHeight();
     float getOriginalImageWidth();
     float getOriginalImageHeight();
 
@@ -145,14 +212,36 @@ class Image : public View
     ImageScalingType scalingType     = ImageScalingType::FIT;
     ImageAlignment align             = ImageAlignment::CENTER;
     ImageInterpolation interpolation = ImageInterpolation::LINEAR;
+    ImageDecodeQuality decodeQuality = ImageDecodeQuality::FAST;
 
     int texture = 0;
+    int sprite  = 0; // SpriteAtlas handle, 0 if the texture is not an atlas page
+
+    int spriteTexture = 0; // copy of the sprite returned by getTexture(), 0 if not created
 
     NVGpaint paint;
 
     void invalidateImageBounds();
+    void freeSpriteTexture();
     int getImageFlags();
-    size_t checkCache(const std::string& path);
+    size_t checkCache(const std::string& path, int sourceWidth = 0, int sourceHeight = 0);
+
+    /**
+     * Decodes the image from the given data at the decode size.
+     * The texture is cached with the given key if not empty.
+     */
+    void loadImage(const std::string& cacheKey, const unsigned char* data, int size);
+
+    /**
+     * Returns the size to decode an image of the given dimensions at.
+     */
+    void getDecodeSize(int sourceWidth, int sourceHeight, int* width, int* height);
+
+    /**
+     * Same as innerSetImage(), but keeps the given dimensions for the layout
+     * if the texture is a downscaled version of the image.
+     */
+    void setTexture(int texture, int sourceWidth, int sourceHeight);
 
     float originalImageWidth  = 0;
     float originalImageHeight = 0;
@@ -163,6 +252,22 @@ class Image : public View
     float imageWidth  = 0;
 
     bool freeTexture = true;
+
+    float decodeWidth  = 0;
+    float decodeHeight = 0;
+    bool mipmaps       = false;
+
+    int textureWidth  = 0;
+    int textureHeight = 0;
+
+    // Dimensions and sprite of the image being set by setTexture(), 0 if the same as the texture
+    int sourceWidth  = 0;
+    int sourceHeight = 0;
+    int nextSprite   = 0;
+
+    // Path of the image to decode again when the view grows, if it was set from a file
+    std::string sourcePath;
+    bool reloadPending = false;
 };
 
 } // namespace brls
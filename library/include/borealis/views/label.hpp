@@ -69,12 +69,22 @@ class Label : public View
     void onFocusLost() override;
     void onParentFocusGained(View* focusedView) override;
     void onParentFocusLost(View* focusedView) override;
+    void onThemeChanged() override;
 
     /**
      * Sets the text of the label.
+     * Setting the same text again does nothing, and a label of fixed size
+     * is not laid out again when its text changes.
      */
     virtual void setText(const std::string& text);
 
+    /**
+     * Sets the text of the label once it has been converted to traditional Chinese,
+     * on a background thread if it's longer than ASYNC_CONVERSION_LENGTH bytes.
+     * The previous text stays until then. Same as setText() when there is nothing to convert.
+     */
+    void setTextAsync(const std::string& text);
+
     /**
      * Sets the alignment of the text inside
      * the view. Will not move the view, only
@@ -145,11 +155,21 @@ class Label : public View
     void setIsWrapping(bool isWrapping);
 
     /**
-     * Simplified Chinese to Traditional Chinese
+     * Used by the measure function: bounds of the text on a single line, and height
+     * of the text wrapped to the given width. Kept until the text or the font changes,
+     * so that laying the label out again with other constraints doesn't measure it again.
+     */
+    void getTextBounds(float* bounds);
+    float getWrappedTextHeight(float width);
+
+    /**
+     * Simplified Chinese to Traditional Chinese.
+     * The last conversions are kept in memory, can be called from any thread.
      */
     static std::string STConverter(const std::string& text);
 
-    static inline bool OPENCC_ON = true;
+    static inline bool OPENCC_ON                 = true;
+    static inline size_t ASYNC_CONVERSION_LENGTH = 1024;
     void setCursor(int cursor);
 
   protected:
@@ -162,10 +182,17 @@ class Label : public View
     float fontQuality;
 
     NVGcolor textColor;
+    bool defaultTextColor = true; // follows the theme text color
 
     float requiredWidth    = 0;
     unsigned ellipsisWidth = 0;
     size_t stringLength    = 0;
+    size_t textRequest     = 0; // incremented by every new text, to drop the outdated async conversions
+
+    bool textBoundsValid = false;
+    float textBounds[4]  = {};
+    float wrappedWidth   = NAN;
+    float wrappedHeight  = 0;
 
     bool singleLine = false;
     bool isWrapping = false;
@@ -185,6 +212,9 @@ class Label : public View
     void startScrollTimer();
     void onScrollTimerFinished();
 
+    void applyText(const std::string& text);
+    bool hasFixedSize();
+
     HorizontalAlign horizontalAlign = HorizontalAlign::LEFT;
     VerticalAlign verticalAlign     = VerticalAlign::CENTER;
 
@@ -49,6 +49,7 @@ class ScrollingFrame : public Box
     void onChildFocusGained(View* directChild, View* focusedView) override;
     void onChildFocusLost(View* directChild, View* focusedView) override;
     void willAppear(bool resetState) override;
+    void onThemeChanged() override;
     void addView(View* view) override;
     void removeView(View* view, bool free = true) override;
     void onLayout() override;
@@ -120,7 +121,6 @@ class ScrollingFrame : public Box
     float getContentHeight();
 
     ScrollingBehavior behavior = ScrollingBehavior::NATURAL;
-    InputManager* input;
     bool naturalScrollingCanScroll = false;
     void naturalScrollingBehaviour();
     void naturalScrollingButtonProcessing(FocusDirection focusDirection, bool* repeat);
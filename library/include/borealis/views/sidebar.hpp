@@ -63,6 +63,8 @@ class SidebarItem : public Box
 
     GenericEvent* getActiveEvent();
 
+    void onThemeChanged() override;
+
   private:
     BRLS_BIND(Rectangle, accent, "brls/sidebar/item_accent");
     BRLS_BIND(Label, label, "brls/sidebar/item_label");
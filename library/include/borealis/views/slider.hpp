@@ -34,6 +34,7 @@ class Slider : public Box
     void onLayout() override;
     View* getDefaultFocus() override;
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void onThemeChanged() override;
 
     void setProgress(float progress);
 
@@ -53,7 +54,6 @@ class Slider : public Box
     Rectangle* getPointer() { return pointer; }
 
   private:
-    InputManager* input;
     Rectangle* line;
     Rectangle* lineEmpty;
     Rectangle* pointer;
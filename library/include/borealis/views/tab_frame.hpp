@@ -36,6 +36,9 @@ class TabFrame : public Box
 
     void handleXMLElement(tinyxml2::XMLElement* element) override;
 
+    // Tabs are instantiated lazily, from handleXMLElement() only
+    bool canAddXMLChildView() override;
+
     void addTab(std::string label, TabViewCreator creator);
     void focusTab(int position);
     void clearTabs();
@@ -18,6 +18,7 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/system_status.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -28,8 +29,10 @@ class BatteryWidget : public Box
 {
   public:
     BatteryWidget();
+    ~BatteryWidget() override;
+
+    void onThemeChanged() override;
 
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     static View* create();
 
   private:
@@ -40,9 +43,12 @@ class BatteryWidget : public Box
     void applyBackTheme(ThemeVariant theme);
     void applyLevelTheme(ThemeVariant theme);
 
-    void updateState();
-    inline static bool isBatteryCharging = false;
-    inline static float batteryLevel     = 1;
+    SystemStatusEvent::Subscription statusSubscription;
+    bool subscribed = false;
+
+    void applyStatus(const SystemStatus& status);
+    bool isBatteryCharging = false;
+    float batteryLevel     = 1;
 };
 
 } // namespace brls
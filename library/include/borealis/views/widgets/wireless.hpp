@@ -18,6 +18,7 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/system_status.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -28,8 +29,10 @@ class WirelessWidget : public Box
 {
   public:
     WirelessWidget();
+    ~WirelessWidget() override;
+
+    void onThemeChanged() override;
 
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     static View* create();
 
   private:
@@ -42,10 +45,10 @@ class WirelessWidget : public Box
 
     void applyTheme(ThemeVariant theme);
 
-    void updateState();
-    inline static bool hasWirelessConnection = false;
-    inline static int wifiLevel              = 3;
-    inline static bool hasEthernetConnection = false;
+    SystemStatusEvent::Subscription statusSubscription;
+    bool subscribed = false;
+
+    void applyStatus(const SystemStatus& status);
 };
 
 } // namespace brls
@@ -16,7 +16,9 @@
 
 #include <borealis/core/activity.hpp>
 #include <borealis/core/application.hpp>
+#include <borealis/core/box.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/views/progress_spinner.hpp>
 
 using namespace brls::literals;
 
@@ -61,6 +63,15 @@ View* Activity::createContentView()
     return constructorView;
 }
 
+View* Activity::createPlaceholderView()
+{
+    Box* placeholder = new Box(Axis::COLUMN);
+    placeholder->setJustifyContent(JustifyContent::CENTER);
+    placeholder->setAlignItems(AlignItems::CENTER);
+    placeholder->addView(new ProgressSpinner(ProgressSpinnerSize::LARGE));
+    return placeholder;
+}
+
 float Activity::getShowAnimationDuration(TransitionAnimation animation)
 {
     return contentView->getShowAnimationDuration(animation);
@@ -71,6 +82,12 @@ void Activity::onWindowSizeChanged()
     this->resizeToFitWindow();
 }
 
+void Activity::onThemeChanged()
+{
+    if (this->contentView)
+        this->contentView->onThemeChanged();
+}
+
 bool Activity::isTranslucent()
 {
     if (!this->contentView)
@@ -168,6 +185,8 @@ View* Activity::getView(std::string id)
 
 Activity::~Activity()
 {
+    *this->aliveToken = false;
+
     if (this->contentView)
     {
         this->contentView->willDisappear();
@@ -175,6 +194,8 @@ Activity::~Activity()
         this->contentView->freeView();
         this->contentView = nullptr;
     }
+
+    ViewPool::releaseArena(this->viewArena);
 }
 
 } // namespace brls
@@ -14,6 +14,7 @@
     limitations under the License.
 */
 
+#include <algorithm>
 #include <borealis/core/animation.hpp>
 #include <borealis/core/application.hpp>
 #include <vector>
@@ -21,14 +22,185 @@
 namespace brls
 {
 
+typedef float (*EasingCurve)(float);
+
+#define EASING_CURVE(name) [](float t) { return tweeny::easing::name.run(t, 0.0f, 1.0f); }
+
+// Easing functions normalized to [0, 1], in the order of EasingFunction
+static const EasingCurve EASING_CURVES[] = {
+    EASING_CURVE(linear), // def is linear for floats
+    EASING_CURVE(linear),
+    EASING_CURVE(stepped),
+    EASING_CURVE(quadraticIn),
+    EASING_CURVE(quadraticOut),
+    EASING_CURVE(quadraticInOut),
+    EASING_CURVE(cubicIn),
+    EASING_CURVE(cubicOut),
+    EASING_CURVE(cubicInOut),
+    EASING_CURVE(quarticIn),
+    EASING_CURVE(quarticOut),
+    EASING_CURVE(quarticInOut),
+    EASING_CURVE(quinticIn),
+    EASING_CURVE(quinticOut),
+    EASING_CURVE(quinticInOut),
+    EASING_CURVE(sinusoidalIn),
+    EASING_CURVE(sinusoidalOut),
+    EASING_CURVE(sinusoidalInOut),
+    EASING_CURVE(exponentialIn),
+    EASING_CURVE(exponentialOut),
+    EASING_CURVE(exponentialInOut),
+    EASING_CURVE(circularIn),
+    EASING_CURVE(circularOut),
+    EASING_CURVE(circularInOut),
+    EASING_CURVE(bounceIn),
+    EASING_CURVE(bounceOut),
+    EASING_CURVE(bounceInOut),
+    EASING_CURVE(elasticIn),
+    EASING_CURVE(elasticOut),
+    EASING_CURVE(elasticInOut),
+    EASING_CURVE(backIn),
+    EASING_CURVE(backOut),
+    EASING_CURVE(backInOut),
+};
+
+static_assert(sizeof(EASING_CURVES) / sizeof(EasingCurve) == (size_t)EasingFunction::backInOut + 1, "EASING_CURVES must match EasingFunction");
+
+static float evaluate(EasingFunction easing, float from, float to, float progress)
+{
+    return from + (to - from) * EASING_CURVES[(size_t)easing](progress);
+}
+
+// Interpolated values of the tracks, reused every update
+static std::vector<float> trackValues;
+
+void AnimationSystem::update(Time now)
+{
+    static Time previousTime = 0;
+
+    double delta = previousTime == 0 ? 0 : (double)(now - previousTime);
+    previousTime = now;
+
+    AnimationSystem::currentUpdate++;
+
+    size_t count = AnimationSystem::owners.size();
+    if (count == 0)
+        return;
+
+    double* elapsed         = AnimationSystem::elapsed.data();
+    const double* durations = AnimationSystem::durations.data();
+    const float* fromValues = AnimationSystem::fromValues.data();
+    const float* toValues   = AnimationSystem::toValues.data();
+    float* progress         = AnimationSystem::progress.data();
+
+    trackValues.resize(count);
+    float* values = trackValues.data();
+
+    // Advance all tracks
+    for (size_t i = 0; i < count; i++)
+    {
+        elapsed[i] += delta;
+        progress[i] = durations[i] > 0 ? (float)std::min(elapsed[i] / durations[i], 1.0) : 1.0f;
+    }
+
+    // Ease
+    for (size_t i = 0; i < count; i++)
+        values[i] = EASING_CURVES[(size_t)AnimationSystem::easings[i]](progress[i]);
+
+    // Interpolate
+    for (size_t i = 0; i < count; i++)
+        values[i] = fromValues[i] + (toValues[i] - fromValues[i]) * values[i];
+
+    for (size_t i = 0; i < count; i++)
+        AnimationSystem::owners[i]->currentValue = values[i];
+
+    // Call back the animatables having a tick callback or at the end of their step
+    // Callbacks can start, stop or delete any animatable: tracks added during the loop are
+    // already marked as updated, and a track moved to an index already visited waits for the next update
+    for (size_t i = 0; i < AnimationSystem::owners.size();)
+    {
+        if (AnimationSystem::updates[i] == AnimationSystem::currentUpdate)
+        {
+            i++;
+            continue;
+        }
+
+        AnimationSystem::updates[i] = AnimationSystem::currentUpdate;
+
+        Animatable* animatable = AnimationSystem::owners[i];
+
+        if (AnimationSystem::progress[i] >= 1.0f)
+            animatable->onStepEnd();
+        else
+            animatable->tick();
+    }
+}
+
+size_t AnimationSystem::getActiveTracks()
+{
+    return AnimationSystem::owners.size();
+}
+
+size_t AnimationSystem::addTrack(Animatable* owner)
+{
+    AnimationSystem::owners.push_back(owner);
+    AnimationSystem::fromValues.push_back(owner->currentValue);
+    AnimationSystem::toValues.push_back(owner->currentValue);
+    AnimationSystem::elapsed.push_back(0);
+    AnimationSystem::durations.push_back(0);
+    AnimationSystem::easings.push_back(EasingFunction::linear);
+    AnimationSystem::progress.push_back(0.0f);
+    AnimationSystem::updates.push_back(AnimationSystem::currentUpdate);
+
+    return AnimationSystem::owners.size() - 1;
+}
+
+void AnimationSystem::removeTrack(size_t track)
+{
+    size_t last = AnimationSystem::owners.size() - 1;
+
+    if (track != last)
+    {
+        AnimationSystem::owners[track]     = AnimationSystem::owners[last];
+        AnimationSystem::fromValues[track] = AnimationSystem::fromValues[last];
+        AnimationSystem::toValues[track]   = AnimationSystem::toValues[last];
+        AnimationSystem::elapsed[track]    = AnimationSystem::elapsed[last];
+        AnimationSystem::durations[track]  = AnimationSystem::durations[last];
+        AnimationSystem::easings[track]    = AnimationSystem::easings[last];
+        AnimationSystem::progress[track]   = AnimationSystem::progress[last];
+        AnimationSystem::updates[track]    = AnimationSystem::updates[last];
+
+        AnimationSystem::owners[track]->track = track;
+    }
+
+    AnimationSystem::owners.pop_back();
+    AnimationSystem::fromValues.pop_back();
+    AnimationSystem::toValues.pop_back();
+    AnimationSystem::elapsed.pop_back();
+    AnimationSystem::durations.pop_back();
+    AnimationSystem::easings.pop_back();
+    AnimationSystem::progress.pop_back();
+    AnimationSystem::updates.pop_back();
+}
+
 Animatable::Animatable(float value)
     : currentValue(value)
+    , initialValue(value)
+{
+}
+
+Animatable::~Animatable()
 {
+    // Must be stopped before Ticking destructor, for unschedule() to remove the track
+    this->stop();
 }
 
 void Animatable::onReset()
 {
-    this->tween = tweeny::tween<float>::from(this->currentValue);
+    this->initialValue  = this->currentValue;
+    this->currentStep   = 0;
+    this->stepElapsed   = 0;
+    this->totalDuration = 0;
+    this->steps.clear();
 }
 
 void Animatable::reset(float initialValue)
@@ -44,28 +216,119 @@ void Animatable::reset()
 
 void Animatable::onRewind()
 {
-    this->currentValue = this->tween.seek(0);
+    this->currentValue = this->initialValue;
+    this->currentStep  = 0;
+    this->stepElapsed  = 0;
+
+    if (this->isRunning() && !this->steps.empty())
+    {
+        this->loadStep();
+        AnimationSystem::elapsed[this->track] = 0;
+    }
 }
 
 void Animatable::addStep(float targetValue, int32_t duration, EasingFunction easing)
 {
-    this->tween.to(targetValue).during(duration).via(easing);
+    this->steps.push_back({ targetValue, (Time)duration * 1000, easing });
+    this->totalDuration += (Time)duration * 1000;
+
+    // Running without anything left to animate, start the new step now
+    if (this->isRunning() && this->currentStep == this->steps.size() - 1)
+    {
+        this->loadStep();
+        AnimationSystem::elapsed[this->track] = 0;
+    }
 }
 
 float Animatable::getProgress()
 {
-    return this->tween.progress();
+    if (this->totalDuration <= 0)
+        return 0.0f;
+
+    if (this->currentStep >= this->steps.size())
+        return 1.0f;
+
+    Time elapsed = this->isRunning() ? (Time)AnimationSystem::elapsed[this->track] : this->stepElapsed;
+    elapsed      = std::min(elapsed, this->steps[this->currentStep].duration);
+
+    for (size_t i = 0; i < this->currentStep; i++)
+        elapsed += this->steps[i].duration;
+
+    return (float)elapsed / (float)this->totalDuration;
+}
+
+bool Animatable::onUpdate(Time delta)
+{
+    // Never called, running animatables are updated by AnimationSystem
+    return this->isRunning();
+}
+
+void Animatable::schedule()
+{
+    this->track = AnimationSystem::addTrack(this);
+
+    // Nothing to animate: the track ends at the next update without changing the value
+    if (this->totalDuration <= 0 || this->currentStep >= this->steps.size())
+        return;
+
+    this->loadStep();
+    AnimationSystem::elapsed[this->track] = (double)this->stepElapsed;
+}
+
+void Animatable::unschedule()
+{
+    if (this->currentStep < this->steps.size())
+        this->stepElapsed = (Time)AnimationSystem::elapsed[this->track];
+
+    AnimationSystem::removeTrack(this->track);
+}
+
+void Animatable::loadStep()
+{
+    const Step& step = this->steps[this->currentStep];
+
+    AnimationSystem::fromValues[this->track] = this->currentStep == 0 ? this->initialValue : this->steps[this->currentStep - 1].target;
+    AnimationSystem::toValues[this->track]   = step.target;
+    AnimationSystem::durations[this->track]  = (double)step.duration;
+    AnimationSystem::easings[this->track]    = step.easing;
 }
 
-bool Animatable::onUpdate(retro_time_t delta)
+void Animatable::onStepEnd()
 {
-    if (this->tween.progress() >= 1.0f || this->tween.duration() <= 0)
-        return false;
-    
-    // int32_t for stepping works as long as the app goes faster than 0.00001396983 FPS
-    // (in which case the delta for a frame wraps in an int32_t)
-    this->currentValue = this->tween.step((int32_t)delta);
-    return true;
+    if (this->totalDuration <= 0 || this->currentStep >= this->steps.size())
+    {
+        this->tick();
+        this->stop(true);
+        return;
+    }
+
+    // Carry the time elapsed after the end of the step over to the next ones
+    double overshoot   = AnimationSystem::elapsed[this->track] - AnimationSystem::durations[this->track];
+    this->currentValue = this->steps[this->currentStep].target;
+
+    while (++this->currentStep < this->steps.size())
+    {
+        const Step& step = this->steps[this->currentStep];
+
+        if ((double)step.duration > overshoot)
+        {
+            this->loadStep();
+            AnimationSystem::elapsed[this->track] = overshoot;
+
+            float progress     = (float)(overshoot / (double)step.duration);
+            this->currentValue = evaluate(step.easing, AnimationSystem::fromValues[this->track], step.target, progress);
+
+            this->tick();
+            return;
+        }
+
+        overshoot -= (double)step.duration;
+        this->currentValue = step.target;
+    }
+
+    this->stepElapsed = 0;
+    this->tick();
+    this->stop(true);
 }
 
 float Animatable::getValue()
@@ -104,7 +367,7 @@ void updateHighlightAnimation()
     if (!Application::hasActiveEvent())
         return;
 
-    Time currentTime = getCPUTimeUsec() / 1000;
+    Time currentTime = Application::getFrameStartTime() / 1000;
 
     // Update variables
     highlightGradientX = (cos((double)currentTime / HIGHLIGHT_SPEED / 3.0) + 1.0) / 2.0;
@@ -24,10 +24,20 @@
 #include <algorithm>
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
+#include <borealis/core/frame_pacer.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/input_replay.hpp>
+#include <borealis/core/memory.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/render_pipeline.hpp>
+#include <borealis/core/shadow_cache.hpp>
+#include <borealis/core/sprite_atlas.hpp>
+#include <borealis/core/system_status.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/core/time.hpp>
+#include <borealis/core/trace.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/views/animated_image.hpp>
 #include <borealis/views/bottom_bar.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/cells/cell_bool.hpp>
@@ -67,6 +77,11 @@ namespace brls
 {
 
 bool Application::init()
+{
+    return Application::init(Platform::createPlatform());
+}
+
+bool Application::init(Platform* platform)
 {
     Application::inited        = false;
     Application::quitRequested = false;
@@ -77,7 +92,7 @@ bool Application::init()
         Application::ORIGINAL_WINDOW_HEIGHT = 720;
 
     // Init platform
-    Application::platform = Platform::createPlatform();
+    Application::platform = platform;
 
     if (!Application::platform)
     {
@@ -87,6 +102,8 @@ bool Application::init()
 
     Logger::info("Using platform {}", platform->getName());
 
+    BRLS_TRACE_THREAD_NAME("main");
+
     // Init i18n
     loadTranslations();
 
@@ -105,6 +122,9 @@ void Application::createWindow(std::string windowTitle)
         return;
     }
 
+    // Read the font files while the window is being created
+    Application::platform->getFontLoader()->preloadFonts();
+
     if (VideoContext::sizeW == 0 || VideoContext::sizeH == 0)
     {
         // Create a window with a default size and position
@@ -140,13 +160,34 @@ void Application::createWindow(std::string windowTitle)
 
     facebook::yoga::Event::subscribe([](const YGNode& node, facebook::yoga::Event::Type eventType, facebook::yoga::Event::Data eventData)
         {
+        // Nodes can be measured and laid out several times in a pass, and their position is only
+        // known once their parent is done: the events are dispatched when the whole pass ends
+        if (eventType == facebook::yoga::Event::LayoutPassEnd)
+        {
+            View::dispatchLayoutEvents();
+            return;
+        }
+
+        // Layout work done to follow the window size, see applyPendingWindowSize()
+        if (Application::windowResizing)
+        {
+            if (eventType == facebook::yoga::Event::MeasureCallbackEnd)
+                Application::resizeMeasureCallbacks++;
+            else if (eventType == facebook::yoga::Event::NodeLayout && eventData.get<facebook::yoga::Event::NodeLayout>().layoutType == facebook::yoga::LayoutType::kMeasure)
+                Application::resizeMeasuredNodes++;
+        }
+
         View* view = (View*)node.getContext();
 
         if (!view)
             return;
 
         if (eventType == facebook::yoga::Event::NodeLayout)
-            view->onLayout(); });
+        {
+            auto layoutType = eventData.get<facebook::yoga::Event::NodeLayout>().layoutType;
+            if (layoutType == facebook::yoga::LayoutType::kLayout || layoutType == facebook::yoga::LayoutType::kCachedLayout)
+                View::queueLayoutEvent(view);
+        } });
 
     // Load fonts and setup fallbacks
     Application::platform->getFontLoader()->loadFonts();
@@ -164,38 +205,59 @@ bool Application::mainLoop()
 
 bool Application::internalMainLoop()
 {
+    BRLS_TRACE_SCOPE("frame");
+
     Application::updateFPS();
-    Application::frameStartTime = getCPUTimeUsec();
+    Time now = getCPUTimeUsec();
+    FrameProfiler::frameStart(now);
+    InputRecorder::frameStart(now);
+    Application::frameStartTime = InputReplay::frameStart(now);
     Application::setActiveEvent(false);
 
     // Main loop callback
-    if (!Application::platform->mainLoopIteration() || Application::quitRequested)
+    bool running;
+    {
+        BRLS_TRACE_SCOPE("events");
+        running = Application::platform->mainLoopIteration();
+    }
+
+    if (!running || Application::quitRequested)
     {
         Application::getWindowShouldCloseEvent()->fire();
         Application::exit();
         return false;
     }
 
+    Application::applyPendingWindowSize();
+
     // Mouse and touch
     if (Application::blockInputsTokens == 0)
     {
+        BRLS_TRACE_SCOPE("input");
         Application::processInput();
     }
     else
     {
-        Logger::verbose("input blocked (tokens={})", Application::blockInputsTokens);
+        Logger::deferred<LogLevel::LOG_VERBOSE>("input blocked (tokens={})", Application::blockInputsTokens);
         if (!muteSounds)
             Application::getAudioPlayer()->play(Sound::SOUND_CLICK_ERROR);
     }
 
     // Animations
+    {
+        BRLS_TRACE_SCOPE("animations");
 #ifndef SIMPLE_HIGHLIGHT
-    updateHighlightAnimation();
+        updateHighlightAnimation();
 #endif
-    Ticking::updateTickings();
+        AnimationSystem::update(Application::frameStartTime);
+        Ticking::updateTickings(Application::frameStartTime);
+    }
 
     // Render
-    Application::frame();
+    {
+        BRLS_TRACE_SCOPE("render");
+        Application::frame();
+    }
 
     // Run sync functions
     Threading::performSyncTasks();
@@ -205,31 +267,38 @@ bool Application::internalMainLoop()
 
     // Free views deletion pool.
     // A view deletion might inserts other views to deletionPool
-    std::deque<View*> undeletedViews;
-    for (auto view : Application::deletionPool)
     {
-        if (!view->isPtrLocked())
+        BRLS_TRACE_SCOPE("deletion");
+        std::deque<View*> undeletedViews;
+        for (auto view : Application::deletionPool)
         {
-            delete view;
-        }
-        else
-        {
-            undeletedViews.push_back(view);
-            brls::Logger::verbose("Application: will delete view: {}", view->describe());
+            if (!view->isPtrLocked())
+            {
+                delete view;
+            }
+            else
+            {
+                undeletedViews.push_back(view);
+                if (BRLS_LOG_ENABLED(LOG_VERBOSE))
+                    brls::Logger::verbose("Application: will delete view: {}", view->describe());
+            }
         }
-    }
-    Application::deletionPool = undeletedViews;
+        Application::deletionPool = undeletedViews;
 
-    if (Application::limitedFrameTime > 0)
-    {
-        Time deltaTime = getCPUTimeUsec() - frameStartTime;
-        Time interval  = Application::limitedFrameTime - deltaTime;
-        if (interval > 0)
-        {
-            std::this_thread::sleep_for(std::chrono::microseconds(interval));
-        }
+        // Views of deleted activities should all be gone by now
+        if (Application::deletionPool.empty())
+            MemoryTracker::checkLeaks();
     }
 
+    InputReplay::frameEnd(getCPUTimeUsec());
+
+    // Wait for the next frame, the platform already waits for events while deactivated
+    BRLS_TRACE_SCOPE("pacing");
+    if (Application::hasActiveEvent())
+        FramePacer::endFrame(now);
+    else
+        FramePacer::reset();
+
     return true;
 }
 
@@ -256,12 +325,15 @@ void Application::processInput()
     std::vector<RawTouchState> rawTouch;
     RawMouseState rawMouse;
 
-    InputManager* inputManager = Application::platform->getInputManager();
+    InputManager* inputManager = Application::getInputManager();
     inputManager->runloopStart();
     inputManager->updateTouchStates(&rawTouch);
     inputManager->updateMouseStates(&rawMouse);
     inputManager->updateUnifiedControllerState(&controllerState);
 
+    if (InputRecorder::isRecording())
+        InputRecorder::recordInput(controllerState, rawTouch, rawMouse, inputManager->getKeyboardKeyState(BRLS_KBD_KEY_ESCAPE));
+
     if (isSwapInputKeys())
     {
         bool swapKeys[ControllerButton::_BUTTON_MAX];
@@ -272,6 +344,14 @@ void Application::processInput()
             controllerState.buttons[i] = swapKeys[i];
     }
 
+#ifdef BRLS_TRACE
+    // Both sticks pressed: dump the trace of the last frames
+    bool traceCombo    = controllerState.buttons[BUTTON_LSB] && controllerState.buttons[BUTTON_RSB];
+    bool oldTraceCombo = oldControllerState.buttons[BUTTON_LSB] && oldControllerState.buttons[BUTTON_RSB];
+    if (traceCombo && !oldTraceCombo)
+        Tracer::dump();
+#endif
+
     std::vector<TouchState> touchState;
     for (auto& i : rawTouch)
     {
@@ -374,7 +454,7 @@ void Application::processInput()
 
     // Trigger controller events
     bool repeating                  = false;
-    Time cpuTime = getCPUTimeUsec();
+    Time cpuTime = Application::frameStartTime;
 
     controllerState.buttons[BUTTON_B] |= inputManager->getKeyboardKeyState(BRLS_KBD_KEY_ESCAPE);
 
@@ -405,6 +485,14 @@ Platform* Application::getPlatform()
     return Application::platform;
 }
 
+InputManager* Application::getInputManager()
+{
+    if (InputReplay::isRunning())
+        return InputReplay::getInputManager();
+
+    return Application::platform->getInputManager();
+}
+
 AudioPlayer* Application::getAudioPlayer()
 {
     return Application::platform->getAudioPlayer();
@@ -564,7 +652,7 @@ void Application::setActiveEvent(bool value)
     Application::activeEvent = value;
     if (value)
     {
-        lastActiveTime = getCPUTimeUsec();
+        lastActiveTime = getUITimeUsec();
     }
 #endif
 }
@@ -645,18 +733,21 @@ void Application::frame()
 {
     VideoContext* videoContext = Application::platform->getVideoContext();
 
+    // Theme variant, resolved once for the whole frame
+    Application::updateTheme();
+
     // Frame context
     FrameContext frameContext = FrameContext();
 
     frameContext.pixelRatio = (float)Application::windowWidth / (float)Application::windowHeight;
     frameContext.vg         = Application::getNVGContext();
     frameContext.fontStash  = &Application::fontStash;
-    frameContext.theme      = Application::getTheme();
+    frameContext.theme      = Application::currentTheme;
 
     // Begin frame and clear
-    NVGcolor backgroundColor = frameContext.theme["brls/clear"];
-    videoContext->beginFrame();
-    videoContext->clear(backgroundColor);
+    static ThemeColor clearColor = Theme::color("brls/clear");
+    NVGcolor backgroundColor     = frameContext.theme[clearColor];
+    RenderPipeline::beginFrame(videoContext, backgroundColor);
     float scaleFactor = videoContext->getScaleFactor();
 
     nvgBeginFrame(frameContext.vg, Application::windowWidth, Application::windowHeight, scaleFactor);
@@ -691,13 +782,19 @@ void Application::frame()
 
     if (isDrawCursor())
     {
-        getPlatform()->getInputManager()->drawCursor(frameContext.vg);
+        Application::getInputManager()->drawCursor(frameContext.vg);
     }
 
     if (debuggingViewEnabled)
     {
         if (!debugLayer)
+        {
+            // Not part of the current activity, which could be deleted before it
+            ViewArena* arena = ViewPool::getCurrentArena();
+            ViewPool::setCurrentArena(nullptr);
             debugLayer = new DebugLayer();
+            ViewPool::setCurrentArena(arena);
+        }
 
         debugLayer->frame(&frameContext);
     }
@@ -706,7 +803,11 @@ void Application::frame()
     nvgResetTransform(Application::getNVGContext()); // scale
     nvgEndFrame(Application::getNVGContext());
 
-    Application::platform->getVideoContext()->endFrame();
+    // Only now that the frame has been flushed
+    SpriteAtlas::endFrame(Application::getNVGContext());
+    ShadowCache::endFrame(Application::getNVGContext());
+
+    RenderPipeline::endFrame(videoContext);
 }
 
 void Application::exit()
@@ -715,6 +816,9 @@ void Application::exit()
     exitEvent.fire();
     Logger::info("Exiting...");
 
+    // Everything left is freed on the UI thread
+    RenderPipeline::stop();
+
     Application::clear();
 
     // Free views deletion pool
@@ -723,6 +827,7 @@ void Application::exit()
 
     Application::deletionPool.clear();
 
+    SystemStatusService::stop();
     Threading::stop();
 
     exitDoneEvent.fire();
@@ -761,7 +866,7 @@ size_t Application::getFPS()
 
 void Application::setLimitedFPS(size_t fps)
 {
-    Application::limitedFrameTime = fps == 0 ? 0 : 1000000.0f / fps;
+    FramePacer::setTargetFrameTime(fps == 0 ? 0 : 1000000 / fps);
 }
 
 void Application::notify(std::string text)
@@ -785,7 +890,8 @@ void Application::giveFocus(View* view)
         if (newFocus)
         {
             newFocus->onFocusGained();
-            Logger::debug("Giving focus to {}", newFocus->describe());
+            if (BRLS_LOG_ENABLED(LOG_DEBUG))
+                Logger::debug("Giving focus to {}", newFocus->describe());
         }
 
         Application::globalHintsUpdateEvent.fire();
@@ -806,11 +912,26 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
 
     bool fade = animation == TransitionAnimation::FADE;
 
-    Activity* toShow = nullptr;
+    Activity* toShow    = nullptr;
+    bool contentPending = false;
     // Animate the old activity immediately
     if (Application::activitiesStack.size() > 1)
     {
         toShow = Application::activitiesStack[Application::activitiesStack.size() - 2];
+
+        // Its async content became available while it was covered, see setActivityContentAsync()
+        auto pending = std::find(Application::pendingContentActivities.begin(), Application::pendingContentActivities.end(), toShow);
+        if (pending != Application::pendingContentActivities.end())
+        {
+            Application::pendingContentActivities.erase(pending);
+            contentPending = true;
+
+            if (Application::globalQuitEnabled)
+                Application::gloablQuitIdentifier = toShow->registerExitAction();
+
+            toShow->willAppear(true);
+        }
+
         toShow->hide([]() {}, false, 0);
         toShow->onResume();
         toShow->show([]() {}, false, 0);
@@ -821,9 +942,15 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
     {
         View* newFocus = Application::focusStack[Application::focusStack.size() - 1];
 
-        if (!toShow || newFocus->getParentActivity() == toShow)
+        // The focus saved when it was covered belonged to the placeholder
+        if (contentPending)
+        {
+            Application::giveFocus(toShow->getDefaultFocus());
+        }
+        else if (!toShow || newFocus->getParentActivity() == toShow)
         {
-            Logger::debug("Giving focus to {}, and removing it from the focus stack", newFocus->describe());
+            if (BRLS_LOG_ENABLED(LOG_DEBUG))
+                Logger::debug("Giving focus to {}, and removing it from the focus stack", newFocus->describe());
             Application::giveFocus(newFocus);
         }
         else if (toShow)
@@ -844,6 +971,10 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
                 break;
             }
         }
+        auto pending = std::find(pendingContentActivities.begin(), pendingContentActivities.end(), last);
+        if (pending != pendingContentActivities.end())
+            pendingContentActivities.erase(pending);
+        ViewPool::setCurrentArena(activitiesStack.empty() ? nullptr : activitiesStack.back()->getViewArena());
         cb();
         brls::Logger::debug("Start delete top activity");
         if(free) delete last;
@@ -861,20 +992,36 @@ std::vector<Activity*> Application::getActivitiesStack()
 }
 
 void Application::pushActivity(Activity* activity, TransitionAnimation animation)
+{
+    Application::pushActivity(activity, animation, true);
+}
+
+void Application::pushActivity(Activity* activity, TransitionAnimation animation, bool createContent)
 {
     Application::blockInputs();
 
     // Focus
     if (!Application::activitiesStack.empty() && Application::currentFocus != nullptr)
     {
-        Logger::debug("Pushing {} to the focus stack", Application::currentFocus->describe());
+        if (BRLS_LOG_ENABLED(LOG_DEBUG))
+            Logger::debug("Pushing {} to the focus stack", Application::currentFocus->describe());
         Application::focusStack.push_back(Application::currentFocus);
     }
 
+    // Views created from now on belong to the new activity
+    ViewPool::setCurrentArena(activity->getViewArena());
+
     // Create the activity content view
-    activity->setContentView(activity->createContentView());
-    activity->onContentAvailable();
-    activity->resizeToFitWindow();
+    if (createContent)
+    {
+        activity->setContentView(activity->createContentView());
+        activity->onContentAvailable();
+        activity->resizeToFitWindow();
+    }
+    else
+    {
+        activity->setContentView(activity->createPlaceholderView());
+    }
 
     if (!Application::activitiesStack.empty())
     {
@@ -910,6 +1057,190 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
     }
 }
 
+void Application::pushActivityAsync(Activity* activity, TransitionAnimation animation)
+{
+    Time startTime = getCPUTimeUsec();
+
+    // Inputs stay blocked until the real content is available
+    Application::blockInputs(true);
+
+    // Push the activity with its placeholder right away so that the transition starts this frame
+    Application::pushActivity(activity, animation, false);
+
+    std::shared_ptr<bool> alive   = activity->getAliveToken();
+    std::function<void()> prepare = [activity, alive, startTime]()
+    {
+        tinyxml2::XMLDocument* document = nullptr;
+
+        try
+        {
+            document = activity->loadContentDocument();
+            activity->onPrepareContent();
+        }
+        catch (const std::exception& e)
+        {
+            Logger::error("pushActivityAsync: cannot prepare activity content: {}", e.what());
+        }
+
+        brls::sync([activity, alive, document, startTime]()
+            {
+            if (!*alive)
+            {
+                // The activity was popped before its content was ready
+                delete document;
+                Application::unblockInputs();
+                return;
+            }
+
+            // Views created from now on belong to the activity, whatever is on top of the stack
+            ViewArena* previousArena = ViewPool::getCurrentArena();
+            ViewPool::setCurrentArena(activity->getViewArena());
+
+            // No XML document: fallback to the synchronous content creation
+            if (!document)
+            {
+                View* content = activity->createContentView();
+                ViewPool::setCurrentArena(previousArena);
+                Application::setActivityContentAsync(activity, content, startTime);
+                return;
+            }
+
+            tinyxml2::XMLElement* element = document->RootElement();
+            View* root                    = View::createFromXMLElementShallow(element);
+            ViewPool::setCurrentArena(previousArena);
+
+            Application::inflateActivityAsync(activity, alive, document, { { root, element->FirstChildElement(), 0 } }, startTime); });
+    };
+
+    // Worker threads would make the content ready on a different frame every replay
+    if (InputReplay::isRunning())
+        prepare();
+    else
+        brls::async(prepare);
+}
+
+void Application::inflateActivityAsync(Activity* activity, std::shared_ptr<bool> alive, tinyxml2::XMLDocument* document,
+    std::vector<XMLInflateFrame> stack, Time startTime)
+{
+    if (!*alive)
+    {
+        // The activity was popped before its content was ready,
+        // views of the stack are not attached to their parent yet
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+            delete it->view;
+
+        delete document;
+        Application::unblockInputs();
+        return;
+    }
+
+    // Views inflated in this slice belong to the activity, whatever is on top of the stack
+    ViewArena* previousArena = ViewPool::getCurrentArena();
+    ViewPool::setCurrentArena(activity->getViewArena());
+
+    // Handle as many XML elements as the frame budget allows,
+    // or a fixed count during replays as the time taken differs from one run to another
+    Time sliceStart = getCPUTimeUsec();
+    unsigned slice  = 0;
+    bool replay     = InputReplay::isRunning();
+
+    while (true)
+    {
+        XMLInflateFrame& frame = stack.back();
+
+        if (!frame.next)
+        {
+            if (stack.size() == 1)
+                break;
+
+            // All children XML elements are handled, give the view to its parent
+            View* view = frame.view;
+            stack.pop_back();
+            stack.back().view->addXMLChildView(view);
+            continue;
+        }
+
+        if (replay ? slice++ >= REPLAY_INFLATE_ELEMENTS : getCPUTimeUsec() - sliceStart >= Application::activityInflateBudget)
+            break;
+
+        View* parent                  = frame.view;
+        tinyxml2::XMLElement* element = frame.next;
+        unsigned max                  = parent->getMaximumAllowedXMLElements();
+
+        if (frame.count >= max)
+            fatal("View \"" + parent->describe() + "\" is only allowed to have " + std::to_string(max) + " children XML elements");
+
+        frame.next = element->NextSiblingElement();
+        frame.count++;
+
+        // Go down the tree if possible, otherwise the whole subtree is inflated now
+        if (parent->canAddXMLChildView())
+            stack.push_back({ View::createFromXMLElementShallow(element), element->FirstChildElement(), 0 });
+        else
+            parent->handleXMLElement(element);
+    }
+
+    ViewPool::setCurrentArena(previousArena);
+
+    // Continue next frame
+    if (stack.size() > 1 || stack.back().next)
+    {
+        brls::sync([activity, alive, document, stack, startTime]()
+            { Application::inflateActivityAsync(activity, alive, document, stack, startTime); });
+        return;
+    }
+
+    View* root = stack.back().view;
+    root->bindXMLDocument(document);
+    Application::setActivityContentAsync(activity, root, startTime);
+}
+
+void Application::setActivityContentAsync(Activity* activity, View* content, Time startTime)
+{
+    // Replace the placeholder
+    ViewArena* previousArena = ViewPool::getCurrentArena();
+    ViewPool::setCurrentArena(activity->getViewArena());
+
+    activity->setContentView(content);
+    activity->onContentAvailable();
+
+    ViewPool::setCurrentArena(previousArena);
+
+    if (!Application::activitiesStack.empty() && Application::activitiesStack.back() == activity)
+    {
+        if (Application::globalQuitEnabled)
+            Application::gloablQuitIdentifier = activity->registerExitAction();
+
+        activity->willAppear(true);
+        Application::giveFocus(activity->getDefaultFocus());
+
+        // Cross fade from the placeholder
+        activity->hide([]() {}, false, 0);
+        activity->show([]() {}, true, activity->getShowAnimationDuration(TransitionAnimation::FADE));
+    }
+    else
+    {
+        // Another activity was pushed in the meantime, popActivity() finishes the job
+        Application::pendingContentActivities.push_back(activity);
+    }
+
+    Application::unblockInputs();
+
+    Time timeToInteractive = getCPUTimeUsec() - startTime;
+    FrameProfiler::addSample("activity/tti", timeToInteractive);
+    Logger::debug("Activity content available in {}us", timeToInteractive);
+}
+
+void Application::setActivityInflateBudget(Time budget)
+{
+    Application::activityInflateBudget = budget;
+}
+
+Time Application::getActivityInflateBudget()
+{
+    return Application::activityInflateBudget;
+}
+
 void Application::clear()
 {
     for (Activity* activity : Application::activitiesStack)
@@ -919,19 +1250,56 @@ void Application::clear()
     }
 
     Application::activitiesStack.clear();
+    Application::pendingContentActivities.clear();
 }
 
 Theme Application::getTheme()
 {
-    if (Application::getThemeVariant() == ThemeVariant::LIGHT)
-        return Theme::getLightTheme();
-    else
-        return Theme::getDarkTheme();
+    if (!Application::currentTheme.getValues())
+        Application::updateTheme();
+
+    return Application::currentTheme;
 }
 
 ThemeVariant Application::getThemeVariant()
 {
-    return Application::platform->getThemeVariant();
+    if (!Application::currentTheme.getValues())
+        Application::updateTheme();
+
+    return Application::currentThemeVariant;
+}
+
+void Application::setThemeVariant(ThemeVariant variant)
+{
+    Application::platform->setThemeVariant(variant);
+    Application::updateTheme();
+}
+
+void Application::updateTheme()
+{
+    ThemeVariant variant = Application::platform->getThemeVariant();
+    uint64_t generation  = Theme::getGeneration();
+    bool resolved        = Application::currentTheme.getValues() != nullptr;
+
+    if (resolved && variant == Application::currentThemeVariant && generation == Application::currentThemeGeneration)
+        return;
+
+    Application::currentThemeVariant    = variant;
+    Application::currentThemeGeneration = generation;
+    Application::currentTheme           = variant == ThemeVariant::LIGHT ? Theme::getLightTheme() : Theme::getDarkTheme();
+
+    if (!resolved)
+        return;
+
+    // Only drop what was computed from the colors, the views pick the new ones up
+    Logger::info("Theme changed: {}", variant == ThemeVariant::LIGHT ? "light" : "dark");
+    ShadowCache::clear();
+
+    for (Activity* activity : Application::activitiesStack)
+        activity->onThemeChanged();
+
+    Application::themeChangedEvent.fire(variant);
+    Application::setActiveEvent(true);
 }
 
 ImeManager* Application::getImeManager()
@@ -949,7 +1317,8 @@ void Application::addToFreeQueue(View* view)
     if (std::binary_search(deletionPool.cbegin(), deletionPool.cend(), view))
         return;
     
-    brls::Logger::verbose("Application::addToFreeQueue {}", view->describe());
+    if (BRLS_LOG_ENABLED(LOG_VERBOSE))
+        brls::Logger::verbose("Application::addToFreeQueue {}", view->describe());
 
     Application::deletionPool.push_back(view);
 }
@@ -978,7 +1347,11 @@ void Application::tryDeinitFirstResponder(View* view)
 
 bool Application::loadFontFromFile(std::string fontName, std::string filePath)
 {
-    int handle = nvgCreateFont(Application::getNVGContext(), fontName.c_str(), filePath.c_str());
+    std::shared_ptr<Asset> file = Application::platform->getFontLoader()->openFontFile(filePath);
+
+    int handle = FONT_INVALID;
+    if (file)
+        handle = nvgCreateFontMem(Application::getNVGContext(), fontName.c_str(), (unsigned char*)file->data(), file->size(), false);
 
     if (handle == FONT_INVALID)
     {
@@ -987,6 +1360,8 @@ bool Application::loadFontFromFile(std::string fontName, std::string filePath)
     }
 
     Application::fontStash[fontName] = handle;
+    Application::fontFiles.push_back(file);
+    Application::fontDataSize += file->size();
     return true;
 }
 
@@ -1001,6 +1376,7 @@ bool Application::loadFontFromMemory(std::string fontName, void* address, size_t
     }
 
     Application::fontStash[fontName] = handle;
+    Application::fontDataSize += size;
     return true;
 }
 
@@ -1014,7 +1390,7 @@ void Application::blockInputs(bool muteSounds)
     Application::muteSounds |= muteSounds;
     Application::blockInputsTokens += 1;
     getGlobalHintsUpdateEvent()->fire();
-    Logger::debug("Adding an inputs block token (tokens={})", Application::blockInputsTokens);
+    Logger::deferred<LogLevel::LOG_DEBUG>("Adding an inputs block token (tokens={})", Application::blockInputsTokens);
 }
 
 void Application::unblockInputs()
@@ -1025,7 +1401,7 @@ void Application::unblockInputs()
         muteSounds = false;
 
     getGlobalHintsUpdateEvent()->fire();
-    Logger::debug("Removing an inputs block token (tokens={})", Application::blockInputsTokens);
+    Logger::deferred<LogLevel::LOG_DEBUG>("Removing an inputs block token (tokens={})", Application::blockInputsTokens);
 }
 
 bool Application::isInputBlocks()
@@ -1072,6 +1448,41 @@ void Application::setWindowSize(int width, int height)
 
 void Application::onWindowResized(int width, int height)
 {
+    // Only the last size matters if the window is resized several times during a frame
+    Application::pendingWindowSize = (uint64_t)(uint32_t)width << 32 | (uint32_t)height;
+}
+
+void Application::applyPendingWindowSize()
+{
+    uint64_t size = Application::pendingWindowSize.exchange(0);
+    if (size == 0)
+        return;
+
+    int width  = (int)(size >> 32);
+    int height = (int)(size & 0xFFFFFFFF);
+
+    Application::setActiveEvent(true);
+
+    // The content width is fixed, the window is only scaled and its height changes:
+    // Yoga only lays out again the nodes depending on the height, and the
+    // measure caches of the others (labels mostly) still match
+    {
+        BRLS_TRACE_SCOPE("resize");
+        Time start = getCPUTimeUsec();
+
+        Application::resizeMeasuredNodes    = 0;
+        Application::resizeMeasureCallbacks = 0;
+        Application::windowResizing         = true;
+
+        Application::setWindowSize(width, height);
+
+        Application::windowResizing = false;
+
+        FrameProfiler::addSample("resize/layout", getCPUTimeUsec() - start);
+        FrameProfiler::setCounter("resize/measured_nodes", Application::resizeMeasuredNodes);
+        FrameProfiler::setCounter("resize/measure_callbacks", Application::resizeMeasureCallbacks);
+    }
+
     // Trigger event when Window size is stable
     static size_t iter = 0;
     brls::cancelDelay(iter);
@@ -1081,7 +1492,6 @@ void Application::onWindowResized(int width, int height)
                 width, height, contentWidth, contentHeight, Application::windowScale);
             brls::Logger::info("scale factor: {}", Application::getPlatform()->getVideoContext()->getScaleFactor());
 
-            Application::setWindowSize(width, height);
             Application::getWindowSizeChangedEvent()->fire(); });
 }
 
@@ -1156,6 +1566,11 @@ Event<bool>* Application::getWindowFocusChangedEvent()
     return &Application::windowFocusChangedEvent;
 }
 
+Event<ThemeVariant>* Application::getThemeChangedEvent()
+{
+    return &Application::themeChangedEvent;
+}
+
 int Application::getFont(std::string fontName)
 {
     if (Application::fontStash.count(fontName) == 0)
@@ -1174,6 +1589,11 @@ int Application::getDefaultFont()
     return regular;
 }
 
+size_t Application::getFontDataSize()
+{
+    return Application::fontDataSize;
+}
+
 bool Application::XMLViewsRegisterContains(std::string name)
 {
     return Application::xmlViewsRegister.count(name) > 0;
@@ -1197,6 +1617,7 @@ void Application::registerBuiltInXMLViews()
     Application::registerXMLView("brls:HScrollingFrame", HScrollingFrame::create);
     Application::registerXMLView("brls:RecyclerFrame", RecyclerFrame::create);
     Application::registerXMLView("brls:Image", Image::create);
+    Application::registerXMLView("brls:AnimatedImage", AnimatedImage::create);
     Application::registerXMLView("brls:Padding", Padding::create);
     Application::registerXMLView("brls:Button", Button::create);
     Application::registerXMLView("brls:CheckBox", CheckBox::create);
@@ -0,0 +1,262 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <borealis/core/asset_store.hpp>
+#include <borealis/core/assets.hpp>
+#include <borealis/core/thread.hpp>
+#include <borealis/core/trace.hpp>
+#include <borealis/core/util.hpp>
+
+#ifdef USE_BOOST_FILESYSTEM
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+#ifdef USE_LIBROMFS
+#include <romfs/romfs.hpp>
+#endif
+
+namespace brls
+{
+
+static const std::string RESOURCE_PREFIX = "@res/";
+
+void Asset::prefetch() const
+{
+    if (this->file)
+        this->file->prefetch();
+}
+
+bool AssetStore::isResource(const std::string& path)
+{
+    return startsWith(path, RESOURCE_PREFIX);
+}
+
+bool AssetStore::fileExists(const std::string& path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && !(st.st_mode & S_IFDIR);
+}
+
+std::shared_ptr<Asset> AssetStore::open(const std::string& path)
+{
+    BRLS_TRACE_SCOPE("asset/open");
+
+    bool resourcePath = isResource(path);
+
+    // Files can be modified, created or deleted at any time, only resources are immutable
+    if (resourcePath)
+    {
+        std::lock_guard<std::mutex> lock(AssetStore::mutex);
+
+        auto it = AssetStore::assets.find(path);
+        if (it != AssetStore::assets.end())
+        {
+            if (std::shared_ptr<Asset> asset = it->second.lock())
+                return asset;
+        }
+
+        auto existing = AssetStore::existing.find(path);
+        if (existing != AssetStore::existing.end() && !existing->second)
+            return nullptr;
+    }
+
+    std::shared_ptr<Asset> asset = std::make_shared<Asset>();
+    asset->path                  = path;
+    bool found                   = false;
+
+    if (resourcePath)
+    {
+#ifdef USE_LIBROMFS
+        try
+        {
+            const romfs::Resource& resource = romfs::get(path.substr(RESOURCE_PREFIX.size()));
+            if (resource.valid() && resource.compressed() && resource.size() > LARGE_RESOURCE_SIZE)
+            {
+                asset->buffer.resize(resource.size());
+                if (resource.decompress((std::byte*)asset->buffer.data()))
+                {
+                    asset->address = asset->buffer.data();
+                    asset->length  = asset->buffer.size();
+                    found          = true;
+                }
+            }
+            else if (resource.valid())
+            {
+                // Decompressed on first access, null if that fails
+                asset->address = (const uint8_t*)resource.data();
+                asset->length  = resource.size();
+                found          = asset->address != nullptr;
+            }
+        }
+        catch (...)
+        {
+        }
+#else
+        asset->file = MappedFile::open(std::string(BRLS_RESOURCES) + path.substr(RESOURCE_PREFIX.size()));
+#endif
+    }
+    else
+    {
+        asset->file = MappedFile::open(path);
+    }
+
+    if (asset->file)
+    {
+        asset->address = asset->file->data();
+        asset->length  = asset->file->size();
+        found          = true;
+    }
+
+    if (!resourcePath)
+        return found ? asset : nullptr;
+
+    std::lock_guard<std::mutex> lock(AssetStore::mutex);
+
+    AssetStore::existing[path] = found;
+
+    if (!found)
+        return nullptr;
+
+    // Opened by another thread in the meantime
+    std::shared_ptr<Asset> other = AssetStore::assets[path].lock();
+    if (other)
+        return other;
+
+    AssetStore::assets[path] = asset;
+
+    if (AssetStore::assets.size() >= AssetStore::pruneSize)
+    {
+        for (auto it = AssetStore::assets.begin(); it != AssetStore::assets.end();)
+        {
+            if (it->second.expired())
+                it = AssetStore::assets.erase(it);
+            else
+                ++it;
+        }
+
+        AssetStore::pruneSize = std::max((size_t)64, AssetStore::assets.size() * 2);
+    }
+
+    return asset;
+}
+
+void AssetStore::openAsync(const std::string& path, std::function<void(std::shared_ptr<Asset>)> callback)
+{
+    brls::async([path, callback]() {
+        std::shared_ptr<Asset> asset = AssetStore::open(path);
+        if (asset)
+            asset->prefetch();
+
+        callback(asset);
+    });
+}
+
+bool AssetStore::exists(const std::string& path)
+{
+    if (!isResource(path))
+        return fileExists(path);
+
+    {
+        std::lock_guard<std::mutex> lock(AssetStore::mutex);
+
+        auto existing = AssetStore::existing.find(path);
+        if (existing != AssetStore::existing.end())
+            return existing->second;
+    }
+
+    bool found;
+
+#ifdef USE_LIBROMFS
+    try
+    {
+        found = romfs::get(path.substr(RESOURCE_PREFIX.size())).valid();
+    }
+    catch (...)
+    {
+        found = false;
+    }
+#else
+    found = fileExists(std::string(BRLS_RESOURCES) + path.substr(RESOURCE_PREFIX.size()));
+#endif
+
+    std::lock_guard<std::mutex> lock(AssetStore::mutex);
+    AssetStore::existing[path] = found;
+    return found;
+}
+
+std::vector<std::string> AssetStore::list(const std::string& directory)
+{
+    std::vector<std::string> paths;
+
+#ifdef USE_LIBROMFS
+    if (isResource(directory))
+    {
+        try
+        {
+            for (auto& entry : romfs::list(directory.substr(RESOURCE_PREFIX.size())))
+                paths.push_back(RESOURCE_PREFIX + entry.string());
+        }
+        catch (...)
+        {
+        }
+
+        return paths;
+    }
+#endif
+
+    std::string prefix = directory;
+    if (!prefix.empty() && prefix.back() != '/')
+        prefix += "/";
+
+    std::string path = directory;
+#ifndef USE_LIBROMFS
+    if (isResource(directory))
+        path = std::string(BRLS_RESOURCES) + directory.substr(RESOURCE_PREFIX.size());
+#endif
+
+    try
+    {
+        for (const fs::directory_entry& entry : fs::directory_iterator(path))
+        {
+#ifdef USE_BOOST_FILESYSTEM
+            if (!fs::is_directory(entry))
+#else
+            if (!entry.is_directory())
+#endif
+                paths.push_back(prefix + entry.path().filename().string());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Logger::debug("AssetStore: cannot list {}: {}", directory, e.what());
+    }
+
+    return paths;
+}
+
+void AssetStore::clearCache()
+{
+    std::lock_guard<std::mutex> lock(AssetStore::mutex);
+    AssetStore::existing.clear();
+}
+
+} // namespace brls
@@ -18,10 +18,11 @@
 #include <tinyxml2.h>
 
 #include <borealis/core/application.hpp>
+#include <borealis/core/asset_store.hpp>
 #include <borealis/core/box.hpp>
 #include <borealis/core/util.hpp>
 #include <cmath>
-#include <fstream>
+#include <typeinfo>
 
 namespace brls
 {
@@ -116,8 +117,28 @@ void Box::getCullingBounds(float* top, float* right, float* bottom, float* left)
     *bottom = *top + this->getHeight();
 }
 
+bool Box::isFlattenable()
+{
+    return typeid(*this) == typeid(Box);
+}
+
+void Box::invalidateDrawList()
+{
+    this->drawList.invalidate();
+
+    // The children of flattenable boxes are listed by their parent, and so on
+    for (Box* box = this; box->getParent() && box->isFlattenable(); box = box->getParent())
+        box->getParent()->drawList.invalidate();
+}
+
 void Box::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
+    if (DrawList::isEnabled())
+    {
+        this->drawList.draw(ctx, this, Rect(x, y, width, height));
+        return;
+    }
+
     for (View* child : this->children)
     {
         // Ensure that the child is in bounds of all parents before drawing it
@@ -169,6 +190,7 @@ void Box::addView(View* view, size_t position)
 
     // Add the view to our children and YGNode
     this->children.insert(this->children.begin() + position, view);
+    this->invalidateDrawList();
 
     if (!view->isDetached())
         YGNodeInsertChild(this->ygNode, view->getYGNode(), position);
@@ -219,6 +241,7 @@ void Box::removeView(View* view, bool free)
     if (!view->isDetached())
         YGNodeRemoveChild(this->ygNode, view->getYGNode());
     this->children.erase(this->children.begin() + index);
+    this->invalidateDrawList();
 
     view->willDisappear(true);
     if (free)
@@ -245,6 +268,7 @@ void Box::clearViews(bool free)
             view->freeView();
     }
 
+    this->invalidateDrawList();
     this->invalidate();
 }
 
@@ -458,6 +482,14 @@ void Box::onWindowSizeChanged()
         child->onWindowSizeChanged();
 }
 
+void Box::onThemeChanged()
+{
+    View::onThemeChanged();
+
+    for (View* child : this->children)
+        child->onThemeChanged();
+}
+
 std::vector<View*>& Box::getChildren()
 {
     return this->children;
@@ -467,7 +499,7 @@ void Box::inflateFromXMLString(std::string_view xml)
 {
     // Load XML
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->Parse(xml.data());
+    tinyxml2::XMLError error        = document->Parse(xml.data(), xml.size());
 
     this->bindXMLDocument(document);
 
@@ -485,35 +517,21 @@ void Box::inflateFromXMLString(std::string_view xml)
 void Box::inflateFromXMLRes(const std::string& name)
 {
     // Check if custom xml file exists
-    if (!View::CUSTOM_RESOURCES_PATH.empty() && std::ifstream { View::CUSTOM_RESOURCES_PATH + name }.good())
+    if (!View::CUSTOM_RESOURCES_PATH.empty() && AssetStore::exists(View::CUSTOM_RESOURCES_PATH + name))
     {
         return Box::inflateFromXMLFile(View::CUSTOM_RESOURCES_PATH + name);
     }
 
-#ifdef USE_LIBROMFS
-    return Box::inflateFromXMLString(romfs::get(name).string());
-#else
-    return Box::inflateFromXMLFile(std::string(BRLS_RESOURCES) + name);
-#endif
+    return Box::inflateFromXMLFile("@res/" + name);
 }
 
 void Box::inflateFromXMLFile(const std::string& path)
 {
-    // Load XML
-    tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->LoadFile(path.c_str());
+    std::shared_ptr<Asset> asset = AssetStore::open(path);
+    if (!asset)
+        fatal("Unable to inflate " + this->describe() + " from \"" + path + "\": file not found or empty");
 
-    this->bindXMLDocument(document);
-
-    if (error != tinyxml2::XMLError::XML_SUCCESS)
-        fatal("Invalid XML when inflating " + this->describe() + ": error " + std::to_string(error));
-
-    tinyxml2::XMLElement* element = document->RootElement();
-
-    if (!element)
-        fatal("Invalid XML: no element found");
-
-    return Box::inflateFromXMLElement(element);
+    return Box::inflateFromXMLString(asset->string());
 }
 
 void Box::inflateFromXMLElement(tinyxml2::XMLElement* element)
@@ -532,7 +550,17 @@ void Box::inflateFromXMLElement(tinyxml2::XMLElement* element)
 
 void Box::handleXMLElement(tinyxml2::XMLElement* element)
 {
-    this->addView(View::createFromXMLElement(element));
+    this->addXMLChildView(View::createFromXMLElement(element));
+}
+
+bool Box::canAddXMLChildView()
+{
+    return true;
+}
+
+void Box::addXMLChildView(View* view)
+{
+    this->addView(view);
 }
 
 void Box::setAxis(Axis axis)
@@ -0,0 +1,195 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/application.hpp>
+#include <borealis/core/box.hpp>
+#include <borealis/core/draw_list.hpp>
+
+namespace brls
+{
+
+static Rect intersect(const Rect& a, const Rect& b)
+{
+    float left   = std::max(a.getMinX(), b.getMinX());
+    float top    = std::max(a.getMinY(), b.getMinY());
+    float right  = std::min(a.getMaxX(), b.getMaxX());
+    float bottom = std::min(a.getMaxY(), b.getMaxY());
+
+    return Rect(left, top, right - left, bottom - top);
+}
+
+static Rect cullingBounds(Box* box)
+{
+    float top, right, bottom, left;
+    box->getCullingBounds(&top, &right, &bottom, &left);
+    return Rect(left, top, right - left, bottom - top);
+}
+
+void DrawList::setEnabled(bool enabled)
+{
+    DrawList::enabled = enabled;
+}
+
+bool DrawList::isEnabled()
+{
+    return DrawList::enabled;
+}
+
+void DrawList::invalidate()
+{
+    this->dirty = true;
+}
+
+size_t DrawList::size()
+{
+    return this->items.size();
+}
+
+void DrawList::build(Box* owner)
+{
+    this->items.clear();
+    this->append(owner, -1);
+    this->dirty = false;
+}
+
+void DrawList::append(Box* box, int parent)
+{
+    for (View* child : box->getChildren())
+    {
+        size_t index = this->items.size();
+        Box* childBox = dynamic_cast<Box*>(child);
+
+        DrawItem item;
+        item.view     = child;
+        item.kind     = childBox && childBox->isFlattenable() ? DrawItemKind::BOX : DrawItemKind::VIEW;
+        item.cullable = childBox == nullptr;
+        item.parent   = parent;
+        this->items.push_back(item);
+
+        if (item.kind == DrawItemKind::BOX)
+            this->append(childBox, (int)index);
+
+        this->items[index].end = this->items.size();
+    }
+}
+
+void DrawList::closeScopes(FrameContext* ctx, size_t index)
+{
+    while (!this->scopes.empty() && this->items[this->scopes.back().item].end <= index)
+    {
+        Scope scope    = this->scopes.back();
+        DrawItem& item = this->items[scope.item];
+        this->scopes.pop_back();
+
+        if (scope.wireframe)
+            item.view->drawWireframe(ctx, item.frame);
+
+        if (scope.restore)
+            nvgRestore(ctx->vg);
+
+        if (scope.restoreTheme)
+            ctx->theme = scope.theme;
+    }
+}
+
+void DrawList::draw(FrameContext* ctx, Box* owner, Rect frame)
+{
+    if (this->dirty)
+        this->build(owner);
+
+    Style style = Application::getStyle();
+
+    // The leaf views are culled against the bounds of all their parents
+    Rect ownerBounds = cullingBounds(owner);
+    for (Box* parent = owner->getParent(); parent != nullptr; parent = parent->getParent())
+        ownerBounds = intersect(ownerBounds, cullingBounds(parent));
+
+    this->scopes.clear();
+
+    size_t index = 0;
+    while (index < this->items.size())
+    {
+        this->closeScopes(ctx, index);
+
+        DrawItem& item = this->items[index];
+        View* view     = item.view;
+
+        if (view->getVisibility() != Visibility::VISIBLE)
+        {
+            index = item.end;
+            continue;
+        }
+
+        const Rect& parentFrame  = item.parent < 0 ? frame : this->items[item.parent].frame;
+        const Rect& parentBounds = item.parent < 0 ? ownerBounds : this->items[item.parent].cullingBounds;
+
+        item.frame = Rect(parentFrame.getMinX() + view->getLocalX(), parentFrame.getMinY() + view->getLocalY(), view->getWidth(), view->getHeight());
+
+        if (item.kind == DrawItemKind::VIEW)
+        {
+            bool culled = item.cullable && view->isCulled()
+                && (item.frame.getMaxY() < parentBounds.getMinY() // too high
+                    || item.frame.getMaxX() < parentBounds.getMinX() // too far left
+                    || item.frame.getMinX() > parentBounds.getMaxX() // too far right
+                    || item.frame.getMinY() > parentBounds.getMaxY()); // too low
+
+            if (!culled)
+                view->frame(ctx);
+
+            index++;
+            continue;
+        }
+
+        // Same as View::frame(), the children being drawn by the next items
+        if (view->alpha <= 0.0f || view->collapseState == 0.0f)
+        {
+            index = item.end;
+            continue;
+        }
+
+        item.cullingBounds = intersect(parentBounds, item.frame);
+
+        Scope scope;
+        scope.item         = index;
+        scope.restoreTheme = view->themeOverride != nullptr;
+        scope.restore      = view->collapseState < 1.0f || view->clipsToBounds;
+        scope.wireframe    = view->wireframeEnabled;
+
+        if (scope.restoreTheme)
+        {
+            scope.theme = ctx->theme;
+            ctx->theme  = *view->themeOverride;
+        }
+
+        view->drawDecorations(ctx, style, item.frame);
+
+        if (scope.restore)
+        {
+            nvgSave(ctx->vg);
+            nvgIntersectScissor(ctx->vg, item.frame.getMinX(), item.frame.getMinY(), item.frame.getWidth(), item.frame.getHeight() * view->collapseState);
+        }
+
+        if (scope.restore || scope.restoreTheme || scope.wireframe)
+            this->scopes.push_back(scope);
+
+        index++;
+    }
+
+    this->closeScopes(ctx, this->items.size());
+}
+
+} // namespace brls
@@ -14,21 +14,145 @@
     limitations under the License.
 */
 
-#include <unistd.h>
-
 #include <borealis/core/application.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/core/font.hpp>
 
-#define MATERIAL_ICONS "material/MaterialIcons-Regular.ttf"
-#define MATERIAL_ICONS_PATH BRLS_ASSET(MATERIAL_ICONS)
+#ifdef BOREALIS_USE_STD_THREAD
+#include <thread>
+#else
+#include <pthread.h>
+#endif
+
+#define MATERIAL_ICONS_PATH BRLS_ASSET("material/MaterialIcons-Regular.ttf")
 
 namespace brls
 {
 
+// Only one font loader exists at a time
+#ifdef BOREALIS_USE_STD_THREAD
+static std::thread* preload_thread = nullptr;
+#else
+static pthread_t preload_thread = pthread_t(0);
+#endif
+static bool preload_running = false;
+
+FontLoader::~FontLoader()
+{
+    this->waitForPreload();
+}
+
+void FontLoader::preloadFonts()
+{
+    if (preload_running)
+        return;
+
+    this->preloadPaths = this->getPreloadPaths();
+    if (this->preloadPaths.empty())
+        return;
+
+    preload_running = true;
+#ifdef BOREALIS_USE_STD_THREAD
+    preload_thread = new std::thread(&FontLoader::preloadTask, this);
+#else
+    pthread_create(&preload_thread, NULL, &FontLoader::preloadTask, this);
+#endif
+}
+
+void* FontLoader::preloadTask(void* loader)
+{
+    FontLoader* self = (FontLoader*)loader;
+
+    for (const std::string& path : self->preloadPaths)
+    {
+        if (path.empty() || self->preloadedFiles.count(path))
+            continue;
+
+        std::shared_ptr<Asset> file = AssetStore::open(path);
+        if (!file)
+            continue;
+
+        file->prefetch();
+        self->preloadedFiles[path] = file;
+    }
+
+    return NULL;
+}
+
+void FontLoader::waitForPreload()
+{
+    if (!preload_running)
+        return;
+
+#ifdef BOREALIS_USE_STD_THREAD
+    preload_thread->join();
+    delete preload_thread;
+    preload_thread = nullptr;
+#else
+    pthread_join(preload_thread, NULL);
+#endif
+    preload_running = false;
+}
+
+std::shared_ptr<Asset> FontLoader::openFontFile(const std::string& filePath)
+{
+    this->waitForPreload();
+
+    auto it = this->preloadedFiles.find(filePath);
+    if (it != this->preloadedFiles.end())
+    {
+        std::shared_ptr<Asset> file = it->second;
+        this->preloadedFiles.erase(it);
+        return file;
+    }
+
+    return AssetStore::open(filePath);
+}
+
+void FontLoader::addLazyFallbackFont(std::string fontName, std::string filePath, std::string baseFont, std::vector<CodepointRange> ranges)
+{
+    if (this->lazyFonts.empty())
+        nvgSetMissingGlyphCallback(Application::getNVGContext(), &FontLoader::onMissingGlyph, this);
+
+    this->lazyFonts.push_back({ fontName, filePath, baseFont, ranges });
+    Logger::info("Registered {} font: {} (loaded when needed)", fontName, filePath);
+}
+
+int FontLoader::onMissingGlyph(void* loader, int baseFont, unsigned int codepoint)
+{
+    FontLoader* self = (FontLoader*)loader;
+    NVGcontext* vg   = Application::getNVGContext();
+    int added        = 0;
+
+    for (LazyFont& font : self->lazyFonts)
+    {
+        if (font.opened || Application::getFont(font.baseFont) != baseFont)
+            continue;
+
+        bool inRange = font.ranges.empty();
+        for (const CodepointRange& range : font.ranges)
+            inRange |= codepoint >= range.first && codepoint <= range.second;
+
+        if (!inRange)
+            continue;
+
+        // Only tried once, even if loading fails
+        font.opened = true;
+
+        if (!Application::loadFontFromFile(font.name, font.path))
+            continue;
+
+        nvgAddFallbackFontId(vg, baseFont, Application::getFont(font.name));
+        Logger::info("Loaded {} font for codepoint {:#x}", font.name, codepoint);
+        added = 1;
+    }
+
+    return added;
+}
+
 bool FontLoader::loadFontFromFile(std::string fontName, std::string filePath)
 {
-    if (access(filePath.c_str(), F_OK) != -1)
+    if (AssetStore::exists(filePath))
     {
         bool loaded = Application::loadFontFromFile(fontName, filePath);
 
@@ -47,16 +171,7 @@ bool FontLoader::loadFontFromFile(std::string fontName, std::string filePath)
 
 bool FontLoader::loadMaterialFromResources()
 {
-#ifdef USE_LIBROMFS
-    auto& font = romfs::get(MATERIAL_ICONS);
-    if (!font.valid())
-    {
-        return false;
-    }
-    return Application::loadFontFromMemory(FONT_MATERIAL_ICONS, (void*)font.data(), font.size(), false);
-#else
     return this->loadFontFromFile(FONT_MATERIAL_ICONS, MATERIAL_ICONS_PATH);
-#endif
 }
 
 } // namespace brls
@@ -0,0 +1,142 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/frame_pacer.hpp>
+#include <borealis/core/profiler.hpp>
+#include <chrono>
+#include <thread>
+
+namespace brls
+{
+
+void FramePacer::setTargetFrameTime(Time frameTime)
+{
+    FramePacer::targetFrameTime = std::max(frameTime, (Time)0);
+    FramePacer::reset();
+}
+
+Time FramePacer::getTargetFrameTime()
+{
+    return FramePacer::targetFrameTime;
+}
+
+void FramePacer::setLateLatching(bool enabled)
+{
+    FramePacer::lateLatching = enabled;
+    FramePacer::reset();
+}
+
+bool FramePacer::getLateLatching()
+{
+    return FramePacer::lateLatching;
+}
+
+void FramePacer::framePresented(Time time)
+{
+    FramePacer::presentTime.store(time, std::memory_order_relaxed);
+}
+
+void FramePacer::reset()
+{
+    FramePacer::deadline     = 0;
+    FramePacer::lastPresent  = 0;
+    FramePacer::lastInterval = 0;
+}
+
+void FramePacer::endFrame(Time frameStart)
+{
+    Time now = getCPUTimeUsec();
+
+    // Swap of the last presented frame, which is an older frame with the render thread
+    Time present = FramePacer::presentTime.load(std::memory_order_relaxed);
+    if (present == 0)
+        present = now;
+
+    // Present cadence
+    if (FramePacer::lastPresent != 0 && present != FramePacer::lastPresent)
+    {
+        Time interval  = present - FramePacer::lastPresent;
+        Time reference = FramePacer::targetFrameTime > 0 ? FramePacer::targetFrameTime : FramePacer::lastInterval;
+
+        FrameProfiler::addSample("frame/present", interval);
+        if (reference > 0)
+            FrameProfiler::addSample("frame/jitter", std::abs(interval - reference));
+
+        FramePacer::lastInterval = interval;
+    }
+    FramePacer::lastPresent = present;
+
+    if (FramePacer::targetFrameTime == 0)
+        return;
+
+    // Slowly forget the slow frames, but react to a new one right away
+    FramePacer::workEstimate = std::max((double)(now - frameStart), FramePacer::workEstimate * 0.98);
+
+    // With late-latching the deadline is when the next frame should be presented, one frame after
+    // the measured present of this one: the next frame starts early enough to be done by then.
+    if (FramePacer::lateLatching)
+    {
+        if (FramePacer::deadline != 0 && present > FramePacer::deadline + LATE_LATCH_MARGIN)
+            FrameProfiler::addCounter("frame/missed");
+
+        Time lead            = std::min((Time)FramePacer::workEstimate + LATE_LATCH_MARGIN, FramePacer::targetFrameTime);
+        FramePacer::deadline = present + FramePacer::targetFrameTime;
+
+        if (now < FramePacer::deadline - lead)
+            FramePacer::waitUntil(FramePacer::deadline - lead);
+
+        return;
+    }
+
+    // Without it the deadline is when the next frame starts
+    if (FramePacer::deadline != 0)
+        FramePacer::deadline += FramePacer::targetFrameTime;
+
+    if (FramePacer::deadline == 0 || now > FramePacer::deadline)
+    {
+        if (FramePacer::deadline != 0)
+            FrameProfiler::addCounter("frame/missed");
+
+        // Too late to catch up: start a new cadence with the next frame, instead of rushing frames
+        FramePacer::deadline = now;
+        return;
+    }
+
+    FramePacer::waitUntil(FramePacer::deadline);
+}
+
+void FramePacer::waitUntil(Time time)
+{
+    Time now   = getCPUTimeUsec();
+    Time sleep = time - now - FramePacer::spinMargin;
+
+    if (sleep > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(sleep));
+
+        // Widen the margin as soon as the scheduler oversleeps, shrink it back slowly
+        Time oversleep         = getCPUTimeUsec() - now - sleep;
+        Time margin            = std::max(oversleep + oversleep / 2, FramePacer::spinMargin - FramePacer::spinMargin / 64);
+        Time maxMargin         = std::clamp(FramePacer::targetFrameTime / SPIN_FRACTION, MIN_SPIN_MARGIN, MAX_SPIN_MARGIN);
+        FramePacer::spinMargin = std::clamp(margin, MIN_SPIN_MARGIN, maxMargin);
+    }
+
+    while (getCPUTimeUsec() < time)
+        std::this_thread::yield();
+}
+
+} // namespace brls
@@ -0,0 +1,171 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/gif_decoder.hpp>
+#include <cstring>
+
+// The public stb_image API can only decode all the frames of a GIF at once,
+// this private copy of its GIF loader gives access to the frame by frame one
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_GIF
+#define STBI_NO_STDIO
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function" // most of the loader is unused here
+#include <stb_image.h>
+#pragma GCC diagnostic pop
+
+namespace brls
+{
+
+struct GifDecoder::State
+{
+    stbi__context context;
+    stbi__gif gif;
+
+    // Last two frames, for the ones restoring the previous frame when disposed
+    std::vector<unsigned char> history[2];
+
+    size_t frame = 0; // since the beginning
+};
+
+std::unique_ptr<GifDecoder> GifDecoder::openFile(const std::string& path)
+{
+    std::shared_ptr<Asset> file = AssetStore::open(path);
+    if (!file)
+        return nullptr;
+
+    std::unique_ptr<GifDecoder> decoder(new GifDecoder());
+    decoder->file = file;
+
+    if (!decoder->init(file->data(), file->size()))
+        return nullptr;
+
+    return decoder;
+}
+
+std::unique_ptr<GifDecoder> GifDecoder::openMemory(const unsigned char* data, size_t size)
+{
+    std::unique_ptr<GifDecoder> decoder(new GifDecoder());
+    decoder->buffer.assign(data, data + size);
+
+    if (!decoder->init(decoder->buffer.data(), decoder->buffer.size()))
+        return nullptr;
+
+    return decoder;
+}
+
+bool GifDecoder::init(const uint8_t* data, size_t size)
+{
+    if (size < 10 || size > INT32_MAX)
+        return false;
+
+    this->data  = data;
+    this->size  = size;
+    this->state = std::make_unique<State>();
+
+    stbi__start_mem(&this->state->context, data, (int)size);
+    if (!stbi__gif_test(&this->state->context))
+        return false;
+
+    // Logical screen size, every frame is composed into it
+    this->width  = data[6] | (data[7] << 8);
+    this->height = data[8] | (data[9] << 8);
+
+    if (this->width == 0 || this->height == 0)
+        return false;
+
+    memset(&this->state->gif, 0, sizeof(stbi__gif));
+    return true;
+}
+
+void GifDecoder::rewind()
+{
+    stbi__gif* gif = &this->state->gif;
+
+    STBI_FREE(gif->out);
+    STBI_FREE(gif->background);
+    STBI_FREE(gif->history);
+    memset(gif, 0, sizeof(stbi__gif));
+
+    stbi__start_mem(&this->state->context, this->data, (int)this->size);
+    this->state->frame = 0;
+}
+
+GifDecoder::~GifDecoder()
+{
+    if (!this->state)
+        return;
+
+    STBI_FREE(this->state->gif.out);
+    STBI_FREE(this->state->gif.background);
+    STBI_FREE(this->state->gif.history);
+}
+
+int GifDecoder::getWidth()
+{
+    return this->width;
+}
+
+int GifDecoder::getHeight()
+{
+    return this->height;
+}
+
+size_t GifDecoder::getFrameCount()
+{
+    return this->frameCount;
+}
+
+bool GifDecoder::decodeFrame(unsigned char* pixels, int* delay)
+{
+    State* state  = this->state.get();
+    size_t length = (size_t)this->width * this->height * 4;
+
+    // At most once again from the beginning after the last frame
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        std::vector<unsigned char>& twoBack = state->history[state->frame % 2];
+
+        int components;
+        stbi_uc* frame = stbi__gif_load_next(&state->context, &state->gif, &components, 4, state->frame >= 2 ? twoBack.data() : nullptr);
+
+        // End of the stream
+        if (frame == (stbi_uc*)&state->context)
+        {
+            if (state->frame == 0)
+                return false;
+
+            this->frameCount = state->frame;
+            this->rewind();
+            continue;
+        }
+
+        if (!frame || state->gif.w != this->width || state->gif.h != this->height)
+            return false;
+
+        memcpy(pixels, frame, length);
+        twoBack.assign(frame, frame + length);
+
+        *delay = state->gif.delay;
+        state->frame++;
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace brls
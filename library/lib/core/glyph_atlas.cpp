@@ -0,0 +1,342 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <borealis/core/application.hpp>
+#include <borealis/core/font.hpp>
+#include <borealis/core/glyph_atlas.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/thread.hpp>
+#include <cstring>
+#include <memory>
+
+extern "C"
+{
+#include <fontstash.h>
+}
+
+namespace brls
+{
+
+static constexpr const char CACHE_MAGIC[8] = { 'B', 'R', 'L', 'S', 'G', 'L', 'Y', '1' };
+
+// Part of the font files hashed to key the cache
+static constexpr int HASHED_FONT_BYTES = 64 * 1024;
+
+// Header of every glyph in a cache file, followed by its pixels
+struct CachedGlyph
+{
+    uint32_t codepoint;
+    int32_t index;
+    int16_t size, xadv, xoff, yoff, width, height;
+};
+static_assert(sizeof(CachedGlyph) == 20, "CachedGlyph must not be padded");
+
+// Rasterized glyphs, shared between the async and sync tasks
+struct GlyphImages
+{
+    ~GlyphImages()
+    {
+        for (FONSglyphImage& image : this->images)
+            fonsFreeGlyphImage(&image);
+    }
+
+    std::vector<FONSglyphImage> images;
+};
+
+static std::vector<unsigned int> decodeUtf8(const std::string& str)
+{
+    std::vector<unsigned int> codepoints;
+
+    for (size_t i = 0; i < str.size();)
+    {
+        unsigned char c = str[i];
+        size_t length   = 0;
+
+        if (c < 0x80)
+            length = 1;
+        else if ((c >> 5) == 0x6)
+            length = 2;
+        else if ((c >> 4) == 0xE)
+            length = 3;
+        else if ((c >> 3) == 0x1E)
+            length = 4;
+
+        if (length == 0 || i + length > str.size())
+        {
+            i++; // invalid byte
+            continue;
+        }
+
+        unsigned int codepoint = length == 1 ? c : c & (0xFF >> (length + 1));
+        for (size_t j = 1; j < length; j++)
+            codepoint = (codepoint << 6) | (str[i + j] & 0x3F);
+
+        codepoints.push_back(codepoint);
+        i += length;
+    }
+
+    return codepoints;
+}
+
+// FNV-1a
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+static std::string getCachePath(const std::string& directory, const std::string& fontName, FONSrasterizer* rasterizer, const std::vector<float>& sizes, const std::vector<unsigned int>& codepoints)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    // Beginning and end of the font and its fallbacks, they change with any other font version
+    for (int i = 0; i < fonsRasterizerFontCount(rasterizer); i++)
+    {
+        int size                  = 0;
+        const unsigned char* data = fonsRasterizerFontData(rasterizer, i, &size);
+        int hashed                = std::min(size, HASHED_FONT_BYTES);
+
+        hash = hashBytes(hash, &size, sizeof(size));
+        hash = hashBytes(hash, data, hashed);
+        hash = hashBytes(hash, data + size - hashed, hashed);
+    }
+
+    for (float size : sizes)
+    {
+        short isize = (short)(size * 10.0f);
+        hash        = hashBytes(hash, &isize, sizeof(isize));
+    }
+
+    hash = hashBytes(hash, codepoints.data(), codepoints.size() * sizeof(unsigned int));
+
+    return fmt::format("{}/{}-{:016x}.glyphs", directory, fontName, hash);
+}
+
+static bool loadCache(const std::string& path, std::vector<FONSglyphImage>* images)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t count = 0;
+    bool valid     = fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, CACHE_MAGIC, sizeof(magic)) == 0
+        && fread(&count, sizeof(count), 1, file) == 1;
+
+    for (uint32_t i = 0; valid && i < count; i++)
+    {
+        CachedGlyph glyph;
+        if (fread(&glyph, sizeof(glyph), 1, file) != 1 || glyph.width <= 0 || glyph.height <= 0)
+        {
+            valid = false;
+            break;
+        }
+
+        FONSglyphImage image;
+        image.codepoint = glyph.codepoint;
+        image.index     = glyph.index;
+        image.size      = glyph.size;
+        image.xadv      = glyph.xadv;
+        image.xoff      = glyph.xoff;
+        image.yoff      = glyph.yoff;
+        image.width     = glyph.width;
+        image.height    = glyph.height;
+        image.data      = (unsigned char*)malloc(glyph.width * glyph.height);
+
+        if (!image.data)
+        {
+            valid = false;
+            break;
+        }
+
+        images->push_back(image);
+
+        if (fread(image.data, glyph.width * glyph.height, 1, file) != 1)
+            valid = false;
+    }
+
+    fclose(file);
+
+    if (!valid)
+    {
+        for (FONSglyphImage& image : *images)
+            fonsFreeGlyphImage(&image);
+        images->clear();
+
+        Logger::warning("GlyphAtlas: ignoring invalid cache file {}", path);
+    }
+
+    return valid;
+}
+
+static void saveCache(const std::string& path, const std::vector<FONSglyphImage>& images)
+{
+    // Written next to the final file, then renamed so that a partial file is never loaded
+    std::string tempPath = path + ".tmp";
+    FILE* file           = fopen(tempPath.c_str(), "wb");
+    if (!file)
+    {
+        Logger::warning("GlyphAtlas: cannot write cache file {}", path);
+        return;
+    }
+
+    uint32_t count = images.size();
+    bool written   = fwrite(CACHE_MAGIC, sizeof(CACHE_MAGIC), 1, file) == 1 && fwrite(&count, sizeof(count), 1, file) == 1;
+
+    for (const FONSglyphImage& image : images)
+    {
+        if (!written)
+            break;
+
+        CachedGlyph glyph;
+        glyph.codepoint = image.codepoint;
+        glyph.index     = image.index;
+        glyph.size      = image.size;
+        glyph.xadv      = image.xadv;
+        glyph.xoff      = image.xoff;
+        glyph.yoff      = image.yoff;
+        glyph.width     = image.width;
+        glyph.height    = image.height;
+
+        written = fwrite(&glyph, sizeof(glyph), 1, file) == 1
+            && fwrite(image.data, image.width * image.height, 1, file) == 1;
+    }
+
+    if (fclose(file) != 0)
+        written = false;
+
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        remove(tempPath.c_str());
+        Logger::warning("GlyphAtlas: cannot write cache file {}", path);
+    }
+}
+
+// Same font size as nvgText() gives to fontstash for a text drawn with the window scale
+static float getRenderScale()
+{
+    float scale      = ((int)(Application::windowScale / 0.01f + 0.5f)) * 0.01f;
+    float pixelRatio = (float)Application::getPlatform()->getVideoContext()->getScaleFactor();
+    return std::min(scale, 4.0f) * pixelRatio;
+}
+
+void GlyphAtlas::setCacheDirectory(const std::string& path)
+{
+    GlyphAtlas::cacheDirectory = path;
+}
+
+std::string GlyphAtlas::getCacheDirectory()
+{
+    return GlyphAtlas::cacheDirectory;
+}
+
+size_t GlyphAtlas::getPendingJobs()
+{
+    return GlyphAtlas::pendingJobs;
+}
+
+void GlyphAtlas::prewarm(const std::string& fontName, const std::string& characters, const std::vector<float>& sizes)
+{
+    NVGcontext* vg = Application::getNVGContext();
+    int font       = Application::getFont(fontName);
+
+    if (!vg || font == FONT_INVALID)
+    {
+        Logger::warning("GlyphAtlas: cannot prewarm unknown font {}", fontName);
+        return;
+    }
+
+    FONSrasterizer* rasterizer = fonsCreateRasterizer(nvgGetFontStash(vg), font);
+    if (!rasterizer)
+        return;
+
+    std::vector<unsigned int> codepoints = decodeUtf8(characters);
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    std::vector<float> renderSizes;
+    float scale = getRenderScale();
+    for (float size : sizes)
+        renderSizes.push_back(size * scale);
+
+    std::string directory = GlyphAtlas::cacheDirectory;
+    GlyphAtlas::pendingJobs++;
+
+    brls::async([fontName, font, rasterizer, codepoints, renderSizes, directory]() {
+        Time start                          = getCPUTimeUsec();
+        std::shared_ptr<GlyphImages> glyphs = std::make_shared<GlyphImages>();
+        std::string cachePath;
+
+        if (!directory.empty())
+            cachePath = getCachePath(directory, fontName, rasterizer, renderSizes, codepoints);
+
+        bool cached = !cachePath.empty() && loadCache(cachePath, &glyphs->images);
+
+        if (!cached)
+        {
+            for (float size : renderSizes)
+            {
+                for (unsigned int codepoint : codepoints)
+                {
+                    FONSglyphImage image;
+                    if (fonsRasterizeGlyph(rasterizer, codepoint, size, &image))
+                        glyphs->images.push_back(image);
+                }
+            }
+
+            if (!cachePath.empty())
+                saveCache(cachePath, glyphs->images);
+        }
+
+        Logger::debug("GlyphAtlas: {} {} glyphs of {} in {}us", cached ? "loaded" : "rasterized", glyphs->images.size(), fontName, getCPUTimeUsec() - start);
+
+        brls::sync([font, rasterizer, glyphs]() {
+            NVGcontext* vg  = Application::getNVGContext();
+            FONScontext* fs = nvgGetFontStash(vg);
+            size_t added    = 0;
+
+            fonsDeleteRasterizer(rasterizer);
+
+            for (FONSglyphImage& image : glyphs->images)
+            {
+                // Move to a bigger atlas when full, stop once the biggest one is full
+                if (!fonsAddGlyphImage(fs, font, &image) && (!nvgGrowTextAtlas(vg) || !fonsAddGlyphImage(fs, font, &image)))
+                {
+                    Logger::warning("GlyphAtlas: atlas full, {} glyphs not prewarmed", glyphs->images.size() - added);
+                    break;
+                }
+
+                added++;
+            }
+
+            FrameProfiler::addCounter("glyphs/prewarmed", added);
+            GlyphAtlas::pendingJobs--;
+        });
+    });
+}
+
+} // namespace brls
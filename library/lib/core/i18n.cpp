@@ -15,16 +15,8 @@
 */
 
 #include <borealis/core/application.hpp>
-#include <borealis/core/assets.hpp>
+#include <borealis/core/asset_store.hpp>
 #include <borealis/core/i18n.hpp>
-#ifdef USE_BOOST_FILESYSTEM
-#include <boost/filesystem.hpp>
-namespace fs = boost::filesystem;
-#else
-#include <filesystem>
-namespace fs = std::filesystem;
-#endif
-#include <fstream>
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -42,72 +34,37 @@ static void loadLocale(std::string locale, nlohmann::json* target)
 {
     if (locale.empty())
         return;
-#ifdef USE_LIBROMFS
-    auto localePath = romfs::list("i18n/" + locale);
-    if (localePath.empty())
-    {
-        Logger::error("Cannot load locale {}: directory i18n/{} doesn't exist", locale, locale);
-        return;
-    }
-    for (auto& entry : localePath)
-    {
-        std::string path = entry.string();
-        std::string name = entry.filename().string();
-        if (!endsWith(name, ".json"))
-            continue;
 
-        (*target)[name.substr(0, name.length() - 5)] = nlohmann::json::parse(romfs::get(path).string());
-    }
-#else
-    std::string localePath = BRLS_ASSET("i18n/" + locale);
-
-    if (!fs::exists(localePath))
+    std::vector<std::string> paths = AssetStore::list("@res/i18n/" + locale);
+    if (paths.empty())
     {
-        Logger::error("Cannot load locale {}: directory {} doesn't exist", locale, localePath);
-        return;
-    }
-    else if (!fs::is_directory(localePath))
-    {
-        Logger::error("Cannot load locale {}: {} isn't a directory", locale, localePath);
+        Logger::error("Cannot load locale {}: directory i18n/{} doesn't exist or is empty", locale, locale);
         return;
     }
 
-    // Iterate over all JSON files in the directory
-    for (const fs::directory_entry& entry : fs::directory_iterator(localePath))
+    for (const std::string& path : paths)
     {
-#if USE_BOOST_FILESYSTEM
-        if (fs::is_directory(entry))
-#else
-        if (entry.is_directory())
-#endif
-            continue;
-
-        std::string name = entry.path().filename().string();
-
+        std::string name = path.substr(path.find_last_of("/\\") + 1);
         if (!endsWith(name, ".json"))
             continue;
 
-        std::string path = entry.path().string();
+        std::shared_ptr<Asset> asset = AssetStore::open(path);
+        if (!asset)
+            continue;
 
         nlohmann::json strings;
 
-        std::ifstream jsonStream;
-        jsonStream.open(path);
-
         try
         {
-            jsonStream >> strings;
+            strings = nlohmann::json::parse(asset->data(), asset->data() + asset->size());
         }
         catch (const std::exception& e)
         {
             Logger::error("Error while loading \"{}\": {}", path, e.what());
         }
 
-        jsonStream.close();
-
         (*target)[name.substr(0, name.length() - 5)] = strings;
     }
-#endif /* USE_LIBROMFS */
 }
 
 void loadTranslations()
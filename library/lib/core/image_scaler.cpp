@@ -0,0 +1,227 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <math.h>
+
+#include <algorithm>
+#include <borealis/core/image_scaler.hpp>
+
+namespace brls
+{
+
+static constexpr int WEIGHT_BITS  = 14;
+static constexpr int WEIGHT_ONE   = 1 << WEIGHT_BITS;
+static constexpr int WEIGHT_ROUND = 1 << (WEIGHT_BITS - 1);
+
+static constexpr float LANCZOS_LOBES = 3.0f;
+
+static float sinc(float x)
+{
+    if (x == 0.0f)
+        return 1.0f;
+
+    x *= (float)M_PI;
+    return sinf(x) / x;
+}
+
+static float lanczos(float x)
+{
+    if (fabsf(x) >= LANCZOS_LOBES)
+        return 0.0f;
+
+    return sinc(x) * sinc(x / LANCZOS_LOBES);
+}
+
+static inline unsigned char clampByte(int value)
+{
+    return (unsigned char)std::min(std::max(value, 0), 255);
+}
+
+ImageScaler::Contributions ImageScaler::getContributions(int srcSize, int dstSize, ImageFilter filter)
+{
+    Contributions contributions;
+    contributions.first.resize(dstSize);
+    contributions.count.resize(dstSize);
+    contributions.offset.resize(dstSize);
+
+    float scale = (float)srcSize / dstSize;
+
+    // When upscaling, filters keep their width in source pixels
+    float filterScale = std::max(scale, 1.0f);
+
+    std::vector<float> weights;
+
+    for (int i = 0; i < dstSize; i++)
+    {
+        float start = i * scale;
+        float end   = (i + 1) * scale;
+        int first, last;
+
+        weights.clear();
+
+        if (filter == ImageFilter::BOX && scale >= 1.0f)
+        {
+            // Area covered by every source pixel
+            first = std::min((int)floorf(start), srcSize - 1);
+            last  = std::max(std::min((int)ceilf(end) - 1, srcSize - 1), first);
+
+            for (int j = first; j <= last; j++)
+                weights.push_back(std::max(std::min(end, j + 1.0f) - std::max(start, (float)j), 0.0f));
+        }
+        else
+        {
+            // Linear interpolation for a box upscale
+            float support = filter == ImageFilter::BOX ? 1.0f : LANCZOS_LOBES * filterScale;
+            float center  = (start + end) / 2;
+
+            first = std::max((int)floorf(center - support), 0);
+            last  = std::min((int)ceilf(center + support), srcSize - 1);
+
+            for (int j = first; j <= last; j++)
+            {
+                float x = (j + 0.5f - center) / filterScale;
+                weights.push_back(filter == ImageFilter::BOX ? std::max(1.0f - fabsf(x), 0.0f) : lanczos(x));
+            }
+        }
+
+        float sum = 0.0f;
+        for (float weight : weights)
+            sum += weight;
+
+        if (sum == 0.0f)
+        {
+            // Can only happen with rounding errors at the edges
+            weights.assign(1, 1.0f);
+            last = first;
+            sum  = 1.0f;
+        }
+
+        contributions.first[i]  = first;
+        contributions.count[i]  = last - first + 1;
+        contributions.offset[i] = contributions.weights.size();
+
+        // Weights sum to exactly WEIGHT_ONE, the rounding error goes to the biggest one
+        int total   = 0;
+        int biggest = contributions.offset[i];
+
+        for (float weight : weights)
+        {
+            int fixed = (int)lroundf(weight / sum * WEIGHT_ONE);
+            total += fixed;
+            contributions.weights.push_back(fixed);
+
+            if (fixed > contributions.weights[biggest])
+                biggest = contributions.weights.size() - 1;
+        }
+
+        contributions.weights[biggest] += WEIGHT_ONE - total;
+    }
+
+    return contributions;
+}
+
+void ImageScaler::resize(const unsigned char* src, int srcWidth, int srcHeight, unsigned char* dst, int dstWidth, int dstHeight, ImageFilter filter)
+{
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0)
+        return;
+
+    Contributions horizontal = getContributions(srcWidth, dstWidth, filter);
+    Contributions vertical   = getContributions(srcHeight, dstHeight, filter);
+
+    size_t srcRowSize = (size_t)srcWidth * 4;
+    size_t dstRowSize = (size_t)dstWidth * 4;
+
+    // Horizontal pass first, the intermediate image is as small as possible when downscaling
+    std::vector<unsigned char> row(srcRowSize);
+    std::vector<unsigned char> intermediate(dstRowSize * srcHeight);
+
+    for (int y = 0; y < srcHeight; y++)
+    {
+        const unsigned char* in = src + y * srcRowSize;
+        unsigned char* out      = intermediate.data() + y * dstRowSize;
+
+        for (size_t i = 0; i < srcRowSize; i += 4)
+        {
+            int alpha  = in[i + 3];
+            row[i]     = (in[i] * alpha + 127) / 255;
+            row[i + 1] = (in[i + 1] * alpha + 127) / 255;
+            row[i + 2] = (in[i + 2] * alpha + 127) / 255;
+            row[i + 3] = alpha;
+        }
+
+        for (int x = 0; x < dstWidth; x++)
+        {
+            const unsigned char* pixels = row.data() + horizontal.first[x] * 4;
+            const int* weights          = horizontal.weights.data() + horizontal.offset[x];
+            int count                   = horizontal.count[x];
+
+            int r = WEIGHT_ROUND, g = WEIGHT_ROUND, b = WEIGHT_ROUND, a = WEIGHT_ROUND;
+
+            for (int k = 0; k < count; k++)
+            {
+                int weight = weights[k];
+                r += pixels[k * 4] * weight;
+                g += pixels[k * 4 + 1] * weight;
+                b += pixels[k * 4 + 2] * weight;
+                a += pixels[k * 4 + 3] * weight;
+            }
+
+            out[x * 4]     = clampByte(r >> WEIGHT_BITS);
+            out[x * 4 + 1] = clampByte(g >> WEIGHT_BITS);
+            out[x * 4 + 2] = clampByte(b >> WEIGHT_BITS);
+            out[x * 4 + 3] = clampByte(a >> WEIGHT_BITS);
+        }
+    }
+
+    // Vertical pass, accumulating whole rows
+    std::vector<int> accumulator(dstRowSize);
+
+    for (int y = 0; y < dstHeight; y++)
+    {
+        const int* weights = vertical.weights.data() + vertical.offset[y];
+        int count          = vertical.count[y];
+        int* sums          = accumulator.data();
+
+        std::fill(accumulator.begin(), accumulator.end(), WEIGHT_ROUND);
+
+        for (int k = 0; k < count; k++)
+        {
+            const unsigned char* in = intermediate.data() + (vertical.first[y] + k) * dstRowSize;
+            int weight              = weights[k];
+
+            for (size_t i = 0; i < dstRowSize; i++)
+                sums[i] += in[i] * weight;
+        }
+
+        unsigned char* out = dst + y * dstRowSize;
+
+        for (size_t i = 0; i < dstRowSize; i += 4)
+        {
+            int alpha = clampByte(sums[i + 3] >> WEIGHT_BITS);
+
+            // Lanczos can ring above the alpha, which is not a valid premultiplied color
+            for (int c = 0; c < 3; c++)
+            {
+                int color  = std::min((int)clampByte(sums[i + c] >> WEIGHT_BITS), alpha);
+                out[i + c] = alpha == 0 ? 0 : (color * 255 + alpha / 2) / alpha;
+            }
+
+            out[i + 3] = alpha;
+        }
+    }
+}
+
+} // namespace brls
@@ -0,0 +1,549 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/input_replay.hpp>
+#include <borealis/core/logger.hpp>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+
+namespace brls
+{
+
+static constexpr const char RECORDING_MAGIC[8] = { 'B', 'R', 'L', 'S', 'I', 'N', 'P', '1' };
+
+// What a recorded frame stores after its time
+enum FrameFlags : uint8_t
+{
+    FRAME_INPUT      = 1 << 0, // the input was read during that frame
+    FRAME_CONTROLLER = 1 << 1, // buttons and axes, if they changed
+    FRAME_MOUSE      = 1 << 2, // mouse state, if it changed
+    FRAME_TOUCHES    = 1 << 3, // touches, if any
+    FRAME_ESCAPE     = 1 << 4, // escape key pressed
+};
+
+// Values are stored in little endian, floats as their bits
+class RecordingWriter
+{
+  public:
+    void writeByte(uint8_t value)
+    {
+        this->data.push_back(value);
+    }
+
+    void writeInt(uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            this->data.push_back((value >> (i * 8)) & 0xFF);
+    }
+
+    void writeFloat(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        this->writeInt(bits);
+    }
+
+    std::vector<uint8_t> data;
+};
+
+class RecordingReader
+{
+  public:
+    RecordingReader(const std::vector<uint8_t>& data)
+        : data(data)
+    {
+    }
+
+    uint8_t readByte()
+    {
+        if (this->position + 1 > this->data.size())
+        {
+            this->failed = true;
+            return 0;
+        }
+
+        return this->data[this->position++];
+    }
+
+    uint32_t readInt()
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++)
+            value |= (uint32_t)this->readByte() << (i * 8);
+        return value;
+    }
+
+    float readFloat()
+    {
+        uint32_t bits = this->readInt();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool failed = false;
+
+  private:
+    const std::vector<uint8_t>& data;
+    size_t position = 0;
+};
+
+static bool isSameController(const InputFrame& a, const InputFrame& b)
+{
+    return memcmp(a.buttons, b.buttons, sizeof(a.buttons)) == 0 && memcmp(a.axes, b.axes, sizeof(a.axes)) == 0;
+}
+
+static bool isSameMouse(const RawMouseState& a, const RawMouseState& b)
+{
+    return a.position.x == b.position.x && a.position.y == b.position.y
+        && a.offset.x == b.offset.x && a.offset.y == b.offset.y
+        && a.scroll.x == b.scroll.x && a.scroll.y == b.scroll.y
+        && a.leftButton == b.leftButton && a.middleButton == b.middleButton && a.rightButton == b.rightButton;
+}
+
+static void writePoint(RecordingWriter* writer, Point point)
+{
+    writer->writeFloat(point.x);
+    writer->writeFloat(point.y);
+}
+
+static Point readPoint(RecordingReader* reader)
+{
+    float x = reader->readFloat();
+    float y = reader->readFloat();
+    return Point(x, y);
+}
+
+// InputRecorder
+
+void InputRecorder::start()
+{
+    InputRecorder::frames.clear();
+    InputRecorder::startTime = 0;
+    InputRecorder::recording = true;
+
+    Logger::info("InputRecorder: recording started");
+}
+
+bool InputRecorder::isRecording()
+{
+    return InputRecorder::recording;
+}
+
+void InputRecorder::frameStart(Time now)
+{
+    if (!InputRecorder::recording)
+        return;
+
+    if (InputRecorder::frames.empty())
+        InputRecorder::startTime = now;
+
+    InputFrame frame;
+    frame.time = now - InputRecorder::startTime;
+    InputRecorder::frames.push_back(frame);
+}
+
+void InputRecorder::recordInput(const ControllerState& controller, const std::vector<RawTouchState>& touches, const RawMouseState& mouse, bool escape)
+{
+    if (!InputRecorder::recording || InputRecorder::frames.empty())
+        return;
+
+    InputFrame& frame = InputRecorder::frames.back();
+    frame.hasInput    = true;
+    frame.escape      = escape;
+    frame.touches     = touches;
+    frame.mouse       = mouse;
+
+    memcpy(frame.buttons, controller.buttons, sizeof(frame.buttons));
+    memcpy(frame.axes, controller.axes, sizeof(frame.axes));
+}
+
+bool InputRecorder::stop(const std::string& path)
+{
+    InputRecorder::recording = false;
+
+    RecordingWriter writer;
+    for (char c : RECORDING_MAGIC)
+        writer.writeByte(c);
+
+    writer.writeInt((uint32_t)InputRecorder::frames.size());
+
+    InputFrame previous;
+    Time previousTime = 0;
+
+    for (const InputFrame& frame : InputRecorder::frames)
+    {
+        uint8_t flags = 0;
+
+        if (frame.hasInput)
+        {
+            flags |= FRAME_INPUT;
+
+            if (!isSameController(frame, previous))
+                flags |= FRAME_CONTROLLER;
+            if (!isSameMouse(frame.mouse, previous.mouse))
+                flags |= FRAME_MOUSE;
+            if (!frame.touches.empty())
+                flags |= FRAME_TOUCHES;
+            if (frame.escape)
+                flags |= FRAME_ESCAPE;
+        }
+
+        writer.writeInt((uint32_t)(frame.time - previousTime));
+        writer.writeByte(flags);
+
+        if (flags & FRAME_CONTROLLER)
+        {
+            uint32_t buttons = 0;
+            for (int i = 0; i < _BUTTON_MAX; i++)
+                buttons |= frame.buttons[i] ? 1u << i : 0;
+
+            writer.writeInt(buttons);
+            for (float axis : frame.axes)
+                writer.writeFloat(axis);
+        }
+
+        if (flags & FRAME_MOUSE)
+        {
+            writePoint(&writer, frame.mouse.position);
+            writePoint(&writer, frame.mouse.offset);
+            writePoint(&writer, frame.mouse.scroll);
+            writer.writeByte(frame.mouse.leftButton | frame.mouse.middleButton << 1 | frame.mouse.rightButton << 2);
+        }
+
+        if (flags & FRAME_TOUCHES)
+        {
+            writer.writeByte((uint8_t)std::min(frame.touches.size(), (size_t)0xFF));
+            for (size_t i = 0; i < frame.touches.size() && i < 0xFF; i++)
+            {
+                writer.writeInt((uint32_t)frame.touches[i].fingerId);
+                writer.writeByte(frame.touches[i].pressed);
+                writePoint(&writer, frame.touches[i].position);
+            }
+        }
+
+        // Unchanged states are carried over from the last frame that read the input
+        if (frame.hasInput)
+            previous = frame;
+        previousTime = frame.time;
+    }
+
+    size_t count = InputRecorder::frames.size();
+    InputRecorder::frames.clear();
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        Logger::error("InputRecorder: cannot write \"{}\"", path);
+        return false;
+    }
+
+    file.write((const char*)writer.data.data(), writer.data.size());
+    Logger::info("InputRecorder: {} frames written to \"{}\" ({} bytes)", count, path, writer.data.size());
+    return true;
+}
+
+// Input manager reading the current frame of the replay
+
+class ReplayInputManager : public InputManager
+{
+  public:
+    short getControllersConnectedCount() override
+    {
+        return 1;
+    }
+
+    void updateUnifiedControllerState(ControllerState* state) override
+    {
+        const InputFrame& frame = InputReplay::getCurrentFrame();
+        memcpy(state->buttons, frame.buttons, sizeof(frame.buttons));
+        memcpy(state->axes, frame.axes, sizeof(frame.axes));
+    }
+
+    void updateControllerState(ControllerState* state, int controller) override
+    {
+        this->updateUnifiedControllerState(state);
+    }
+
+    bool getKeyboardKeyState(BrlsKeyboardScancode key) override
+    {
+        return key == BRLS_KBD_KEY_ESCAPE && InputReplay::getCurrentFrame().escape;
+    }
+
+    void updateTouchStates(std::vector<RawTouchState>* states) override
+    {
+        const InputFrame& frame = InputReplay::getCurrentFrame();
+        states->insert(states->end(), frame.touches.begin(), frame.touches.end());
+    }
+
+    void updateMouseStates(RawMouseState* state) override
+    {
+        *state = InputReplay::getCurrentFrame().mouse;
+    }
+
+    void sendRumble(unsigned short controller, unsigned short lowFreqMotor, unsigned short highFreqMotor) override
+    {
+    }
+};
+
+static ReplayInputManager replayInputManager;
+
+// InputReplay
+
+bool InputReplay::start(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        Logger::error("InputReplay: cannot open \"{}\"", path);
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    RecordingReader reader(data);
+
+    for (char c : RECORDING_MAGIC)
+    {
+        if (reader.readByte() != (uint8_t)c)
+        {
+            Logger::error("InputReplay: \"{}\" is not an input recording", path);
+            return false;
+        }
+    }
+
+    uint32_t count = reader.readInt();
+
+    std::vector<InputFrame> frames;
+    frames.reserve(std::min(count, (uint32_t)(data.size() / 5)));
+
+    InputFrame previous;
+    for (uint32_t i = 0; i < count && !reader.failed; i++)
+    {
+        InputFrame frame = previous;
+        frame.time       = previous.time + reader.readInt();
+
+        uint8_t flags  = reader.readByte();
+        frame.hasInput = flags & FRAME_INPUT;
+        frame.escape   = flags & FRAME_ESCAPE;
+        frame.touches.clear();
+
+        if (flags & FRAME_CONTROLLER)
+        {
+            uint32_t buttons = reader.readInt();
+            for (int b = 0; b < _BUTTON_MAX; b++)
+                frame.buttons[b] = buttons & (1u << b);
+
+            for (float& axis : frame.axes)
+                axis = reader.readFloat();
+        }
+
+        if (flags & FRAME_MOUSE)
+        {
+            frame.mouse.position = readPoint(&reader);
+            frame.mouse.offset   = readPoint(&reader);
+            frame.mouse.scroll   = readPoint(&reader);
+
+            uint8_t buttons          = reader.readByte();
+            frame.mouse.leftButton   = buttons & 1;
+            frame.mouse.middleButton = buttons & 2;
+            frame.mouse.rightButton  = buttons & 4;
+        }
+
+        if (flags & FRAME_TOUCHES)
+        {
+            uint8_t touches = reader.readByte();
+            for (uint8_t t = 0; t < touches; t++)
+            {
+                RawTouchState touch;
+                touch.fingerId = (int)reader.readInt();
+                touch.pressed  = reader.readByte();
+                touch.position = readPoint(&reader);
+                frame.touches.push_back(touch);
+            }
+        }
+
+        frames.push_back(frame);
+
+        if (frame.hasInput)
+            previous = frame;
+        else
+            previous.time = frame.time;
+    }
+
+    if (reader.failed)
+    {
+        Logger::error("InputReplay: \"{}\" is truncated", path);
+        return false;
+    }
+
+    InputReplay::frames  = std::move(frames);
+    InputReplay::current = 0;
+    InputReplay::running = true;
+
+    InputReplay::frameTimes.clear();
+    InputReplay::workTimes.clear();
+
+    Logger::info("InputReplay: replaying {} frames from \"{}\"", InputReplay::frames.size(), path);
+    return true;
+}
+
+void InputReplay::stop()
+{
+    InputReplay::running = false;
+    InputReplay::frames.clear();
+    setUITimeOverride(0);
+}
+
+bool InputReplay::isRunning()
+{
+    return InputReplay::running;
+}
+
+Event<ReplayReport>* InputReplay::getFinishedEvent()
+{
+    return &InputReplay::finishedEvent;
+}
+
+InputManager* InputReplay::getInputManager()
+{
+    return &replayInputManager;
+}
+
+const InputFrame& InputReplay::getCurrentFrame()
+{
+    static const InputFrame empty;
+
+    if (!InputReplay::running || InputReplay::current == 0)
+        return empty;
+
+    return InputReplay::frames[InputReplay::current - 1];
+}
+
+Time InputReplay::frameStart(Time now)
+{
+    if (!InputReplay::running)
+    {
+        // Time doesn't go back if the replay was faster than the recording
+        InputReplay::lastFrameTime = std::max(now, InputReplay::lastFrameTime);
+        return InputReplay::lastFrameTime;
+    }
+
+    if (InputReplay::current == 0)
+    {
+        InputReplay::startTime     = std::max(now, InputReplay::lastFrameTime);
+        InputReplay::realStartTime = now;
+    }
+    else
+        InputReplay::frameTimes.push_back(now - InputReplay::frameRealTime);
+
+    if (InputReplay::current == InputReplay::frames.size())
+    {
+        ReplayReport report = InputReplay::buildReport();
+        report.duration     = now - InputReplay::realStartTime;
+
+        InputReplay::stop();
+
+        Logger::info("InputReplay: {} frames replayed, frame time avg {:.0f}us p95 {}us p99 {}us worst {}us",
+            report.frames, report.frameTime.avg, report.frameTime.p95, report.frameTime.p99, report.frameTime.worst);
+
+        InputReplay::finishedEvent.fire(report);
+        return InputReplay::frameStart(now);
+    }
+
+    InputReplay::frameRealTime = now;
+    InputReplay::lastFrameTime = InputReplay::startTime + InputReplay::frames[InputReplay::current].time;
+    InputReplay::current++;
+
+    // Everything displayed follows the recorded clock until the next frame
+    setUITimeOverride(InputReplay::lastFrameTime);
+
+    return InputReplay::lastFrameTime;
+}
+
+void InputReplay::frameEnd(Time now)
+{
+    if (!InputReplay::running || InputReplay::current == 0)
+        return;
+
+    InputReplay::workTimes.push_back(now - InputReplay::frameRealTime);
+}
+
+static ReplayFrameStats computeFrameStats(std::vector<Time> values)
+{
+    ReplayFrameStats stats;
+    if (values.empty())
+        return stats;
+
+    std::sort(values.begin(), values.end());
+
+    double total = 0;
+    for (Time value : values)
+        total += value;
+
+    // Nearest rank percentiles
+    auto percentile = [&values](double p)
+    {
+        size_t rank = (size_t)std::ceil(p / 100.0 * values.size());
+        return values[std::max(rank, (size_t)1) - 1];
+    };
+
+    stats.avg   = total / values.size();
+    stats.p50   = percentile(50);
+    stats.p95   = percentile(95);
+    stats.p99   = percentile(99);
+    stats.worst = values.back();
+
+    return stats;
+}
+
+ReplayReport InputReplay::buildReport()
+{
+    ReplayReport report;
+    report.frames    = InputReplay::frames.size();
+    report.frameTime = computeFrameStats(InputReplay::frameTimes);
+    report.workTime  = computeFrameStats(InputReplay::workTimes);
+    return report;
+}
+
+static nlohmann::ordered_json frameStatsToJSON(const ReplayFrameStats& stats)
+{
+    return {
+        { "avg", stats.avg },
+        { "p50", stats.p50 },
+        { "p95", stats.p95 },
+        { "p99", stats.p99 },
+        { "worst", stats.worst },
+    };
+}
+
+std::string ReplayReport::toJSON() const
+{
+    nlohmann::ordered_json report = {
+        { "frames", this->frames },
+        { "duration_us", this->duration },
+        { "time_unit", "us" },
+        { "frame_time", frameStatsToJSON(this->frameTime) },
+        { "work_time", frameStatsToJSON(this->workTime) },
+    };
+
+    return report.dump(2);
+}
+
+} // namespace brls
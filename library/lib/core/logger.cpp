@@ -19,10 +19,147 @@
 #include <stdio.h>
 
 #include <borealis/core/logger.hpp>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+
+#ifdef BOREALIS_USE_STD_THREAD
+#include <thread>
+#else
+#include <pthread.h>
+#endif
 
 namespace brls
 {
 
+// Bounded multi-producer queue (Dmitry Vyukov's algorithm), the writer thread being the only consumer:
+// every slot has a sequence number telling if it's free for the producer of a given position
+// or ready for the consumer.
+struct LogRing
+{
+    static constexpr size_t CAPACITY = 512; // must be a power of two
+
+    LogRing()
+    {
+        for (size_t i = 0; i < CAPACITY; i++)
+            this->records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LogRecord records[CAPACITY];
+
+    std::atomic<size_t> enqueuePos = 0;
+    std::atomic<size_t> dequeuePos = 0;
+};
+
+static LogRing& getRing()
+{
+    static LogRing ring;
+    return ring;
+}
+
+static std::mutex writerMutex;
+static std::atomic<bool> writerRunning = false;
+static bool writerAtExit = false;
+
+// The writer sleeps on wakeCondition while the ring is empty, producers only take
+// wakeMutex to signal it when it's actually sleeping
+static std::mutex wakeMutex;
+static std::condition_variable wakeCondition;
+static std::condition_variable drainedCondition;
+static std::atomic<bool> writerSleeping = false;
+static std::atomic<unsigned> flushWaiters = 0;
+
+// Messages logged by the writer thread itself (from a log event subscriber) are printed
+// synchronously: waiting for the writer there would never end
+static thread_local bool onWriterThread = false;
+
+// Subscribers can be added from any thread while the writer fires the event
+static std::recursive_mutex logEventMutex;
+
+#ifdef BOREALIS_USE_STD_THREAD
+static std::thread* writerThread = nullptr;
+#else
+static pthread_t writerThread = pthread_t(0);
+#endif
+
+static bool hasReadyRecord()
+{
+    LogRing& ring = getRing();
+    size_t pos    = ring.dequeuePos.load(std::memory_order_relaxed);
+    return ring.records[pos & (LogRing::CAPACITY - 1)].sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+static void wakeWriter()
+{
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wakeCondition.notify_one();
+}
+
+// Prints every ready record, returns false if there was none
+bool Logger::drainRing()
+{
+    LogRing& ring = getRing();
+    bool drained  = false;
+    std::string message;
+
+    while (true)
+    {
+        size_t pos        = ring.dequeuePos.load(std::memory_order_relaxed);
+        LogRecord& record = ring.records[pos & (LogRing::CAPACITY - 1)];
+
+        if (record.sequence.load(std::memory_order_acquire) != pos + 1)
+            return drained;
+
+        if (record.formatter)
+        {
+            try
+            {
+                record.formatter(record.message, record.format, record.args);
+            }
+            catch (const std::exception& e)
+            {
+                record.message = fmt::format("! Invalid log format string: \"{}\": {}", record.format, e.what());
+            }
+        }
+
+        Logger::print(record.time, record.level, record.message);
+
+        // Release the slot before firing the event, which can log again
+        TimePoint time = record.time;
+        LogLevel level = record.level;
+
+        message.clear();
+        message.swap(record.message); // the record keeps the capacity of the previous message
+
+        record.formatter = nullptr;
+        record.sequence.store(pos + LogRing::CAPACITY, std::memory_order_release);
+        ring.dequeuePos.store(pos + 1, std::memory_order_release);
+
+        Logger::fireLogEvent(time, level, message);
+
+        drained = true;
+    }
+}
+
+static void stopWriter()
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+
+    if (!writerRunning)
+        return;
+
+    writerRunning = false;
+    wakeWriter();
+
+#ifdef BOREALIS_USE_STD_THREAD
+    writerThread->join();
+    delete writerThread;
+    writerThread = nullptr;
+#else
+    pthread_join(writerThread, NULL);
+#endif
+}
+
 void Logger::setLogLevel(LogLevel newLogLevel)
 {
     Logger::logLevel = newLogLevel;
@@ -38,4 +175,236 @@ void Logger::setLogOutput(std::FILE *newLogOut)
     Logger::logOut = newLogOut;
 }
 
+void Logger::setAsync(bool newAsync)
+{
+    Logger::async = newAsync;
+
+    if (!newAsync)
+    {
+        stopWriter();
+        Logger::drainRing();
+    }
+}
+
+void Logger::flush()
+{
+    LogRing& ring = getRing();
+
+    // Every message before the current one has already been printed
+    if (onWriterThread)
+        return;
+
+    if (!writerRunning)
+    {
+        Logger::drainRing();
+        return;
+    }
+
+    size_t target = ring.enqueuePos.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    flushWaiters++;
+    drainedCondition.wait(lock, [&ring, target]()
+        { return !writerRunning || ring.dequeuePos.load(std::memory_order_acquire) >= target; });
+    flushWaiters--;
+}
+
+LogRecord* Logger::beginRecord(TimePoint time, LogLevel level)
+{
+    if (!Logger::async || onWriterThread)
+        return nullptr;
+
+    // Errors often precede a crash: print them right away
+    if (level == LogLevel::LOG_ERROR)
+    {
+        Logger::flush();
+        return nullptr;
+    }
+
+    if (!writerRunning)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+
+        if (!writerRunning)
+        {
+            writerRunning = true;
+#ifdef BOREALIS_USE_STD_THREAD
+            writerThread = new std::thread(&Logger::writerLoop, nullptr);
+#else
+            pthread_create(&writerThread, NULL, &Logger::writerLoop, NULL);
+#endif
+
+            if (!writerAtExit)
+            {
+                // The ring must be constructed first so that it's destroyed after the writer stops
+                getRing();
+                std::atexit([]() { Logger::setAsync(false); });
+                writerAtExit = true;
+            }
+        }
+    }
+
+    LogRing& ring = getRing();
+    size_t pos    = ring.enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        LogRecord& record = ring.records[pos & (LogRing::CAPACITY - 1)];
+        size_t sequence   = record.sequence.load(std::memory_order_acquire);
+        intptr_t diff     = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+            if (ring.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                record.time  = time;
+                record.level = level;
+                return &record;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Ring is full, don't wait for the writer
+            return nullptr;
+        }
+        else
+        {
+            pos = ring.enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::commitRecord(LogRecord* record)
+{
+    size_t pos = record->sequence.load(std::memory_order_relaxed);
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in writerLoop(): either the writer sees the record or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerSleeping.load(std::memory_order_relaxed))
+        wakeWriter();
+}
+
+void* Logger::writerLoop(void*)
+{
+    onWriterThread = true;
+
+    while (writerRunning)
+    {
+        Logger::drainRing();
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+
+        if (flushWaiters > 0)
+            drainedCondition.notify_all();
+
+        writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wakeCondition.wait(lock, []()
+            { return !writerRunning || hasReadyRecord(); });
+        writerSleeping.store(false, std::memory_order_relaxed);
+    }
+
+    Logger::drainRing();
+
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    drainedCondition.notify_all();
+    return NULL;
+}
+
+Event<Logger::TimePoint, LogLevel, std::string>::Subscription Logger::subscribeLogEvent(Event<TimePoint, LogLevel, std::string>::Callback callback)
+{
+    std::lock_guard<std::recursive_mutex> lock(logEventMutex);
+    return logEvent.subscribe(callback);
+}
+
+void Logger::unsubscribeLogEvent(Event<TimePoint, LogLevel, std::string>::Subscription subscription)
+{
+    std::lock_guard<std::recursive_mutex> lock(logEventMutex);
+    logEvent.unsubscribe(subscription);
+}
+
+void Logger::fireLogEvent(TimePoint now, LogLevel level, const std::string& log)
+{
+    std::lock_guard<std::recursive_mutex> lock(logEventMutex);
+
+    try
+    {
+        logEvent.fire(now, level, log);
+    }
+    catch (const std::exception& e)
+    {
+        printf("! Log event subscriber failed: %s\n", e.what());
+    }
+}
+
+void Logger::write(TimePoint now, LogLevel level, const std::string& log)
+{
+    Logger::print(now, level, log);
+    Logger::fireLogEvent(now, level, log);
+}
+
+void Logger::print(TimePoint now, LogLevel level, const std::string& log)
+{
+    const char* prefix;
+    const char* color;
+
+    switch (level)
+    {
+        case LogLevel::LOG_ERROR:
+            prefix = "ERROR";
+            color  = BRLS_ERROR_COLOR;
+            break;
+        case LogLevel::LOG_WARNING:
+            prefix = "WARNING";
+            color  = BRLS_WARNING_COLOR;
+            break;
+        case LogLevel::LOG_INFO:
+            prefix = "INFO";
+            color  = BRLS_INFO_COLOR;
+            break;
+        case LogLevel::LOG_DEBUG:
+            prefix = "DEBUG";
+            color  = BRLS_DEBUG_COLOR;
+            break;
+        default:
+            prefix = "VERBOSE";
+            color  = BRLS_VERBOSE_COLOR;
+            break;
+    }
+
+    uint64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now.time_since_epoch()).count() % 1000;
+#ifdef PS4
+    OrbisDateTime lt{};
+    if (sceRtcGetCurrentClockLocalTime)
+        sceRtcGetCurrentClockLocalTime(&lt);
+#else
+    std::tm time_tm = fmt::localtime(std::chrono::system_clock::to_time_t(now));
+#endif
+
+    try
+    {
+#ifdef IOS
+        fmt::print(logOut, "{:%H:%M:%S}.{:03d} {} {}\n", time_tm, (int)ms, color, log);
+#elif defined(ANDROID)
+        __android_log_print(6 - (int)level, "borealis", "%02d:%02d:%02d.%03d %s\n", time_tm.tm_hour, time_tm.tm_min, time_tm.tm_sec, (int)ms, log.c_str());
+#elif defined(__PSV__)
+        sceClibPrintf("%02d:%02d:%02d.%03d\033%s[%s]\033[0m %s\n", time_tm.tm_hour, time_tm.tm_min, time_tm.tm_sec, (int)ms, color, prefix, log.c_str());
+#elif defined(PS4)
+        sceKernelDebugOutText(0, fmt::format("{:02d}:{:02d}:{:02d}.{:03d}\033{}[{}]\033[0m {}\n", lt.hour, lt.minute, lt.second, (int)ms, color, prefix, log).c_str());
+#else
+        fmt::print(logOut, "{:%H:%M:%S}.{:03d}\033{}[{}]\033[0m {}\n", time_tm, (int)ms, color, prefix, log);
+#endif
+    }
+    catch (const std::exception& e)
+    {
+        printf("! Cannot print log: %s\n", e.what());
+    }
+
+#ifdef __MINGW32__
+    fflush(logOut);
+#endif
+}
+
 } // namespace brls
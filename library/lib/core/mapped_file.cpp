@@ -0,0 +1,165 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/logger.hpp>
+#include <borealis/core/mapped_file.hpp>
+#include <cstdio>
+
+#if defined(_WIN32) && !defined(__WINRT__)
+#define BRLS_MAPPED_FILE_WIN32
+#include <windows.h>
+#elif (defined(__linux__) || defined(__APPLE__) || defined(ANDROID)) && !defined(__SWITCH__) && !defined(__PSV__) && !defined(PS4)
+#define BRLS_MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace brls
+{
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path)
+{
+    std::shared_ptr<MappedFile> file(new MappedFile());
+
+#if defined(BRLS_MAPPED_FILE_POSIX)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        bool stated = fstat(fd, &st) == 0;
+        bool empty  = false;
+
+        if (stated && st.st_size > 0)
+        {
+            void* address = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED)
+            {
+                file->address = (const uint8_t*)address;
+                file->length  = st.st_size;
+                file->mapped  = true;
+            }
+        }
+        else
+        {
+            empty = stated && S_ISREG(st.st_mode) && st.st_size == 0;
+        }
+        close(fd);
+
+        // Empty files have nothing to map
+        if (file->mapped || empty)
+            return file;
+    }
+#elif defined(BRLS_MAPPED_FILE_WIN32)
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER size;
+        bool sized = GetFileSizeEx(handle, &size);
+        bool empty = false;
+
+        if (sized && size.QuadPart > 0)
+        {
+            HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping)
+            {
+                void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (address)
+                {
+                    file->address       = (const uint8_t*)address;
+                    file->length        = (size_t)size.QuadPart;
+                    file->mapped        = true;
+                    file->mappingHandle = mapping;
+                }
+                else
+                {
+                    CloseHandle(mapping);
+                }
+            }
+        }
+        else
+        {
+            empty = sized && size.QuadPart == 0;
+        }
+        CloseHandle(handle);
+
+        // Empty files have nothing to map
+        if (file->mapped || empty)
+            return file;
+    }
+#endif
+
+    // Fallback: read the whole file
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp)
+        return nullptr;
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (size <= 0)
+    {
+        fclose(fp);
+        return size == 0 ? file : nullptr;
+    }
+
+    file->buffer.resize(size);
+    size_t read = fread(file->buffer.data(), 1, size, fp);
+    fclose(fp);
+
+    if (read != (size_t)size)
+    {
+        Logger::warning("MappedFile: cannot read \"{}\"", path);
+        return nullptr;
+    }
+
+    file->address = file->buffer.data();
+    file->length  = file->buffer.size();
+    return file;
+}
+
+MappedFile::~MappedFile()
+{
+    if (!this->mapped)
+        return;
+
+#if defined(BRLS_MAPPED_FILE_POSIX)
+    munmap((void*)this->address, this->length);
+#elif defined(BRLS_MAPPED_FILE_WIN32)
+    UnmapViewOfFile(this->address);
+    CloseHandle(this->mappingHandle);
+#endif
+}
+
+void MappedFile::prefetch() const
+{
+    if (!this->mapped)
+        return;
+
+#if defined(BRLS_MAPPED_FILE_POSIX)
+    madvise((void*)this->address, this->length, MADV_WILLNEED);
+#else
+    // Touch every page
+    volatile uint8_t sum = 0;
+    for (size_t i = 0; i < this->length; i += 4096)
+        sum += this->address[i];
+    (void)sum;
+#endif
+}
+
+} // namespace brls
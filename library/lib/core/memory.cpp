@@ -0,0 +1,196 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/activity.hpp>
+#include <borealis/core/application.hpp>
+#include <borealis/core/cache_helper.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/memory.hpp>
+#include <borealis/core/sprite_atlas.hpp>
+#include <borealis/core/thread.hpp>
+#include <borealis/core/view_pool.hpp>
+#include <borealis/views/image.hpp>
+#include <unordered_map>
+
+extern "C"
+{
+#include <fontstash.h>
+}
+
+namespace brls
+{
+
+// Maximum number of leaked views logged at once
+static constexpr size_t MAX_LOGGED_LEAKS = 16;
+
+static size_t getTextureBytes(NVGcontext* vg, int texture)
+{
+    int width = 0, height = 0;
+    nvgImageSize(vg, texture, &width, &height);
+    return (size_t)width * height * 4;
+}
+
+MemoryStats MemoryTracker::getStats()
+{
+    MemoryStats stats;
+    NVGcontext* vg = Application::getNVGContext();
+
+    // One entry per activity of the stack, then one for the views created outside of them
+    std::unordered_map<ViewArena*, size_t> entries;
+    for (Activity* activity : Application::getActivitiesStack())
+    {
+        ActivityMemoryStats entry;
+        entry.activity  = activity;
+        entry.name      = activity->getContentView() ? activity->getContentView()->describe() : "Activity";
+        entry.viewBytes = ViewPool::getStats(activity->getViewArena()).reservedBytes;
+
+        entries[activity->getViewArena()] = stats.activities.size();
+        stats.activities.push_back(entry);
+    }
+
+    ActivityMemoryStats global;
+    global.name      = "Global";
+    global.viewBytes = ViewPool::getStats(nullptr).reservedBytes;
+
+    entries[nullptr] = stats.activities.size();
+    stats.activities.push_back(global);
+
+    // Views
+    for (auto& [view, arena] : ViewPool::getLiveViews())
+    {
+        auto entry = entries.find(arena);
+        if (entry == entries.end())
+        {
+            // Activity popped without being deleted, or deleted with leaked views
+            ActivityMemoryStats other;
+            other.name      = "Out of the stack";
+            other.viewBytes = ViewPool::getStats(arena).reservedBytes;
+
+            entry = entries.emplace(arena, stats.activities.size()).first;
+            stats.activities.push_back(other);
+        }
+
+        ActivityMemoryStats& activity = stats.activities[entry->second];
+        activity.views++;
+        activity.xmlDocuments += view->getBoundXMLDocumentsCount();
+
+        stats.viewsByClass[view->getClassString()]++;
+        stats.xmlDocuments += view->getBoundXMLDocumentsCount();
+
+        if (Image* image = dynamic_cast<Image*>(view))
+        {
+            if (image->ownsTexture())
+            {
+                size_t bytes = getTextureBytes(vg, image->getTexture());
+
+                activity.ownedTextures++;
+                activity.ownedTextureBytes += bytes;
+                stats.ownedTextures++;
+                stats.ownedTextureBytes += bytes;
+            }
+            else if (image->hasTexture())
+            {
+                activity.cachedImages++;
+            }
+        }
+    }
+
+    ViewPoolStats poolStats = ViewPool::getStats();
+    stats.views             = poolStats.liveViews;
+    stats.viewBytes         = poolStats.reservedBytes;
+    stats.yogaNodes         = poolStats.liveViews + poolStats.freeNodes;
+    stats.leakedViews       = poolStats.leakedViews;
+
+    // Textures and fonts
+    for (auto& node : TextureCache::instance().cache.getCacheList())
+    {
+        stats.cachedTextures++;
+
+        if (!SpriteAtlas::isSprite(node.value))
+            stats.cachedTextureBytes += getTextureBytes(vg, (int)node.value);
+    }
+
+    stats.spriteAtlasBytes = SpriteAtlas::getStats().bytes;
+    stats.fontBytes        = Application::getFontDataSize();
+
+    int atlasWidth = 0, atlasHeight = 0;
+    fonsGetAtlasSize(nvgGetFontStash(vg), &atlasWidth, &atlasHeight);
+    stats.fontAtlasBytes = (size_t)atlasWidth * atlasHeight;
+
+    // Tasks
+    stats.syncTasks  = Threading::getSyncTasksCount();
+    stats.asyncTasks = Threading::getAsyncTasksCount();
+    stats.delayTasks = Threading::getDelayTasksCount();
+
+    return stats;
+}
+
+std::vector<std::string> MemoryTracker::checkLeaks()
+{
+    std::vector<std::string> leaks;
+
+    for (View* view : ViewPool::takeLeakedViews())
+        leaks.push_back(view->describe());
+
+    if (leaks.empty())
+        return leaks;
+
+    Logger::warning("Memory: {} views are still alive after their activity has been deleted", leaks.size());
+
+    for (size_t i = 0; i < leaks.size() && i < MAX_LOGGED_LEAKS; i++)
+        Logger::warning("Memory: leaked {}", leaks[i]);
+
+    if (leaks.size() > MAX_LOGGED_LEAKS)
+        Logger::warning("Memory: and {} more", leaks.size() - MAX_LOGGED_LEAKS);
+
+    return leaks;
+}
+
+static std::string formatBytes(size_t bytes)
+{
+    if (bytes >= 1024 * 1024)
+        return fmt::format("{:.1f} MB", bytes / (1024.0 * 1024.0));
+
+    return fmt::format("{:.1f} KB", bytes / 1024.0);
+}
+
+std::string MemoryTracker::describe(const MemoryStats& stats)
+{
+    std::string text = fmt::format("Views: {} ({}), Yoga nodes: {}, XML documents: {}\n",
+        stats.views, formatBytes(stats.viewBytes), stats.yogaNodes, stats.xmlDocuments);
+
+    text += fmt::format("Textures: {} cached ({}), {} owned ({}), atlas {}\n",
+        stats.cachedTextures, formatBytes(stats.cachedTextureBytes),
+        stats.ownedTextures, formatBytes(stats.ownedTextureBytes), formatBytes(stats.spriteAtlasBytes));
+
+    text += fmt::format("Fonts: {}, glyphs {}\n", formatBytes(stats.fontBytes), formatBytes(stats.fontAtlasBytes));
+
+    text += fmt::format("Tasks: {} sync, {} async, {} delayed\n", stats.syncTasks, stats.asyncTasks, stats.delayTasks);
+
+    for (const ActivityMemoryStats& activity : stats.activities)
+    {
+        text += fmt::format("  {}: {} views ({}), {} owned textures ({}), {} cached images\n",
+            activity.name, activity.views, formatBytes(activity.viewBytes),
+            activity.ownedTextures, formatBytes(activity.ownedTextureBytes), activity.cachedImages);
+    }
+
+    if (stats.leakedViews > 0)
+        text += fmt::format("Leaked views: {}\n", stats.leakedViews);
+
+    return text;
+}
+
+} // namespace brls
@@ -0,0 +1,110 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/profiler.hpp>
+
+namespace brls
+{
+
+void ProfilerSeries::push(Time value)
+{
+    if (this->values.size() < SAMPLES_CAPACITY)
+        this->values.push_back(value);
+    else
+        this->values[this->next] = value;
+
+    this->next = (this->next + 1) % SAMPLES_CAPACITY;
+    this->total++;
+}
+
+ProfilerStats ProfilerSeries::stats() const
+{
+    ProfilerStats stats;
+
+    if (this->values.empty())
+        return stats;
+
+    stats.count = this->total;
+    stats.last  = this->values[(this->next + this->values.size() - 1) % this->values.size()];
+    stats.min   = *std::min_element(this->values.begin(), this->values.end());
+    stats.max   = *std::max_element(this->values.begin(), this->values.end());
+
+    double sum = 0;
+    for (Time value : this->values)
+        sum += value;
+    stats.avg = sum / this->values.size();
+
+    return stats;
+}
+
+void FrameProfiler::frameStart(Time now)
+{
+    if (FrameProfiler::lastFrameStart != 0)
+        FrameProfiler::frameTimes.push(now - FrameProfiler::lastFrameStart);
+
+    FrameProfiler::lastFrameStart = now;
+}
+
+void FrameProfiler::addSample(const std::string& name, Time value)
+{
+    FrameProfiler::samples[name].push(value);
+}
+
+void FrameProfiler::setCounter(const std::string& name, int64_t value)
+{
+    FrameProfiler::counters[name] = value;
+}
+
+void FrameProfiler::addCounter(const std::string& name, int64_t value)
+{
+    FrameProfiler::counters[name] += value;
+}
+
+int64_t FrameProfiler::getCounter(const std::string& name)
+{
+    auto it = FrameProfiler::counters.find(name);
+    return it == FrameProfiler::counters.end() ? 0 : it->second;
+}
+
+ProfilerStats FrameProfiler::getFrameStats()
+{
+    return FrameProfiler::frameTimes.stats();
+}
+
+ProfilerStats FrameProfiler::getStats(const std::string& name)
+{
+    auto it = FrameProfiler::samples.find(name);
+    if (it == FrameProfiler::samples.end())
+        return ProfilerStats();
+
+    return it->second.stats();
+}
+
+const std::map<std::string, int64_t>& FrameProfiler::getCounters()
+{
+    return FrameProfiler::counters;
+}
+
+void FrameProfiler::reset()
+{
+    FrameProfiler::lastFrameStart = 0;
+    FrameProfiler::frameTimes     = ProfilerSeries();
+    FrameProfiler::samples.clear();
+    FrameProfiler::counters.clear();
+}
+
+} // namespace brls
@@ -0,0 +1,680 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <atomic>
+#include <borealis/core/frame_pacer.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/render_pipeline.hpp>
+#include <borealis/core/time.hpp>
+#include <borealis/core/trace.hpp>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef BOREALIS_USE_STD_THREAD
+#include <thread>
+#else
+#include <pthread.h>
+#endif
+
+namespace brls
+{
+
+// Ids given to the textures created while recording, to tell them apart from the ids of the backend
+static constexpr int FIRST_RECORDED_IMAGE = 1 << 24;
+
+// Textures existing when the pipeline is installed, created by the backend and nanovg itself
+static constexpr int MAX_INITIAL_IMAGE = 16;
+
+enum class RenderCommandType
+{
+    VIEWPORT,
+    CANCEL,
+    FLUSH,
+    FILL,
+    STROKE,
+    TRIANGLES,
+    CREATE_TEXTURE,
+    UPDATE_TEXTURE_REGION,
+    DELETE_TEXTURE,
+};
+
+struct RenderCommand
+{
+    RenderCommandType type;
+
+    NVGpaint paint;
+    NVGcompositeOperationState compositeOperation;
+    NVGscissor scissor;
+    float fringe;
+    float values[4]; // viewport size and ratio, fill bounds or stroke width
+
+    size_t first; // first path or vertex
+    size_t count; // paths or vertices count
+
+    int image;
+    int textureType, flags;
+    int x, y, width, height;
+    size_t data; // offset of the texture data in the frame, SIZE_MAX if none
+};
+
+// Path with its vertices stored in the frame
+struct RecordedPath
+{
+    NVGpath path;
+    size_t fill;
+    size_t stroke;
+};
+
+struct RecordedFrame
+{
+    std::vector<RenderCommand> commands;
+    std::vector<RecordedPath> paths;
+    std::vector<NVGvertex> vertices;
+    std::vector<uint8_t> data;
+
+    bool present = false;
+    NVGcolor clearColor;
+
+    void clear()
+    {
+        this->commands.clear();
+        this->paths.clear();
+        this->vertices.clear();
+        this->data.clear();
+        this->present = false;
+    }
+};
+
+struct TextureInfo
+{
+    int type;
+    int width, height;
+};
+
+// Backend of the nanovg context before the pipeline was installed
+static NVGparams inner;
+static bool installed = false;
+static bool supported = true;
+
+// UI thread state
+static std::atomic<int> requestedDepth = 0;
+static bool running                    = false;
+static RecordedFrame* recording        = nullptr;
+static std::unordered_map<int, TextureInfo> textures;
+static int nextImage = FIRST_RECORDED_IMAGE;
+
+// Render thread state, only used by the UI thread when the render thread is not running
+static std::unordered_map<int, int> backendImages; // recorded id -> backend id
+static std::vector<NVGpath> replayPaths;
+static VideoContext* renderVideoContext = nullptr;
+static std::atomic<Time> lastRenderTime = 0;
+
+// Frames waiting to be rendered, and the rendered ones kept for their allocations
+static std::mutex queueMutex;
+static std::condition_variable queueCondition;
+static std::deque<RecordedFrame*> pendingFrames;
+static std::vector<RecordedFrame*> freeFrames;
+static bool stopRequested = false;
+
+#ifdef BOREALIS_USE_STD_THREAD
+static std::thread* renderThread = nullptr;
+#else
+static pthread_t renderThread = pthread_t(0);
+#endif
+
+static size_t textureSize(int type, int width, int height)
+{
+    return (size_t)width * height * (type == NVG_TEXTURE_RGBA ? 4 : 1);
+}
+
+static int backendImage(int image)
+{
+    auto it = backendImages.find(image);
+    return it != backendImages.end() ? it->second : image;
+}
+
+static NVGpaint* backendPaint(NVGpaint* paint)
+{
+    if (paint->image != 0)
+        paint->image = backendImage(paint->image);
+    return paint;
+}
+
+static const NVGpath* replayedPaths(const RecordedFrame* frame, const RenderCommand& command)
+{
+    replayPaths.resize(command.count);
+
+    for (size_t i = 0; i < command.count; i++)
+    {
+        const RecordedPath& recorded = frame->paths[command.first + i];
+        replayPaths[i]               = recorded.path;
+        replayPaths[i].fill          = recorded.path.nfill > 0 ? (NVGvertex*)&frame->vertices[recorded.fill] : nullptr;
+        replayPaths[i].stroke        = recorded.path.nstroke > 0 ? (NVGvertex*)&frame->vertices[recorded.stroke] : nullptr;
+    }
+
+    return replayPaths.data();
+}
+
+// Executes the recorded backend calls, on the thread owning the graphics context
+static void replay(RecordedFrame* frame)
+{
+    for (RenderCommand& command : frame->commands)
+    {
+        switch (command.type)
+        {
+            case RenderCommandType::VIEWPORT:
+                inner.renderViewport(inner.userPtr, command.values[0], command.values[1], command.values[2]);
+                break;
+            case RenderCommandType::CANCEL:
+                inner.renderCancel(inner.userPtr);
+                break;
+            case RenderCommandType::FLUSH:
+                inner.renderFlush(inner.userPtr);
+                break;
+            case RenderCommandType::FILL:
+                inner.renderFill(inner.userPtr, backendPaint(&command.paint), command.compositeOperation, &command.scissor,
+                    command.fringe, command.values, replayedPaths(frame, command), (int)command.count);
+                break;
+            case RenderCommandType::STROKE:
+                inner.renderStroke(inner.userPtr, backendPaint(&command.paint), command.compositeOperation, &command.scissor,
+                    command.fringe, command.values[0], replayedPaths(frame, command), (int)command.count);
+                break;
+            case RenderCommandType::TRIANGLES:
+                inner.renderTriangles(inner.userPtr, backendPaint(&command.paint), command.compositeOperation, &command.scissor,
+                    &frame->vertices[command.first], (int)command.count, command.fringe);
+                break;
+            case RenderCommandType::CREATE_TEXTURE:
+            {
+                const unsigned char* data = command.data != SIZE_MAX ? &frame->data[command.data] : nullptr;
+                int image                 = inner.renderCreateTexture(inner.userPtr, command.textureType, command.width, command.height, command.flags, data);
+                if (image == 0)
+                    Logger::error("RenderPipeline: cannot create a {}x{} texture", command.width, command.height);
+                backendImages[command.image] = image;
+                break;
+            }
+            case RenderCommandType::UPDATE_TEXTURE_REGION:
+                inner.renderUpdateTextureRegion(inner.userPtr, backendImage(command.image), command.x, command.y, command.width, command.height, frame->data.data() + command.data);
+                break;
+            case RenderCommandType::DELETE_TEXTURE:
+                inner.renderDeleteTexture(inner.userPtr, backendImage(command.image));
+                backendImages.erase(command.image);
+                break;
+        }
+    }
+}
+
+static RenderCommand& record(RenderCommandType type)
+{
+    RenderCommand& command = recording->commands.emplace_back();
+    command.type           = type;
+    command.data           = SIZE_MAX;
+    return command;
+}
+
+static size_t recordPaths(const NVGpath* paths, int npaths)
+{
+    size_t first = recording->paths.size();
+
+    for (int i = 0; i < npaths; i++)
+    {
+        RecordedPath& recorded = recording->paths.emplace_back();
+        recorded.path          = paths[i];
+
+        recorded.fill = recording->vertices.size();
+        recording->vertices.insert(recording->vertices.end(), paths[i].fill, paths[i].fill + paths[i].nfill);
+        recorded.stroke = recording->vertices.size();
+        recording->vertices.insert(recording->vertices.end(), paths[i].stroke, paths[i].stroke + paths[i].nstroke);
+    }
+
+    return first;
+}
+
+static size_t recordData(const unsigned char* data, size_t size)
+{
+    size_t offset = recording->data.size();
+    recording->data.insert(recording->data.end(), data, data + size);
+    return offset;
+}
+
+// nanovg backend recording the calls while the render thread runs, forwarding them otherwise
+
+static int pipelineCreate(void* uptr)
+{
+    return inner.renderCreate(inner.userPtr);
+}
+
+static int pipelineCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+    int image;
+
+    if (running)
+    {
+        image = nextImage++;
+
+        RenderCommand& command = record(RenderCommandType::CREATE_TEXTURE);
+        command.image          = image;
+        command.textureType    = type;
+        command.width          = w;
+        command.height         = h;
+        command.flags          = imageFlags;
+        if (data)
+            command.data = recordData(data, textureSize(type, w, h));
+    }
+    else
+    {
+        image = inner.renderCreateTexture(inner.userPtr, type, w, h, imageFlags, data);
+        if (image == 0)
+            return 0;
+    }
+
+    textures[image] = { type, w, h };
+    return image;
+}
+
+static int pipelineDeleteTexture(void* uptr, int image)
+{
+    if (textures.erase(image) == 0)
+        return 0;
+
+    if (running)
+    {
+        record(RenderCommandType::DELETE_TEXTURE).image = image;
+        return 1;
+    }
+
+    int result = inner.renderDeleteTexture(inner.userPtr, backendImage(image));
+    backendImages.erase(image);
+    return result;
+}
+
+static int pipelineUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+    auto it = textures.find(image);
+    if (it == textures.end())
+        return 0;
+
+    if (!running)
+        return inner.renderUpdateTexture(inner.userPtr, backendImage(image), x, y, w, h, data);
+
+    // Data holds the whole texture, only record the region to replay it as such
+    const TextureInfo& info = it->second;
+    size_t pixelSize        = textureSize(info.type, 1, 1);
+    size_t rowSize          = textureSize(info.type, w, 1);
+
+    RenderCommand& command = record(RenderCommandType::UPDATE_TEXTURE_REGION);
+    command.image          = image;
+    command.x              = x;
+    command.y              = y;
+    command.width          = w;
+    command.height         = h;
+    command.data           = recording->data.size();
+
+    for (int row = y; row < y + h; row++)
+        recordData(data + ((size_t)row * info.width + x) * pixelSize, rowSize);
+
+    return 1;
+}
+
+static int pipelineUpdateTextureRegion(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+    auto it = textures.find(image);
+    if (it == textures.end())
+        return 0;
+
+    if (!running)
+        return inner.renderUpdateTextureRegion(inner.userPtr, backendImage(image), x, y, w, h, data);
+
+    RenderCommand& command = record(RenderCommandType::UPDATE_TEXTURE_REGION);
+    command.image          = image;
+    command.x              = x;
+    command.y              = y;
+    command.width          = w;
+    command.height         = h;
+    command.data           = recordData(data, textureSize(it->second.type, w, h));
+    return 1;
+}
+
+static int pipelineGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+    auto it = textures.find(image);
+    if (it == textures.end())
+        return 0;
+
+    *w = it->second.width;
+    *h = it->second.height;
+    return 1;
+}
+
+static void pipelineViewport(void* uptr, float width, float height, float devicePixelRatio)
+{
+    if (!running)
+        return inner.renderViewport(inner.userPtr, width, height, devicePixelRatio);
+
+    RenderCommand& command = record(RenderCommandType::VIEWPORT);
+    command.values[0]      = width;
+    command.values[1]      = height;
+    command.values[2]      = devicePixelRatio;
+}
+
+static void pipelineCancel(void* uptr)
+{
+    if (!running)
+        return inner.renderCancel(inner.userPtr);
+
+    record(RenderCommandType::CANCEL);
+}
+
+static void pipelineFlush(void* uptr)
+{
+    if (!running)
+        return inner.renderFlush(inner.userPtr);
+
+    record(RenderCommandType::FLUSH);
+}
+
+static void pipelineFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+    if (!running)
+    {
+        NVGpaint backend = *paint;
+        return inner.renderFill(inner.userPtr, backendPaint(&backend), compositeOperation, scissor, fringe, bounds, paths, npaths);
+    }
+
+    RenderCommand& command     = record(RenderCommandType::FILL);
+    command.paint              = *paint;
+    command.compositeOperation = compositeOperation;
+    command.scissor            = *scissor;
+    command.fringe             = fringe;
+    std::memcpy(command.values, bounds, sizeof(command.values));
+    command.first = recordPaths(paths, npaths);
+    command.count = npaths;
+}
+
+static void pipelineStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+    if (!running)
+    {
+        NVGpaint backend = *paint;
+        return inner.renderStroke(inner.userPtr, backendPaint(&backend), compositeOperation, scissor, fringe, strokeWidth, paths, npaths);
+    }
+
+    RenderCommand& command     = record(RenderCommandType::STROKE);
+    command.paint              = *paint;
+    command.compositeOperation = compositeOperation;
+    command.scissor            = *scissor;
+    command.fringe             = fringe;
+    command.values[0]          = strokeWidth;
+    command.first              = recordPaths(paths, npaths);
+    command.count              = npaths;
+}
+
+static void pipelineTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe)
+{
+    if (!running)
+    {
+        NVGpaint backend = *paint;
+        return inner.renderTriangles(inner.userPtr, backendPaint(&backend), compositeOperation, scissor, verts, nverts, fringe);
+    }
+
+    RenderCommand& command     = record(RenderCommandType::TRIANGLES);
+    command.paint              = *paint;
+    command.compositeOperation = compositeOperation;
+    command.scissor            = *scissor;
+    command.fringe             = fringe;
+    command.first              = recording->vertices.size();
+    command.count              = nverts;
+    recording->vertices.insert(recording->vertices.end(), verts, verts + nverts);
+}
+
+static void pipelineDelete(void* uptr)
+{
+    if (running)
+        Logger::error("RenderPipeline: nanovg context deleted while the render thread is running");
+
+    inner.renderDelete(inner.userPtr);
+
+    installed = false;
+    textures.clear();
+    backendImages.clear();
+
+    delete recording;
+    recording = nullptr;
+
+    for (RecordedFrame* frame : freeFrames)
+        delete frame;
+    freeFrames.clear();
+}
+
+void RenderPipeline::install(NVGcontext* vg)
+{
+    if (installed)
+        return;
+
+    NVGparams* params = nvgInternalParams(vg);
+    inner             = *params;
+
+    // The backend already has a few textures (nanovg font atlas...), all of them alpha textures
+    for (int image = 1; image <= MAX_INITIAL_IMAGE; image++)
+    {
+        int width, height;
+        if (inner.renderGetTextureSize(inner.userPtr, image, &width, &height))
+            textures[image] = { NVG_TEXTURE_ALPHA, width, height };
+    }
+
+    params->userPtr                   = nullptr;
+    params->renderCreate              = pipelineCreate;
+    params->renderCreateTexture       = pipelineCreateTexture;
+    params->renderDeleteTexture       = pipelineDeleteTexture;
+    params->renderUpdateTexture       = pipelineUpdateTexture;
+    params->renderUpdateTextureRegion = pipelineUpdateTextureRegion;
+    params->renderGetTextureSize      = pipelineGetTextureSize;
+    params->renderViewport            = pipelineViewport;
+    params->renderCancel              = pipelineCancel;
+    params->renderFlush               = pipelineFlush;
+    params->renderFill                = pipelineFill;
+    params->renderStroke              = pipelineStroke;
+    params->renderTriangles           = pipelineTriangles;
+    params->renderDelete              = pipelineDelete;
+
+    recording = new RecordedFrame();
+    installed = true;
+}
+
+void RenderPipeline::setDepth(int depth)
+{
+    requestedDepth = std::max(0, std::min(depth, MAX_DEPTH));
+}
+
+int RenderPipeline::getDepth()
+{
+    return requestedDepth;
+}
+
+bool RenderPipeline::isRunning()
+{
+    return running;
+}
+
+void RenderPipeline::start(VideoContext* videoContext)
+{
+    if (!installed || !videoContext->makeCurrent(false))
+    {
+        Logger::warning("RenderPipeline: the video context doesn't support rendering on another thread");
+        supported = false;
+        return;
+    }
+
+    Logger::info("RenderPipeline: rendering on the render thread, {} frame(s) ahead", requestedDepth.load());
+
+    renderVideoContext = videoContext;
+    stopRequested      = false;
+    running            = true;
+
+#ifdef BOREALIS_USE_STD_THREAD
+    renderThread = new std::thread(&RenderPipeline::renderTask, nullptr);
+#else
+    pthread_create(&renderThread, NULL, &RenderPipeline::renderTask, NULL);
+#endif
+}
+
+void RenderPipeline::stop()
+{
+    if (!running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopRequested = true;
+    }
+    queueCondition.notify_all();
+
+#ifdef BOREALIS_USE_STD_THREAD
+    renderThread->join();
+    delete renderThread;
+    renderThread = nullptr;
+#else
+    pthread_join(renderThread, NULL);
+#endif
+
+    running = false;
+    renderVideoContext->makeCurrent(true);
+
+    // Texture operations recorded since the last frame
+    replay(recording);
+    recording->clear();
+
+    Logger::info("RenderPipeline: rendering on the UI thread");
+}
+
+void RenderPipeline::beginFrame(VideoContext* videoContext, NVGcolor clearColor)
+{
+    int depth = requestedDepth;
+
+    if (depth > 0 && !running && supported)
+        RenderPipeline::start(videoContext);
+    else if (depth == 0 && running)
+        RenderPipeline::stop();
+
+    if (!running)
+    {
+        videoContext->beginFrame();
+        videoContext->clear(clearColor);
+        return;
+    }
+
+    recording->clearColor = clearColor;
+}
+
+void RenderPipeline::endFrame(VideoContext* videoContext)
+{
+    if (!running)
+    {
+        videoContext->endFrame();
+        FramePacer::framePresented(getCPUTimeUsec());
+        return;
+    }
+
+    Time waitStart = getCPUTimeUsec();
+
+    {
+        BRLS_TRACE_SCOPE("render/wait");
+        std::unique_lock<std::mutex> lock(queueMutex);
+
+        recording->present = true;
+        pendingFrames.push_back(recording);
+
+        if (freeFrames.empty())
+        {
+            recording = new RecordedFrame();
+        }
+        else
+        {
+            recording = freeFrames.back();
+            freeFrames.pop_back();
+        }
+
+        queueCondition.notify_all();
+
+        // Back pressure: the frame being rendered plus the ones allowed ahead
+        queueCondition.wait(lock, []()
+            { return pendingFrames.size() <= (size_t)requestedDepth.load() || pendingFrames.size() <= 1; });
+    }
+
+    FrameProfiler::addSample("render/wait", getCPUTimeUsec() - waitStart);
+    FrameProfiler::addSample("render/submit", lastRenderTime);
+}
+
+void* RenderPipeline::renderTask(void* arg)
+{
+    BRLS_TRACE_THREAD_NAME("render");
+    renderVideoContext->makeCurrent(true);
+
+    while (true)
+    {
+        RecordedFrame* frame;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, []()
+                { return stopRequested || !pendingFrames.empty(); });
+
+            if (pendingFrames.empty())
+                break;
+
+            frame = pendingFrames.front();
+        }
+
+        Time start = getCPUTimeUsec();
+
+        {
+            BRLS_TRACE_SCOPE("render/submit");
+
+            if (frame->present)
+            {
+                renderVideoContext->beginFrame();
+                renderVideoContext->clear(frame->clearColor);
+            }
+
+            replay(frame);
+
+            if (frame->present)
+            {
+                renderVideoContext->endFrame();
+                FramePacer::framePresented(getCPUTimeUsec());
+            }
+        }
+
+        lastRenderTime = getCPUTimeUsec() - start;
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            pendingFrames.pop_front();
+            frame->clear();
+            freeFrames.push_back(frame);
+        }
+        queueCondition.notify_all();
+    }
+
+    renderVideoContext->makeCurrent(false);
+    return nullptr;
+}
+
+} // namespace brls
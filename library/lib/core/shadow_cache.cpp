@@ -0,0 +1,207 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <math.h>
+
+#include <algorithm>
+#include <borealis/core/application.hpp>
+#include <borealis/core/shadow_cache.hpp>
+
+namespace brls
+{
+
+// Textures bigger than that are not worth caching, the shadow is drawn by the caller
+static constexpr int MAX_TEXTURE_SIZE = 512;
+
+bool ShadowStyle::operator==(const ShadowStyle& other) const
+{
+    return this->cornerRadius == other.cornerRadius && this->width == other.width && this->feather == other.feather
+        && this->opacity == other.opacity && this->offset == other.offset;
+}
+
+// Signed distance to a rounded rectangle centered on 0, same as nanovg shaders
+static float sdRoundRect(float x, float y, float extentX, float extentY, float radius)
+{
+    float dx = fabsf(x) - (extentX - radius);
+    float dy = fabsf(y) - (extentY - radius);
+    return std::min(std::max(dx, dy), 0.0f) + hypotf(std::max(dx, 0.0f), std::max(dy, 0.0f)) - radius;
+}
+
+static float clamp01(float value)
+{
+    return std::min(std::max(value, 0.0f), 1.0f);
+}
+
+// Size of a quadrant inside and outside of the gradient corner, in pixels of the given scale.
+// Inside, it goes until the shadow doesn't change anymore along the sides
+// so that the middle of the texture can be stretched.
+static void getQuadrantSize(ShadowStyle style, float scale, int* inner, int* outer)
+{
+    float radius  = style.cornerRadius * 2;
+    float feather = std::max(1.0f, style.feather);
+
+    *inner = (int)ceilf(std::max({ feather / 2 - radius, style.width - style.cornerRadius, 0.0f }) * scale) + 2;
+    *outer = (int)ceilf((radius + feather / 2) * scale) + 1;
+}
+
+ShadowCache::Entry* ShadowCache::getEntry(NVGcontext* vg, ShadowStyle style, float scale)
+{
+    for (Entry& entry : ShadowCache::entries)
+    {
+        if (entry.style == style && entry.scale == scale)
+        {
+            entry.lastUse = ++ShadowCache::uses;
+            return &entry;
+        }
+    }
+
+    int inner, outer;
+    getQuadrantSize(style, scale, &inner, &outer);
+
+    int size = (inner + outer) * 2;
+    if (size > MAX_TEXTURE_SIZE)
+        return nullptr;
+
+    // Render the shadow of a view just big enough for the quadrants to meet,
+    // with the exact same gradient, hole and bounds as the stencil path
+    float radius   = style.cornerRadius * 2;
+    float feather  = std::max(1.0f, style.feather);
+    float extent   = radius + inner / scale; // half size of the view
+    float origin   = radius - outer / scale; // position of the first texel in the gradient box
+    float viewSize = extent * 2;
+
+    std::vector<unsigned char> pixels(size * size * 4, 0);
+
+    for (int j = 0; j < size; j++)
+    {
+        float y = origin + (j + 0.5f) / scale;
+
+        for (int i = 0; i < size; i++)
+        {
+            float x = origin + (i + 0.5f) / scale;
+
+            float gradient = 1.0f - clamp01((sdRoundRect(x - extent, y - extent, extent, extent, radius) + feather / 2) / feather);
+
+            // The gradient box is the view moved down by the shadow width
+            float viewY   = y + style.width;
+            float outside = clamp01(sdRoundRect(x - extent, viewY - extent, extent, extent, style.cornerRadius) * scale + 0.5f);
+            float bounds  = std::min({ x + style.offset, viewSize + style.offset - x, viewY + style.offset, viewSize + style.offset * 2 - viewY });
+
+            float alpha = style.opacity * gradient * outside * clamp01(bounds * scale + 0.5f);
+
+            pixels[(j * size + i) * 4 + 3] = (unsigned char)(alpha * 255.0f + 0.5f);
+        }
+    }
+
+    int image = nvgCreateImageRGBA(vg, size, size, 0, pixels.data());
+    if (image == 0)
+        return nullptr;
+
+    if (ShadowCache::entries.size() >= MAX_ENTRIES)
+    {
+        auto oldest = std::min_element(ShadowCache::entries.begin(), ShadowCache::entries.end(), [](const Entry& a, const Entry& b)
+            { return a.lastUse < b.lastUse; });
+
+        // Shadows drawn earlier in the frame may still use it
+        ShadowCache::retiredImages.push_back(oldest->image);
+        ShadowCache::entries.erase(oldest);
+    }
+
+    ShadowCache::entries.push_back({ style, scale, image, inner, outer, ++ShadowCache::uses });
+    return &ShadowCache::entries.back();
+}
+
+bool ShadowCache::draw(NVGcontext* vg, float x, float y, float width, float height, ShadowStyle style, float alpha)
+{
+    // Render at the resolution of the screen, same rounding as nanovg fonts
+    float scale = Application::windowScale * Application::getPlatform()->getVideoContext()->getScaleFactor();
+    scale       = std::max(((int)(scale / 0.01f + 0.5f)) * 0.01f, 0.01f);
+
+    float radius = style.cornerRadius * 2;
+
+    int inner, outer;
+    getQuadrantSize(style, scale, &inner, &outer);
+
+    float corner = radius + inner / scale;
+    if (width < corner * 2 || height < corner * 2)
+        return false;
+
+    Entry* entry = ShadowCache::getEntry(vg, style, scale);
+    if (!entry)
+        return false;
+
+    float size     = (inner + outer) * 2;
+    float quadrant = inner + outer;
+    float boxY     = y + style.width;
+
+    // Slices edges in the view and in the texture, the middle texels are stretched
+    float xs[4]    = { x + radius - outer / scale, x + corner, x + width - corner, x + width - radius + outer / scale };
+    float ys[4]    = { boxY + radius - outer / scale, boxY + corner, boxY + height - corner, boxY + height - radius + outer / scale };
+    float ts[3][2] = { { 0.0f, quadrant }, { quadrant - 0.5f, quadrant + 0.5f }, { quadrant, size } };
+
+    nvgSave(vg);
+
+    // Adjacent slices must not blend their edges together
+    nvgShapeAntiAlias(vg, 0);
+
+    for (int j = 0; j < 3; j++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            // The middle is inside of the view
+            if (i == 1 && j == 1)
+                continue;
+
+            float x0 = xs[i], x1 = xs[i + 1];
+            float y0 = ys[j], y1 = ys[j + 1];
+
+            if (x1 <= x0 || y1 <= y0)
+                continue;
+
+            float scaleX = (x1 - x0) / (ts[i][1] - ts[i][0]);
+            float scaleY = (y1 - y0) / (ts[j][1] - ts[j][0]);
+
+            NVGpaint paint = nvgImagePattern(vg, x0 - ts[i][0] * scaleX, y0 - ts[j][0] * scaleY, size * scaleX, size * scaleY, 0, entry->image, alpha);
+
+            nvgBeginPath(vg);
+            nvgRect(vg, x0, y0, x1 - x0, y1 - y0);
+            nvgFillPaint(vg, paint);
+            nvgFill(vg);
+        }
+    }
+
+    nvgRestore(vg);
+
+    return true;
+}
+
+void ShadowCache::clear()
+{
+    for (Entry& entry : ShadowCache::entries)
+        ShadowCache::retiredImages.push_back(entry.image);
+
+    ShadowCache::entries.clear();
+}
+
+void ShadowCache::endFrame(NVGcontext* vg)
+{
+    for (int image : ShadowCache::retiredImages)
+        nvgDeleteImage(vg, image);
+
+    ShadowCache::retiredImages.clear();
+}
+
+} // namespace brls
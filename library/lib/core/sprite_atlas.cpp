@@ -0,0 +1,395 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/application.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/sprite_atlas.hpp>
+#include <climits>
+#include <cstring>
+
+namespace brls
+{
+
+void SpriteAtlas::setEnabled(bool enabled)
+{
+    SpriteAtlas::enabled = enabled;
+}
+
+bool SpriteAtlas::isEnabled()
+{
+    return SpriteAtlas::enabled;
+}
+
+bool SpriteAtlas::isSprite(size_t value)
+{
+    return (value & HANDLE_FLAG) != 0;
+}
+
+const SpriteAtlas::Sprite* SpriteAtlas::get(int handle)
+{
+    if (!isSprite(handle))
+        return nullptr;
+
+    size_t index = handle & ~HANDLE_FLAG;
+    if (index >= SpriteAtlas::entries.size() || SpriteAtlas::entries[index].page < 0)
+        return nullptr;
+
+    return &SpriteAtlas::entries[index].sprite;
+}
+
+SpriteAtlasStats SpriteAtlas::getStats()
+{
+    SpriteAtlasStats stats = { 0, 0, SpriteAtlas::compactions, 0 };
+
+    for (Page& page : SpriteAtlas::pages)
+    {
+        if (page.image == 0)
+            continue;
+
+        stats.pages++;
+        stats.sprites += page.sprites;
+        stats.bytes += (size_t)PAGE_SIZE * PAGE_SIZE * 4;
+    }
+
+    for (Entry& entry : SpriteAtlas::entries)
+        stats.bytes += entry.pixels.size();
+
+    return stats;
+}
+
+int SpriteAtlas::createPage(NVGcontext* vg)
+{
+    // Reuse the slot of a deleted page, entries refer to pages by index
+    size_t index = 0;
+    while (index < SpriteAtlas::pages.size() && SpriteAtlas::pages[index].image != 0)
+        index++;
+
+    if (index == SpriteAtlas::pages.size())
+        SpriteAtlas::pages.emplace_back();
+
+    // Left uninitialized, only the packed sprites and their border are ever sampled
+    Page& page = SpriteAtlas::pages[index];
+    page.image = nvgCreateImageRGBA(vg, PAGE_SIZE, PAGE_SIZE, 0, nullptr);
+
+    if (page.image == 0)
+    {
+        Logger::error("SpriteAtlas: cannot create page texture");
+        return -1;
+    }
+
+    page.skyline  = { { 0, 0, PAGE_SIZE } };
+    page.sprites  = 0;
+    page.usedArea = 0;
+
+    return index;
+}
+
+void SpriteAtlas::deletePage(NVGcontext* vg, int index)
+{
+    Page& page = SpriteAtlas::pages[index];
+
+    // The current frame may still draw from it
+    SpriteAtlas::retiredImages.push_back(page.image);
+
+    page.image   = 0;
+    page.skyline = {};
+}
+
+// Returns the lowest y at which a rectangle fits on top of the skyline starting at the given node, or -1
+int SpriteAtlas::fit(const Page& page, size_t index, int width, int height)
+{
+    const std::vector<SkylineNode>& skyline = page.skyline;
+
+    if (skyline[index].x + width > PAGE_SIZE)
+        return -1;
+
+    int y         = 0;
+    int remaining = width;
+
+    for (size_t i = index; remaining > 0; i++)
+    {
+        if (i == skyline.size())
+            return -1;
+
+        y = std::max(y, skyline[i].y);
+        if (y + height > PAGE_SIZE)
+            return -1;
+
+        remaining -= skyline[i].width;
+    }
+
+    return y;
+}
+
+bool SpriteAtlas::pack(Page* page, int width, int height, int* x, int* y)
+{
+    std::vector<SkylineNode>& skyline = page->skyline;
+
+    int bestIndex = -1, bestBottom = INT_MAX, bestWidth = INT_MAX;
+
+    // Bottom-left: the position that leaves the lowest skyline
+    for (size_t i = 0; i < skyline.size(); i++)
+    {
+        int nodeY = fit(*page, i, width, height);
+        if (nodeY < 0)
+            continue;
+
+        if (nodeY + height < bestBottom || (nodeY + height == bestBottom && skyline[i].width < bestWidth))
+        {
+            bestIndex  = i;
+            bestBottom = nodeY + height;
+            bestWidth  = skyline[i].width;
+            *x         = skyline[i].x;
+            *y         = nodeY;
+        }
+    }
+
+    if (bestIndex < 0)
+        return false;
+
+    skyline.insert(skyline.begin() + bestIndex, { *x, bestBottom, width });
+
+    // Shrink or remove the nodes now under the new one
+    for (size_t i = bestIndex + 1; i < skyline.size(); i++)
+    {
+        int overlap = skyline[i - 1].x + skyline[i - 1].width - skyline[i].x;
+        if (overlap <= 0)
+            break;
+
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+
+        if (skyline[i].width > 0)
+            break;
+
+        skyline.erase(skyline.begin() + i);
+        i--;
+    }
+
+    // Merge the nodes at the same height
+    for (size_t i = 0; i + 1 < skyline.size(); i++)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+            i--;
+        }
+    }
+
+    return true;
+}
+
+bool SpriteAtlas::insert(NVGcontext* vg, int pageIndex, int entryIndex)
+{
+    Page& page   = SpriteAtlas::pages[pageIndex];
+    Entry& entry = SpriteAtlas::entries[entryIndex];
+
+    int width        = entry.sprite.width;
+    int height       = entry.sprite.height;
+    int paddedWidth  = width + BORDER * 2;
+    int paddedHeight = height + BORDER * 2;
+    int x, y;
+
+    if (page.image == 0 || !pack(&page, paddedWidth, paddedHeight, &x, &y))
+        return false;
+
+    // Upload the sprite alone, repeating its edges in the border
+    std::vector<unsigned char> padded((size_t)paddedWidth * paddedHeight * 4);
+
+    for (int j = 0; j < paddedHeight; j++)
+    {
+        int srcY                 = std::min(std::max(j - BORDER, 0), height - 1);
+        const unsigned char* src = entry.pixels.data() + (size_t)srcY * width * 4;
+        unsigned char* dst       = padded.data() + (size_t)j * paddedWidth * 4;
+
+        memcpy(dst, src, BORDER * 4);
+        memcpy(dst + BORDER * 4, src, width * 4);
+        memcpy(dst + (BORDER + width) * 4, src + (width - 1) * 4, BORDER * 4);
+    }
+
+    nvgUpdateImageRegion(vg, page.image, x, y, paddedWidth, paddedHeight, padded.data());
+
+    page.sprites++;
+    page.usedArea += paddedWidth * paddedHeight;
+
+    entry.sprite = { page.image, x + BORDER, y + BORDER, width, height, PAGE_SIZE };
+    entry.page   = pageIndex;
+
+    return true;
+}
+
+void SpriteAtlas::compact(NVGcontext* vg)
+{
+    std::vector<bool> fragmented(SpriteAtlas::pages.size(), false);
+    bool found = false;
+
+    for (size_t i = 0; i < SpriteAtlas::pages.size(); i++)
+    {
+        Page& page = SpriteAtlas::pages[i];
+
+        if (page.image != 0 && page.usedArea < PAGE_SIZE * PAGE_SIZE * COMPACT_THRESHOLD)
+            fragmented[i] = found = true;
+    }
+
+    if (!found)
+        return;
+
+    // Take the sprites out of the fragmented pages, tallest first for a tighter packing
+    std::vector<int> moved;
+
+    for (size_t i = 0; i < SpriteAtlas::entries.size(); i++)
+    {
+        Entry& entry = SpriteAtlas::entries[i];
+        if (entry.page < 0 || !fragmented[entry.page])
+            continue;
+
+        moved.push_back(i);
+        entry.page = -1;
+    }
+
+    std::sort(moved.begin(), moved.end(), [](int a, int b)
+        { return SpriteAtlas::entries[a].sprite.height > SpriteAtlas::entries[b].sprite.height; });
+
+    for (size_t i = 0; i < fragmented.size(); i++)
+    {
+        if (fragmented[i])
+            deletePage(vg, i);
+    }
+
+    for (int entry : moved)
+    {
+        bool inserted = false;
+
+        for (size_t i = 0; i < SpriteAtlas::pages.size() && !inserted; i++)
+            inserted = insert(vg, i, entry);
+
+        if (!inserted)
+        {
+            int page = createPage(vg);
+            inserted = page >= 0 && insert(vg, page, entry);
+        }
+
+        // Only if a page texture cannot be created, the sprite then stays invisible until released
+        if (!inserted)
+            Logger::error("SpriteAtlas: cannot move sprite {}", entry);
+    }
+
+    SpriteAtlas::compactions++;
+    Logger::debug("SpriteAtlas: compacted {} sprites", moved.size());
+}
+
+int SpriteAtlas::add(NVGcontext* vg, const unsigned char* pixels, int width, int height)
+{
+    if (!SpriteAtlas::enabled || width <= 0 || height <= 0 || width > MAX_SPRITE_SIZE || height > MAX_SPRITE_SIZE)
+        return 0;
+
+    int index;
+    if (!SpriteAtlas::freeEntries.empty())
+    {
+        index = SpriteAtlas::freeEntries.back();
+        SpriteAtlas::freeEntries.pop_back();
+    }
+    else
+    {
+        index = SpriteAtlas::entries.size();
+        SpriteAtlas::entries.push_back({ {}, -1, false, {} });
+    }
+
+    Entry& entry        = SpriteAtlas::entries[index];
+    entry.used          = true;
+    entry.sprite.width  = width;
+    entry.sprite.height = height;
+    entry.pixels.assign(pixels, pixels + (size_t)width * height * 4);
+
+    bool inserted = false;
+
+    for (size_t i = 0; i < SpriteAtlas::pages.size() && !inserted; i++)
+        inserted = insert(vg, i, index);
+
+    // Make room in the existing pages before creating a new one
+    if (!inserted)
+    {
+        compact(vg);
+
+        for (size_t i = 0; i < SpriteAtlas::pages.size() && !inserted; i++)
+            inserted = insert(vg, i, index);
+    }
+
+    if (!inserted)
+    {
+        int page = createPage(vg);
+        inserted = page >= 0 && insert(vg, page, index);
+    }
+
+    if (!inserted)
+    {
+        SpriteAtlas::entries[index].used   = false;
+        SpriteAtlas::entries[index].pixels = {};
+        SpriteAtlas::freeEntries.push_back(index);
+        return 0;
+    }
+
+    return HANDLE_FLAG | index;
+}
+
+int SpriteAtlas::createTexture(NVGcontext* vg, int handle)
+{
+    const Sprite* sprite = get(handle);
+    if (!sprite)
+        return 0;
+
+    const Entry& entry = SpriteAtlas::entries[handle & ~HANDLE_FLAG];
+    return nvgCreateImageRGBA(vg, sprite->width, sprite->height, 0, entry.pixels.data());
+}
+
+void SpriteAtlas::endFrame(NVGcontext* vg)
+{
+    for (int image : SpriteAtlas::retiredImages)
+        nvgDeleteImage(vg, image);
+
+    SpriteAtlas::retiredImages.clear();
+}
+
+void SpriteAtlas::release(int handle)
+{
+    if (!isSprite(handle))
+        return;
+
+    size_t index = handle & ~HANDLE_FLAG;
+    if (index >= SpriteAtlas::entries.size() || !SpriteAtlas::entries[index].used)
+        return;
+
+    Entry& entry = SpriteAtlas::entries[index];
+
+    if (entry.page >= 0)
+    {
+        Page& page = SpriteAtlas::pages[entry.page];
+        page.sprites--;
+        page.usedArea -= (entry.sprite.width + BORDER * 2) * (entry.sprite.height + BORDER * 2);
+
+        if (page.sprites == 0)
+            deletePage(Application::getNVGContext(), entry.page);
+    }
+
+    entry.page   = -1;
+    entry.used   = false;
+    entry.pixels = {};
+    SpriteAtlas::freeEntries.push_back(index);
+}
+
+} // namespace brls
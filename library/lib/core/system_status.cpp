@@ -0,0 +1,312 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/system_status.hpp>
+#include <borealis/core/thread.hpp>
+#include <chrono>
+
+#ifdef BOREALIS_USE_STD_THREAD
+#include <thread>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __SWITCH__
+extern "C"
+{
+#include <switch/services/nifm.h>
+}
+#endif
+
+#if defined(__linux__) && !defined(ANDROID)
+#define SYSTEM_STATUS_NETLINK
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace brls
+{
+
+bool SystemStatus::operator==(const SystemStatus& other) const
+{
+    return this->batteryAvailable == other.batteryAvailable
+        && this->batteryLevel == other.batteryLevel
+        && this->batteryCharging == other.batteryCharging
+        && this->wirelessAvailable == other.wirelessAvailable
+        && this->wirelessConnected == other.wirelessConnected
+        && this->wirelessLevel == other.wirelessLevel
+        && this->ethernetConnected == other.ethernetConnected;
+}
+
+bool SystemStatus::operator!=(const SystemStatus& other) const
+{
+    return !(*this == other);
+}
+
+#ifdef BOREALIS_USE_STD_THREAD
+static std::thread* serviceThread = nullptr;
+#else
+static pthread_t serviceThread = pthread_t(0);
+#endif
+
+#ifdef SYSTEM_STATUS_NETLINK
+// Wakes the service up as soon as a network link or address changes,
+// or the kernel reports a power supply event (charger plugged, battery level)
+static int routeSocket   = -1;
+static int ueventSocket  = -1;
+static int wakeUpPipe[2] = { -1, -1 };
+
+static int openNetlink(int protocol, uint32_t groups)
+{
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, protocol);
+    if (fd < 0)
+        return -1;
+
+    struct sockaddr_nl addr = {};
+    addr.nl_family          = AF_NETLINK;
+    addr.nl_groups          = groups;
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static void drain(int fd)
+{
+    char buffer[4096];
+    while (read(fd, buffer, sizeof(buffer)) > 0)
+        ;
+}
+
+static void closeFd(int* fd)
+{
+    if (*fd >= 0)
+        close(*fd);
+    *fd = -1;
+}
+#endif
+
+std::shared_ptr<const SystemStatus> SystemStatusService::getSnapshot()
+{
+    std::lock_guard<std::mutex> lock(SystemStatusService::mutex);
+    return SystemStatusService::snapshot;
+}
+
+SystemStatusEvent::Subscription SystemStatusService::subscribe(SystemStatusEvent::Callback callback)
+{
+    SystemStatusService::start();
+    return SystemStatusService::changeEvent.subscribe(callback);
+}
+
+void SystemStatusService::unsubscribe(SystemStatusEvent::Subscription subscription)
+{
+    SystemStatusService::changeEvent.unsubscribe(subscription);
+}
+
+void SystemStatusService::refresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(SystemStatusService::mutex);
+        SystemStatusService::refreshPending = true;
+    }
+
+#ifdef SYSTEM_STATUS_NETLINK
+    if (wakeUpPipe[1] >= 0)
+    {
+        char byte = 0;
+        (void)!write(wakeUpPipe[1], &byte, 1);
+    }
+#endif
+    SystemStatusService::wakeUp.notify_all();
+}
+
+void SystemStatusService::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(SystemStatusService::mutex);
+        if (SystemStatusService::running)
+            return;
+        SystemStatusService::running        = true;
+        SystemStatusService::refreshPending = false;
+    }
+
+#ifdef SYSTEM_STATUS_NETLINK
+    routeSocket  = openNetlink(NETLINK_ROUTE, RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR);
+    ueventSocket = openNetlink(NETLINK_KOBJECT_UEVENT, 1);
+    if (pipe2(wakeUpPipe, O_CLOEXEC | O_NONBLOCK) != 0)
+        wakeUpPipe[0] = wakeUpPipe[1] = -1;
+#endif
+
+#ifdef BOREALIS_USE_STD_THREAD
+    serviceThread = new std::thread(&SystemStatusService::serviceTask, nullptr);
+#else
+    pthread_create(&serviceThread, NULL, &SystemStatusService::serviceTask, NULL);
+#endif
+}
+
+void SystemStatusService::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(SystemStatusService::mutex);
+        if (!SystemStatusService::running)
+            return;
+        SystemStatusService::running = false;
+    }
+
+    SystemStatusService::refresh();
+
+#ifdef BOREALIS_USE_STD_THREAD
+    serviceThread->join();
+    delete serviceThread;
+    serviceThread = nullptr;
+#else
+    pthread_join(serviceThread, NULL);
+#endif
+
+#ifdef SYSTEM_STATUS_NETLINK
+    closeFd(&routeSocket);
+    closeFd(&ueventSocket);
+    closeFd(&wakeUpPipe[0]);
+    closeFd(&wakeUpPipe[1]);
+#endif
+}
+
+SystemStatus SystemStatusService::query()
+{
+    SystemStatus status;
+    Platform* platform = Application::getPlatform();
+
+    status.batteryAvailable = platform->canShowBatteryLevel();
+    if (status.batteryAvailable)
+    {
+        status.batteryLevel    = platform->getBatteryLevel();
+        status.batteryCharging = platform->isBatteryCharging();
+    }
+
+    status.wirelessAvailable = platform->canShowWirelessLevel();
+    if (status.wirelessAvailable)
+    {
+#ifdef __SWITCH__
+        // Reduce service calls
+        // and fix support for emulator (Ryujinx) as it doesn't support :
+        // nifmIsWirelessCommunicationEnabled() / nifmIsEthernetCommunicationEnabled().
+        NifmInternetConnectionType type;
+        u32 wifiSignal;
+        NifmInternetConnectionStatus connectionStatus;
+        if (nifmGetInternetConnectionStatus(&type, &wifiSignal, &connectionStatus) == 0)
+        {
+            status.ethernetConnected = type == NifmInternetConnectionType_Ethernet;
+            status.wirelessConnected = type == NifmInternetConnectionType_WiFi;
+            status.wirelessLevel     = (int)wifiSignal;
+        }
+        else
+        {
+            status.ethernetConnected = false;
+            status.wirelessConnected = false;
+            status.wirelessLevel     = 0;
+        }
+#else
+        status.ethernetConnected = platform->hasEthernetConnection();
+        status.wirelessConnected = platform->hasWirelessConnection();
+        status.wirelessLevel     = platform->getWirelessLevel();
+#endif
+    }
+
+    return status;
+}
+
+void SystemStatusService::publish(const SystemStatus& status)
+{
+    std::shared_ptr<const SystemStatus> published;
+
+    {
+        std::lock_guard<std::mutex> lock(SystemStatusService::mutex);
+        if (*SystemStatusService::snapshot == status)
+            return;
+
+        published                     = std::make_shared<const SystemStatus>(status);
+        SystemStatusService::snapshot = published;
+    }
+
+    Logger::verbose("System status: battery {}% (charging: {}); wireless: {} (level {}); ethernet: {}",
+        status.batteryLevel, status.batteryCharging, status.wirelessConnected, status.wirelessLevel, status.ethernetConnected);
+
+    brls::sync([published]()
+        { SystemStatusService::changeEvent.fire(published); });
+}
+
+void* SystemStatusService::serviceTask(void* arg)
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(SystemStatusService::mutex);
+            if (!SystemStatusService::running)
+                break;
+            SystemStatusService::refreshPending = false;
+        }
+
+#ifdef ANDROID
+        // The platform calls into Java, which is only attached to the UI thread
+        brls::sync([]()
+            { SystemStatusService::publish(SystemStatusService::query()); });
+#else
+        SystemStatusService::publish(SystemStatusService::query());
+#endif
+
+#ifdef SYSTEM_STATUS_NETLINK
+        if (wakeUpPipe[0] >= 0)
+        {
+            struct pollfd fds[3] = {
+                { wakeUpPipe[0], POLLIN, 0 },
+                { routeSocket, POLLIN, 0 },
+                { ueventSocket, POLLIN, 0 },
+            };
+
+            if (poll(fds, 3, (int)POLL_INTERVAL) > 0)
+            {
+                // Events come in bursts (link, then addresses), give the system a moment to settle
+                if (!(fds[0].revents & POLLIN))
+                    poll(fds, 1, 200);
+
+                for (const struct pollfd& fd : fds)
+                {
+                    if (fd.fd >= 0)
+                        drain(fd.fd);
+                }
+            }
+            continue;
+        }
+#endif
+
+        std::unique_lock<std::mutex> lock(SystemStatusService::mutex);
+        SystemStatusService::wakeUp.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL), []()
+            { return !SystemStatusService::running || SystemStatusService::refreshPending; });
+    }
+
+    return nullptr;
+}
+
+} // namespace brls
@@ -15,13 +15,37 @@
     limitations under the License.
 */
 
+#include <atomic>
+#include <borealis/core/asset_store.hpp>
+#include <borealis/core/logger.hpp>
 #include <borealis/core/theme.hpp>
 #include <borealis/core/util.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <nlohmann/json.hpp>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace brls
 {
 
+// Color names registry, shared by all the palettes. Names are only added
+// the first time they are looked up, so readers share the lock.
+struct ThemeColorNames
+{
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, ThemeColor> ids;
+    std::vector<std::string> names;
+};
+
+static ThemeColorNames& getColorNames()
+{
+    static ThemeColorNames colorNames;
+    return colorNames;
+}
+
+static std::atomic<uint64_t> themeGeneration = 0;
+
 static ThemeValues lightThemeValues = {
     // Generic values
     { "brls/clear", nvgRGB(235, 235, 235) },
@@ -142,20 +166,40 @@ static ThemeValues darkThemeValues = {
 ThemeValues::ThemeValues(std::initializer_list<std::pair<std::string, NVGcolor>> list)
 {
     for (std::pair<std::string, NVGcolor> color : list)
-        this->values.insert(color);
+        this->addColor(color.first, color.second);
 }
 
 void ThemeValues::addColor(const std::string& name, NVGcolor color)
 {
-        this->values[name] = color;
+    this->addColor(Theme::color(name), color);
+}
+
+void ThemeValues::addColor(ThemeColor id, NVGcolor color)
+{
+    if (id >= this->palette.size())
+    {
+        this->palette.resize(id + 1);
+        this->defined.resize(id + 1, false);
+    }
+
+    this->palette[id] = color;
+    this->defined[id] = true;
+    themeGeneration++;
 }
 
 NVGcolor ThemeValues::getColor(const std::string& name)
 {
-    if (this->values.count(name) == 0)
-        fatal("Unknown theme value \"" + name + "\" in size: " + std::to_string(this->values.size()));
+    return this->getColor(Theme::color(name));
+}
 
-    return this->values[name];
+bool ThemeValues::hasColor(ThemeColor id)
+{
+    return id < this->defined.size() && this->defined[id];
+}
+
+void ThemeValues::unknownColor(ThemeColor id)
+{
+    fatal("Unknown theme value \"" + Theme::colorName(id) + "\" in size: " + std::to_string(this->palette.size()));
 }
 
 Theme::Theme(ThemeValues* values)
@@ -178,6 +222,117 @@ NVGcolor Theme::operator[](const std::string& name)
     return this->getColor(name);
 }
 
+ThemeColor Theme::color(const std::string& name)
+{
+    ThemeColorNames& colorNames = getColorNames();
+
+    {
+        std::shared_lock<std::shared_mutex> lock(colorNames.mutex);
+
+        auto it = colorNames.ids.find(name);
+        if (it != colorNames.ids.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(colorNames.mutex);
+
+    // Added by another thread in the meantime
+    auto it = colorNames.ids.find(name);
+    if (it != colorNames.ids.end())
+        return it->second;
+
+    ThemeColor id = (ThemeColor)colorNames.names.size();
+    colorNames.names.push_back(name);
+    colorNames.ids[name] = id;
+    return id;
+}
+
+std::string Theme::colorName(ThemeColor id)
+{
+    ThemeColorNames& colorNames = getColorNames();
+    std::shared_lock<std::shared_mutex> lock(colorNames.mutex);
+
+    if (id >= colorNames.names.size())
+        return "#" + std::to_string(id);
+
+    return colorNames.names[id];
+}
+
+static bool parseColor(const std::string& value, NVGcolor* color)
+{
+    if ((value.size() != 7 && value.size() != 9) || value[0] != '#')
+        return false;
+
+    unsigned int channels[4] = { 0, 0, 0, 255 };
+    for (size_t i = 0; i < (value.size() - 1) / 2; i++)
+    {
+        char* end;
+        std::string channel = value.substr(1 + i * 2, 2);
+        channels[i]         = (unsigned int)strtoul(channel.c_str(), &end, 16);
+        if (*end != '\0')
+            return false;
+    }
+
+    *color = nvgRGBA(channels[0], channels[1], channels[2], channels[3]);
+    return true;
+}
+
+bool Theme::loadFromJSON(const char* data, size_t size)
+{
+    std::vector<std::pair<ThemeColor, NVGcolor>> lightColors, darkColors;
+
+    try
+    {
+        nlohmann::json json = nlohmann::json::parse(data, data + size);
+
+        for (auto& [variant, colors] : { std::make_pair("light", &lightColors), std::make_pair("dark", &darkColors) })
+        {
+            if (!json.contains(variant))
+                continue;
+
+            for (auto& [name, value] : json.at(variant).items())
+            {
+                NVGcolor color;
+                if (!parseColor(value.get<std::string>(), &color))
+                {
+                    Logger::error("Invalid theme color \"{}\" for {}", value.get<std::string>(), name);
+                    return false;
+                }
+                colors->emplace_back(Theme::color(name), color);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Logger::error("Cannot load theme: {}", e.what());
+        return false;
+    }
+
+    for (auto& [id, color] : lightColors)
+        lightThemeValues.addColor(id, color);
+    for (auto& [id, color] : darkColors)
+        darkThemeValues.addColor(id, color);
+
+    return true;
+}
+
+bool Theme::loadFromFile(const std::string& path)
+{
+    std::shared_ptr<Asset> asset = AssetStore::open(path);
+    if (!asset)
+    {
+        Logger::error("Cannot load theme: {} not found", path);
+        return false;
+    }
+
+    return Theme::loadFromJSON((const char*)asset->data(), asset->size());
+}
+
+uint64_t Theme::getGeneration()
+{
+    return themeGeneration;
+}
+
 Theme& Theme::getLightTheme()
 {
     static Theme lightTheme(&lightThemeValues);
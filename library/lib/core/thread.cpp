@@ -18,6 +18,7 @@
 
 #include <borealis/core/logger.hpp>
 #include <borealis/core/thread.hpp>
+#include <borealis/core/trace.hpp>
 #include <exception>
 
 #ifdef BOREALIS_USE_STD_THREAD
@@ -26,10 +27,6 @@
 #include <pthread.h>
 #endif
 
-#ifdef PS4
-#include <orbis/libkernel.h>
-#endif
-
 namespace brls
 {
 
@@ -76,19 +73,32 @@ void Threading::async(const std::function<void()>& task)
     m_async_tasks.push_back(task);
 }
 
+size_t Threading::getSyncTasksCount()
+{
+    std::lock_guard<std::mutex> guard(m_sync_mutex);
+    return m_sync_functions.size();
+}
+
+size_t Threading::getAsyncTasksCount()
+{
+    std::lock_guard<std::mutex> guard(m_async_mutex);
+    return m_async_tasks.size();
+}
+
+size_t Threading::getDelayTasksCount()
+{
+    std::lock_guard<std::mutex> guard(m_delay_mutex);
+    return m_delay_tasks.size();
+}
+
 size_t Threading::delay(long milliseconds, const std::function<void()>& func)
 {
     std::lock_guard<std::mutex> guard(m_delay_mutex);
     DelayOperation operation;
-#ifdef PS4
-    operation.startPoint        = sceKernelGetProcessTime();
-    operation.delayMilliseconds = milliseconds * 1000;
-#else
-    operation.startPoint        = std::chrono::high_resolution_clock::now();
-    operation.delayMilliseconds = milliseconds;
-#endif
-    operation.func              = func;
-    operation.index             = ++m_delay_index;
+    operation.startPoint = getUITimeUsec();
+    operation.delay      = (Time)milliseconds * 1000;
+    operation.func       = func;
+    operation.index      = ++m_delay_index;
     m_delay_tasks.push_back(operation);
     return m_delay_index;
 }
@@ -101,6 +111,8 @@ void Threading::cancelDelay(size_t iter)
 
 void Threading::performSyncTasks()
 {
+    BRLS_TRACE_SCOPE("sync_tasks");
+
     m_sync_mutex.lock();
     auto local = m_sync_functions;
     m_sync_functions.clear();
@@ -110,6 +122,7 @@ void Threading::performSyncTasks()
     {
         try
         {
+            BRLS_TRACE_SCOPE("sync_task");
             f();
         }
         catch (std::exception& e)
@@ -135,14 +148,8 @@ void Threading::performSyncTasks()
         }
         m_delay_mutex.unlock();
 
-#ifdef PS4
-        uint64_t duration = sceKernelGetProcessTime() - d.startPoint;
-#else
-        auto timeNow  = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(timeNow - d.startPoint).count();
-#endif
-
-        if (duration >= d.delayMilliseconds)
+        // Follows the recorded clock during input replays
+        if (getUITimeUsec() - d.startPoint >= d.delay)
         {
             try
             {
@@ -190,6 +197,8 @@ void Threading::std_task_loop() {
 }
 void* Threading::task_loop(void* a)
 {
+    BRLS_TRACE_THREAD_NAME("tasks");
+
     while (task_loop_active)
     {
         std::vector<std::function<void()>> m_tasks_copy;
@@ -201,6 +210,7 @@ void* Threading::task_loop(void* a)
 
         for (auto task : m_tasks_copy)
         {
+            BRLS_TRACE_SCOPE("task");
             task();
         }
 
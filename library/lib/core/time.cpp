@@ -14,35 +14,70 @@
     limitations under the License.
 */
 
+#include <atomic>
 #include <borealis/core/time.hpp>
 
 namespace brls
 {
 
-void Ticking::updateTickings()
+static std::atomic<Time> uiTimeOverride = 0;
+
+Time getUITimeUsec()
+{
+    Time time = uiTimeOverride.load(std::memory_order_relaxed);
+    return time != 0 ? time : getCPUTimeUsec();
+}
+
+void setUITimeOverride(Time time)
+{
+    uiTimeOverride.store(time, std::memory_order_relaxed);
+}
+
+void Ticking::updateTickings(Time now)
 {
     // Update time
     static Time previousTime = 0;
 
-    Time currentTime = getCPUTimeUsec() / 1000;
-    Time delta       = previousTime == 0 ? 0 : currentTime - previousTime;
+    // Tickings work with milliseconds, rounding the timestamps keeps the deltas from drifting
+    Time delta = previousTime == 0 ? 0 : now / 1000 - previousTime / 1000;
 
-    previousTime = currentTime;
+    previousTime = now;
 
     // Update every running ticking, kill them and execute cb if they are finished
-    // We have to clone the running tickings list to avoid altering it while
-    // in the for loop (so if another ticking is started in a callback or during onUpdate())
-    std::vector<Ticking*> tickings(Ticking::runningTickings);
+    // Tickings started during the loop (in a callback or during onUpdate()) are appended
+    // and only updated next frame, stopped ones leave a nullptr behind
+    size_t count = Ticking::runningTickings.size();
 
-    for (Ticking* ticking : tickings)
+    for (size_t i = 0; i < count; i++)
     {
+        Ticking* ticking = Ticking::runningTickings[i];
+        if (!ticking)
+            continue;
+
         bool run = ticking->onUpdate(delta);
 
-        ticking->tickCallback();
+        ticking->tick();
 
         if (!run)
             ticking->stop(true); // will remove the ticking from Ticking::runningTickings
     }
+
+    // Remove the stopped tickings
+    size_t running = 0;
+    for (Ticking* ticking : Ticking::runningTickings)
+    {
+        if (!ticking)
+            continue;
+
+        ticking->runningIndex               = running;
+        Ticking::runningTickings[running++] = ticking;
+    }
+    Ticking::runningTickings.resize(running);
+}
+
+void Ticking::updateTickings()
+{
+    Ticking::updateTickings(getUITimeUsec());
 }
 
 void Ticking::start()
@@ -50,7 +85,7 @@ void Ticking::start()
     if (this->running)
         return;
 
-    Ticking::runningTickings.push_back(this);
+    this->schedule();
 
     this->running = true;
 
@@ -67,14 +102,7 @@ void Ticking::stop(bool finished)
     if (!this->running)
         return;
 
-    for (size_t i = 0; i < Ticking::runningTickings.size(); i++)
-    {
-        if (Ticking::runningTickings[i] == this)
-        {
-            Ticking::runningTickings.erase(Ticking::runningTickings.begin() + i);
-            break;
-        }
-    }
+    this->unschedule();
 
     this->running = false;
 
@@ -83,6 +111,28 @@ void Ticking::stop(bool finished)
     this->endCallback(finished);
 }
 
+void Ticking::schedule()
+{
+    this->runningIndex = Ticking::runningTickings.size();
+    Ticking::runningTickings.push_back(this);
+}
+
+void Ticking::unschedule()
+{
+    Ticking::runningTickings[this->runningIndex] = nullptr;
+}
+
+void Ticking::tick()
+{
+    if (this->tickCallback)
+        this->tickCallback();
+}
+
+bool Ticking::hasTickCallback()
+{
+    return (bool)this->tickCallback;
+}
+
 void Ticking::setEndCallback(TickingEndCallback endCallback)
 {
     this->endCallback = endCallback;
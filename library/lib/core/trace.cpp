@@ -0,0 +1,180 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/trace.hpp>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace brls
+{
+
+// Gives the buffer of a thread back to the tracer when the thread ends
+struct ThreadTraceBuffer
+{
+    TraceBuffer* buffer = nullptr;
+
+    ~ThreadTraceBuffer()
+    {
+        if (this->buffer)
+            Tracer::releaseThreadBuffer(this->buffer);
+    }
+};
+
+static thread_local ThreadTraceBuffer threadTraceBuffer;
+
+void TraceBuffer::push(const char* name, Time begin, Time end)
+{
+    size_t index = this->head.load(std::memory_order_relaxed);
+    Event& event = this->events[index % CAPACITY];
+
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(begin, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+
+    this->head.store(index + 1, std::memory_order_release);
+}
+
+TraceBuffer* Tracer::getThreadBuffer()
+{
+    if (threadTraceBuffer.buffer)
+        return threadTraceBuffer.buffer;
+
+    std::lock_guard<std::mutex> lock(Tracer::buffersMutex);
+
+    // Reuse the buffer of a thread that ended, its events are dropped
+    TraceBuffer* buffer = nullptr;
+    for (TraceBuffer* released : Tracer::buffers)
+    {
+        if (!released->owned)
+        {
+            buffer = released;
+            break;
+        }
+    }
+
+    if (!buffer)
+    {
+        buffer = new TraceBuffer();
+        Tracer::buffers.push_back(buffer);
+    }
+
+    buffer->owned    = true;
+    buffer->threadId = Tracer::nextThreadId++;
+    buffer->threadName.store(nullptr);
+    buffer->start.store(buffer->head.load());
+
+    threadTraceBuffer.buffer = buffer;
+    return buffer;
+}
+
+void Tracer::releaseThreadBuffer(TraceBuffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(Tracer::buffersMutex);
+    buffer->owned = false;
+}
+
+void Tracer::addEvent(const char* name, Time begin, Time end)
+{
+    Tracer::getThreadBuffer()->push(name, begin, end);
+}
+
+void Tracer::setThreadName(const char* name)
+{
+    Tracer::getThreadBuffer()->threadName.store(name);
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(Tracer::buffersMutex);
+
+    for (TraceBuffer* buffer : Tracer::buffers)
+        buffer->start.store(buffer->head.load());
+}
+
+std::string Tracer::toJSON()
+{
+    nlohmann::json events = nlohmann::json::array();
+
+    std::lock_guard<std::mutex> lock(Tracer::buffersMutex);
+
+    for (TraceBuffer* buffer : Tracer::buffers)
+    {
+        const char* threadName = buffer->threadName.load();
+        events.push_back({
+            { "name", "thread_name" },
+            { "ph", "M" },
+            { "pid", 1 },
+            { "tid", buffer->threadId },
+            { "args", { { "name", threadName ? threadName : "thread" } } },
+        });
+
+        size_t head  = buffer->head.load(std::memory_order_acquire);
+        size_t first = std::max(head > TraceBuffer::CAPACITY ? head - TraceBuffer::CAPACITY : 0, buffer->start.load());
+
+        size_t count = events.size();
+        for (size_t index = first; index < head; index++)
+        {
+            TraceBuffer::Event& event = buffer->events[index % TraceBuffer::CAPACITY];
+
+            Time begin = event.begin.load(std::memory_order_relaxed);
+            Time end   = event.end.load(std::memory_order_relaxed);
+
+            events.push_back({
+                { "name", event.name.load(std::memory_order_relaxed) },
+                { "cat", "borealis" },
+                { "ph", "X" },
+                { "ts", begin },
+                { "dur", end - begin },
+                { "pid", 1 },
+                { "tid", buffer->threadId },
+            });
+        }
+
+        // Drop the events the thread overwrote while they were being read
+        std::atomic_thread_fence(std::memory_order_acquire);
+        size_t newHead = buffer->head.load(std::memory_order_relaxed);
+        if (newHead - first > TraceBuffer::CAPACITY)
+        {
+            size_t overwritten = std::min(newHead - first - TraceBuffer::CAPACITY, head - first);
+            events.erase(events.begin() + count, events.begin() + count + overwritten);
+        }
+    }
+
+    nlohmann::json trace = {
+        { "traceEvents", events },
+        { "displayTimeUnit", "ms" },
+    };
+
+    return trace.dump();
+}
+
+bool Tracer::dump(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        Logger::error("Tracer: cannot write \"{}\"", path);
+        return false;
+    }
+
+    file << Tracer::toJSON();
+    Logger::info("Tracer: trace written to \"{}\"", path);
+    return true;
+}
+
+} // namespace brls
@@ -14,8 +14,8 @@
     limitations under the License.
 */
 
+#include <borealis/core/asset_store.hpp>
 #include <borealis/core/util.hpp>
-#include <fstream>
 
 namespace brls
 {
@@ -36,21 +36,16 @@ bool startsWith(const std::string& data, const std::string& prefix)
     throw std::logic_error(message);
 }
 
-std::string loadFileContents(const std::string &path) {
-    std::ifstream fin;
-    fin.open(path, std::ios::in);
-    if (!fin.is_open()) {
-      brls::Logger::error("cannot open file: {}", path);
-      return "";
-    }
-
-    std::string res, buff;
-    while (getline(fin, buff)) {
-        res += buff + "\n";
+std::string loadFileContents(const std::string& path)
+{
+    std::shared_ptr<Asset> asset = AssetStore::open(path);
+    if (!asset)
+    {
+        brls::Logger::error("cannot open file: {}", path);
+        return "";
     }
-    fin.close();
 
-    return res;
+    return std::string(asset->string());
 }
 
 } // namespace brls
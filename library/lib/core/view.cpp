@@ -22,19 +22,29 @@
 #include <sstream>
 #include <borealis/core/animation.hpp>
 #include <borealis/core/application.hpp>
+#include <borealis/core/asset_store.hpp>
 #include <borealis/core/box.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/input.hpp>
+#include <borealis/core/shadow_cache.hpp>
+#include <borealis/core/trace.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/core/view.hpp>
 #include <borealis/views/applet_frame.hpp>
-#include <fstream>
 
 using namespace brls::literals;
 
 namespace brls
 {
 
+// Colors drawn by every view, interned once
+static const ThemeColor CLICK_PULSE_COLOR          = Theme::color("brls/click_pulse");
+static const ThemeColor HIGHLIGHT_BACKGROUND_COLOR = Theme::color("brls/highlight/background");
+static const ThemeColor HIGHLIGHT_COLOR1           = Theme::color("brls/highlight/color1");
+static const ThemeColor HIGHLIGHT_COLOR2           = Theme::color("brls/highlight/color2");
+static const ThemeColor SIDEBAR_BACKGROUND_COLOR   = Theme::color("brls/sidebar/background");
+static const ThemeColor BACKDROP_COLOR             = Theme::color("brls/backdrop");
+
 void AppletFrameItem::setHintView(View* hintView)
 {
     this->hintView = hintView;
@@ -54,7 +64,7 @@ AppletFrameItem::~AppletFrameItem()
 View::View()
 {
     // Instantiate and prepare YGNode
-    this->ygNode = YGNodeNew();
+    this->ygNode = ViewPool::acquireNode();
     YGNodeSetContext(this->ygNode, this);
 
     YGNodeStyleSetWidthAuto(this->ygNode);
@@ -67,6 +77,8 @@ View::View()
     Style style = Application::getStyle();
 
     this->highlightCornerRadius = style["brls/highlight/corner_radius"];
+
+    ViewPool::viewCreated(this);
 }
 
 static int shakeAnimation(float t, float a) // a = amplitude
@@ -80,7 +92,7 @@ static int shakeAnimation(float t, float a) // a = amplitude
 void View::shakeHighlight(FocusDirection direction)
 {
     this->highlightShaking        = true;
-    this->highlightShakeStart     = getCPUTimeUsec() / 1000;
+    this->highlightShakeStart     = getUITimeUsec() / 1000;
     this->highlightShakeDirection = direction;
     this->highlightShakeAmplitude = std::rand() % 15 + 10;
 }
@@ -165,26 +177,7 @@ void View::frame(FrameContext* ctx)
 
     if (this->alpha > 0.0f && this->collapseState != 0.0f)
     {
-        // Draw background
-        this->drawBackground(ctx->vg, ctx, style, frame);
-
-        // Draw shadow
-        if (this->shadowType != ShadowType::NONE && (this->showShadow || Application::getInputType() == InputType::TOUCH))
-            this->drawShadow(ctx->vg, ctx, style, frame);
-
-        // Draw border
-        if (this->borderThickness > 0.0f)
-            this->drawBorder(ctx->vg, ctx, style, frame);
-
-        this->drawLine(ctx, frame);
-
-        // Draw highlight background
-        if (this->highlightAlpha > 0.0f && !this->hideHighlightBackground && !this->hideHighlight)
-            this->drawHighlight(ctx->vg, ctx->theme, this->highlightAlpha, style, true);
-
-        // Draw click animation
-        if (this->clickAlpha > 0.0f)
-            this->drawClickAnimation(ctx->vg, ctx, frame);
+        this->drawDecorations(ctx, style, frame);
 
         // Collapse clipping
         if (this->collapseState < 1.0f || this->clipsToBounds)
@@ -211,6 +204,30 @@ void View::frame(FrameContext* ctx)
     nvgRestore(ctx->vg);
 }
 
+void View::drawDecorations(FrameContext* ctx, Style style, Rect frame)
+{
+    // Draw background
+    this->drawBackground(ctx->vg, ctx, style, frame);
+
+    // Draw shadow
+    if (this->shadowType != ShadowType::NONE && (this->showShadow || Application::getInputType() == InputType::TOUCH))
+        this->drawShadow(ctx->vg, ctx, style, frame);
+
+    // Draw border
+    if (this->borderThickness > 0.0f)
+        this->drawBorder(ctx->vg, ctx, style, frame);
+
+    this->drawLine(ctx, frame);
+
+    // Draw highlight background
+    if (this->highlightAlpha > 0.0f && !this->hideHighlightBackground && !this->hideHighlight)
+        this->drawHighlight(ctx->vg, ctx->theme, this->highlightAlpha, style, true);
+
+    // Draw click animation
+    if (this->clickAlpha > 0.0f)
+        this->drawClickAnimation(ctx->vg, ctx, frame);
+}
+
 void View::frameHighlight(FrameContext* ctx)
 {
     if (this->alpha > 0.0f && this->collapseState != 0.0f && this->highlightAlpha > 0.0f && !this->hideHighlightBorder && !this->hideHighlight)
@@ -251,7 +268,7 @@ void View::playClickAnimation(bool reverse, bool animateBack, bool force)
 void View::drawClickAnimation(NVGcontext* vg, FrameContext* ctx, Rect frame)
 {
     Theme theme    = ctx->theme;
-    NVGcolor color = theme["brls/click_pulse"];
+    NVGcolor color = theme[CLICK_PULSE_COLOR];
 
     color.a *= this->clickAlpha;
 
@@ -401,6 +418,16 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame
             break;
     }
 
+    ShadowStyle shadowStyle;
+    shadowStyle.cornerRadius = this->cornerRadius;
+    shadowStyle.width        = shadowWidth;
+    shadowStyle.feather      = shadowFeather;
+    shadowStyle.opacity      = shadowOpacity;
+    shadowStyle.offset       = shadowOffset;
+
+    if (ShadowCache::draw(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), shadowStyle, alpha))
+        return;
+
     NVGpaint shadowPaint = nvgBoxGradient(
         vg,
         frame.getMinX(), frame.getMinY() + shadowWidth,
@@ -497,7 +524,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     // Shake animation
     if (this->highlightShaking)
     {
-        Time curTime = getCPUTimeUsec() / 1000;
+        Time curTime = getUITimeUsec() / 1000;
         Time t       = (curTime - highlightShakeStart) / 10;
 
         if (t >= style["brls/animations/highlight_shake"])
@@ -528,7 +555,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     if (background)
     {
         // Background
-        NVGcolor highlightBackgroundColor = theme["brls/highlight/background"];
+        NVGcolor highlightBackgroundColor = theme[HIGHLIGHT_BACKGROUND_COLOR];
         nvgFillColor(vg, RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, this->highlightAlpha));
         nvgBeginPath(vg);
         nvgRoundedRect(vg, x, y, width, height, cornerRadius);
@@ -539,7 +566,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
 #ifdef SIMPLE_HIGHLIGHT
         // Border
         nvgBeginPath(vg);
-        nvgStrokeColor(vg, a(theme["brls/highlight/color1"]));
+        nvgStrokeColor(vg, a(theme[HIGHLIGHT_COLOR1]));
         nvgStrokeWidth(vg, style["brls/highlight/stroke_width"]);
         nvgRoundedRect(vg, x, y, width, height, cornerRadius);
         nvgStroke(vg);
@@ -547,32 +574,42 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
         float shadowOffset = style["brls/highlight/shadow_offset"];
 
         // Shadow
-        NVGpaint shadowPaint = nvgBoxGradient(vg,
-            x, y + style["brls/highlight/shadow_width"],
-            width, height,
-            cornerRadius * 2, style["brls/highlight/shadow_feather"],
-            RGBA(0, 0, 0, style["brls/highlight/shadow_opacity"] * alpha), TRANSPARENT);
+        ShadowStyle shadowStyle;
+        shadowStyle.cornerRadius = cornerRadius;
+        shadowStyle.width        = style["brls/highlight/shadow_width"];
+        shadowStyle.feather      = style["brls/highlight/shadow_feather"];
+        shadowStyle.opacity      = style["brls/highlight/shadow_opacity"];
+        shadowStyle.offset       = shadowOffset;
+
+        if (!ShadowCache::draw(vg, x, y, width, height, shadowStyle, alpha))
+        {
+            NVGpaint shadowPaint = nvgBoxGradient(vg,
+                x, y + shadowStyle.width,
+                width, height,
+                cornerRadius * 2, shadowStyle.feather,
+                RGBA(0, 0, 0, shadowStyle.opacity * alpha), TRANSPARENT);
 
-        nvgBeginPath(vg);
-        nvgRect(vg, x - shadowOffset, y - shadowOffset,
-            width + shadowOffset * 2, height + shadowOffset * 3);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgPathWinding(vg, NVG_HOLE);
-        nvgFillPaint(vg, shadowPaint);
-        nvgFill(vg);
+            nvgBeginPath(vg);
+            nvgRect(vg, x - shadowOffset, y - shadowOffset,
+                width + shadowOffset * 2, height + shadowOffset * 3);
+            nvgRoundedRect(vg, x, y, width, height, cornerRadius);
+            nvgPathWinding(vg, NVG_HOLE);
+            nvgFillPaint(vg, shadowPaint);
+            nvgFill(vg);
+        }
 
         // Border
         float gradientX, gradientY, color;
         getHighlightAnimation(&gradientX, &gradientY, &color);
 
-        NVGcolor highlightColor1 = theme["brls/highlight/color1"];
+        NVGcolor highlightColor1 = theme[HIGHLIGHT_COLOR1];
 
         NVGcolor pulsationColor = RGBAf((color * highlightColor1.r) + (1 - color) * highlightColor1.r,
             (color * highlightColor1.g) + (1 - color) * highlightColor1.g,
             (color * highlightColor1.b) + (1 - color) * highlightColor1.b,
             alpha);
 
-        NVGcolor borderColor = theme["brls/highlight/color2"];
+        NVGcolor borderColor = theme[HIGHLIGHT_COLOR2];
         borderColor.a        = 0.5f * alpha * this->getAlpha();
 
         float strokeWidth = style["brls/highlight/stroke_width"];
@@ -629,7 +666,7 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect f
         case ViewBackground::SIDEBAR:
         {
             float backdropHeight  = style["brls/sidebar/border_height"];
-            NVGcolor sidebarColor = theme["brls/sidebar/background"];
+            NVGcolor sidebarColor = theme[SIDEBAR_BACKGROUND_COLOR];
 
             // Solid color
             nvgBeginPath(vg);
@@ -667,7 +704,7 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect f
         }
         case ViewBackground::BACKDROP:
         {
-            nvgFillColor(vg, a(theme["brls/backdrop"]));
+            nvgFillColor(vg, a(theme[BACKDROP_COLOR]));
             nvgBeginPath(vg);
             nvgRect(vg, x, y, width, height);
             nvgFill(vg);
@@ -1126,7 +1163,51 @@ void View::invalidate()
     if (this->hasParent() && !this->detached)
         this->getParent()->invalidate();
     else
+    {
+        BRLS_TRACE_SCOPE("layout");
         YGNodeCalculateLayout(this->ygNode, YGUndefined, YGUndefined, YGDirectionLTR);
+    }
+}
+
+void View::invalidateLayoutFrame()
+{
+    this->layoutFrameValid = false;
+}
+
+void View::queueLayoutEvent(View* view)
+{
+    if (view->layoutEventQueued)
+        return;
+
+    view->layoutEventQueued = true;
+    View::layoutEventQueue.push_back(view);
+}
+
+void View::dispatchLayoutEvents()
+{
+    // Callbacks can lay the views out again (which dispatches the new events right away)
+    // or delete views (which removes them from the queue), so the queue is consumed in place
+    while (!View::layoutEventQueue.empty())
+    {
+        View* view = View::layoutEventQueue.front();
+        View::layoutEventQueue.pop_front();
+        view->layoutEventQueued = false;
+
+        Rect frame = Rect(YGNodeLayoutGetLeft(view->ygNode), YGNodeLayoutGetTop(view->ygNode),
+            YGNodeLayoutGetWidth(view->ygNode), YGNodeLayoutGetHeight(view->ygNode));
+
+        if (view->layoutFrameValid && frame == view->layoutFrame)
+            continue;
+
+        bool resized           = !view->layoutFrameValid || !(frame.size == view->layoutFrame.size);
+        view->layoutFrame      = frame;
+        view->layoutFrameValid = true;
+
+        if (resized)
+            view->onLayout();
+        else
+            view->onPositionChanged();
+    }
 }
 
 Rect View::getFrame()
@@ -1270,7 +1351,8 @@ void View::show(std::function<void(void)> cb, bool animate, float animationDurat
         return;
     }
 
-    brls::Logger::debug("Showing {}", this->describe());
+    if (BRLS_LOG_ENABLED(LOG_DEBUG))
+        brls::Logger::debug("Showing {}", this->describe());
 
     this->hidden = false;
 
@@ -1312,7 +1394,8 @@ void View::hide(std::function<void(void)> cb, bool animated, float animationDura
         return;
     }
 
-    brls::Logger::debug("Hiding {}", this->describe());
+    if (BRLS_LOG_ENABLED(LOG_DEBUG))
+        brls::Logger::debug("Hiding {}", this->describe());
 
     this->hidden = true;
     this->fadeIn = false;
@@ -1356,6 +1439,14 @@ void View::overrideTheme(Theme* newTheme)
     this->themeOverride = newTheme;
 }
 
+void View::onThemeChanged()
+{
+    Theme theme = Application::getTheme();
+
+    for (auto& [name, color] : this->themedAttributes)
+        this->colorAttributes[name](theme[color]);
+}
+
 void View::onParentFocusGained(View* focusedView)
 {
 }
@@ -1432,7 +1523,15 @@ View::~View()
     highlightAlpha.stop();
     collapseState.stop();
 
-    YGNodeFree(this->ygNode);
+    if (this->layoutEventQueued)
+    {
+        auto it = std::find(View::layoutEventQueue.begin(), View::layoutEventQueue.end(), this);
+        if (it != View::layoutEventQueue.end())
+            View::layoutEventQueue.erase(it);
+    }
+
+    ViewPool::recycleNode(this->ygNode);
+    ViewPool::viewDestroyed(this);
 
     if (deletionToken)
         *deletionToken = true;
@@ -1592,6 +1691,8 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     // Starts with with # -> color
     else if (startsWith(value, "#"))
     {
+        this->themedAttributes.erase(name);
+
         // Parse the color
         // #RRGGBB format
         if (value.size() == 7)
@@ -1654,12 +1755,13 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     else if (startsWith(value, "@theme/"))
     {
         // Parse the color name
-        std::string colorName = value.substr(7); // length of "@theme/"
-        NVGcolor value        = Application::getTheme()[colorName]; // will throw logic_error if the color doesn't exist
+        ThemeColor color = Theme::color(value.substr(7)); // length of "@theme/"
+        NVGcolor value   = Application::getTheme()[color]; // will throw logic_error if the color doesn't exist
 
         if (this->colorAttributes.count(name) > 0)
         {
             this->colorAttributes[name](value);
+            this->themedAttributes[name] = color;
             return true;
         }
         else
@@ -1723,67 +1825,99 @@ bool View::isXMLAttributeValid(std::string attributeName)
     return this->knownAttributes.count(attributeName) > 0;
 }
 
-View* View::createFromXMLResource(std::string name)
+tinyxml2::XMLDocument* View::loadXMLDocumentFromResource(std::string name)
 {
     // Check if custom xml file exists
-    if (!View::CUSTOM_RESOURCES_PATH.empty() && std::ifstream { View::CUSTOM_RESOURCES_PATH + "xml/" + name }.good())
+    if (!View::CUSTOM_RESOURCES_PATH.empty() && AssetStore::exists(View::CUSTOM_RESOURCES_PATH + "xml/" + name))
     {
-        return View::createFromXMLFile(View::CUSTOM_RESOURCES_PATH + "xml/" + name);
+        return View::loadXMLDocumentFromFile(View::CUSTOM_RESOURCES_PATH + "xml/" + name);
     }
 
-#ifdef USE_LIBROMFS
-    return View::createFromXMLString(romfs::get("xml/" + name).string());
-#else
-    return View::createFromXMLFile(std::string(BRLS_RESOURCES) + "xml/" + name);
-#endif
+    return View::loadXMLDocumentFromFile("@res/xml/" + name);
 }
 
-View* View::createFromXMLString(std::string_view xml)
+tinyxml2::XMLDocument* View::loadXMLDocumentFromString(std::string_view xml)
 {
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->Parse(xml.data());
+    tinyxml2::XMLError error        = document->Parse(xml.data(), xml.size());
 
     if (error != tinyxml2::XMLError::XML_SUCCESS)
+    {
+        delete document;
         fatal("Invalid XML when creating View from XML: error " + std::to_string(error));
+    }
 
-    tinyxml2::XMLElement* root = document->RootElement();
-
-    if (!root)
+    if (!document->RootElement())
+    {
+        delete document;
         fatal("Invalid XML: no element found");
+    }
 
-    View* view = View::createFromXMLElement(root);
-    view->bindXMLDocument(document);
-    return view;
+    return document;
 }
 
-View* View::createFromXMLFile(std::string path)
+tinyxml2::XMLDocument* View::loadXMLDocumentFromFile(std::string path)
 {
+    std::shared_ptr<Asset> asset = AssetStore::open(path);
+    if (!asset)
+        fatal("Unable to load XML file \"" + path + "\": file not found or empty");
+
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->LoadFile(path.c_str());
+    tinyxml2::XMLError error        = document->Parse((const char*)asset->data(), asset->size());
 
     if (error != tinyxml2::XMLError::XML_SUCCESS)
+    {
+        delete document;
         fatal("Unable to load XML file \"" + path + "\": error " + std::to_string(error));
+    }
 
-    tinyxml2::XMLElement* element = document->RootElement();
-
-    if (!element)
+    if (!document->RootElement())
+    {
+        delete document;
         fatal("Unable to load XML file \"" + path + "\": no root element found, is the file empty?");
+    }
+
+    return document;
+}
 
-    View* view = View::createFromXMLElement(element);
+View* View::createFromXMLResource(std::string name)
+{
+    // Check if custom xml file exists
+    if (!View::CUSTOM_RESOURCES_PATH.empty() && AssetStore::exists(View::CUSTOM_RESOURCES_PATH + "xml/" + name))
+    {
+        return View::createFromXMLFile(View::CUSTOM_RESOURCES_PATH + "xml/" + name);
+    }
+
+    return View::createFromXMLFile("@res/xml/" + name);
+}
+
+View* View::createFromXMLString(std::string_view xml)
+{
+    BRLS_TRACE_SCOPE("xml/inflate");
+    tinyxml2::XMLDocument* document = View::loadXMLDocumentFromString(xml);
+
+    View* view = View::createFromXMLElement(document->RootElement());
     view->bindXMLDocument(document);
     return view;
 }
 
-View* View::createFromXMLElement(tinyxml2::XMLElement* element)
+View* View::createFromXMLFile(std::string path)
+{
+    BRLS_TRACE_SCOPE("xml/inflate");
+    tinyxml2::XMLDocument* document = View::loadXMLDocumentFromFile(path);
+
+    View* view = View::createFromXMLElement(document->RootElement());
+    view->bindXMLDocument(document);
+    return view;
+}
+
+View* View::createFromXMLElementShallow(tinyxml2::XMLElement* element)
 {
     if (!element)
         return nullptr;
 
     std::string viewName = element->Name();
 
-    // Instantiate the view
-    View* view = nullptr;
-
     // Special case where element name is brls:View: create from given XML file.
     // XML attributes are explicitely not passed down to the created view.
     // To create a custom view from XML that you can reuse in other XML files,
@@ -1792,29 +1926,30 @@ View* View::createFromXMLElement(tinyxml2::XMLElement* element)
     {
         const tinyxml2::XMLAttribute* xmlAttribute = element->FindAttribute("xml");
 
-        if (xmlAttribute)
-        {
-#ifdef USE_LIBROMFS
-            view = View::createFromXMLString(romfs::get(View::getFilePathXMLAttributeValue(xmlAttribute->Value())).string());
-#else
-            view = View::createFromXMLFile(View::getFilePathXMLAttributeValue(xmlAttribute->Value()));
-#endif
-        }
-        else
-        {
+        if (!xmlAttribute)
             fatal("brls:View XML tag must have an \"xml\" attribute");
-        }
+
+        // Resolved by the asset store, which also reads "@res/" paths from libromfs
+        return View::createFromXMLFile(xmlAttribute->Value());
     }
+
     // Otherwise look in the register
-    else
-    {
-        if (!Application::XMLViewsRegisterContains(viewName))
-            fatal("Unknown XML tag \"" + viewName + "\"");
+    if (!Application::XMLViewsRegisterContains(viewName))
+        fatal("Unknown XML tag \"" + viewName + "\"");
 
-        view = Application::getXMLViewCreator(viewName)();
+    View* view = Application::getXMLViewCreator(viewName)();
 
-        view->applyXMLAttributes(element);
-    }
+    view->applyXMLAttributes(element);
+
+    return view;
+}
+
+View* View::createFromXMLElement(tinyxml2::XMLElement* element)
+{
+    View* view = View::createFromXMLElementShallow(element);
+
+    if (!view)
+        return nullptr;
 
     unsigned count = 0;
     unsigned max   = view->getMaximumAllowedXMLElements();
@@ -1836,6 +1971,16 @@ void View::handleXMLElement(tinyxml2::XMLElement* element)
     fatal("Raw views cannot have child XML tags");
 }
 
+bool View::canAddXMLChildView()
+{
+    return false;
+}
+
+void View::addXMLChildView(View* view)
+{
+    fatal("Raw views cannot have child XML tags");
+}
+
 void View::setMaximumAllowedXMLElements(unsigned max)
 {
     this->maximumAllowedXMLElements = max;
@@ -2379,6 +2524,11 @@ void View::bindXMLDocument(tinyxml2::XMLDocument* document)
     this->boundDocuments.push_back(document);
 }
 
+size_t View::getBoundXMLDocumentsCount()
+{
+    return this->boundDocuments.size();
+}
+
 void View::setWireframeEnabled(bool wireframe)
 {
     this->wireframeEnabled = wireframe;
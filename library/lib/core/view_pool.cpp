@@ -0,0 +1,365 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <yoga/YGNode.h>
+
+#include <algorithm>
+#include <borealis/core/view_pool.hpp>
+#include <new>
+
+namespace brls
+{
+
+// Stored in front of every block, the view starts right after it
+struct alignas(std::max_align_t) BlockHeader
+{
+    ViewArena* arena; // nullptr if allocated from the system heap
+    size_t sizeClass;
+};
+
+// Free blocks are chained together using their first bytes
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+ViewArena::~ViewArena()
+{
+    for (void* slab : this->slabs)
+        ::operator delete(slab);
+}
+
+void* ViewArena::allocate(size_t sizeClass)
+{
+    FreeBlock* block = (FreeBlock*)this->freeLists[sizeClass];
+
+    if (!block)
+    {
+        // Carve a new slab into blocks of that size class
+        size_t blockSize = (sizeClass + 1) * BLOCK_GRANULARITY;
+        size_t count     = std::max(SLAB_SIZE / blockSize, (size_t)4);
+        char* slab       = (char*)::operator new(count * blockSize);
+
+        this->slabs.push_back(slab);
+        this->reservedBytes += count * blockSize;
+        this->freeBlocks += count;
+
+        for (size_t i = count; i > 0; i--)
+        {
+            FreeBlock* freeBlock = (FreeBlock*)(slab + (i - 1) * blockSize);
+            freeBlock->next      = block;
+            block                = freeBlock;
+        }
+    }
+
+    this->freeLists[sizeClass] = block->next;
+    this->freeBlocks--;
+    this->usedBlocks++;
+
+    return block;
+}
+
+void ViewArena::deallocate(void* block, size_t sizeClass)
+{
+    FreeBlock* freeBlock       = (FreeBlock*)block;
+    freeBlock->next            = (FreeBlock*)this->freeLists[sizeClass];
+    this->freeLists[sizeClass] = freeBlock;
+
+    this->freeBlocks++;
+    this->usedBlocks--;
+}
+
+static size_t getSizeClass(size_t size)
+{
+    return (size + sizeof(BlockHeader) - 1) / ViewArena::BLOCK_GRANULARITY;
+}
+
+void* ViewPool::allocate(size_t size)
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    size_t sizeClass = getSizeClass(size);
+    BlockHeader* header;
+
+    if (sizeClass >= ViewArena::SIZE_CLASSES)
+    {
+        header        = (BlockHeader*)::operator new(size + sizeof(BlockHeader));
+        header->arena = nullptr;
+        ViewPool::heapViews++;
+    }
+    else
+    {
+        ViewArena* arena = ViewPool::currentArena;
+
+        if (!arena)
+        {
+            if (!ViewPool::globalArena)
+            {
+                ViewPool::globalArena = new ViewArena();
+                ViewPool::arenas.push_back(ViewPool::globalArena);
+            }
+
+            arena = ViewPool::globalArena;
+        }
+
+        header            = (BlockHeader*)arena->allocate(sizeClass);
+        header->arena     = arena;
+        header->sizeClass = sizeClass;
+    }
+
+    return header + 1;
+}
+
+void ViewPool::deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    BlockHeader* header = (BlockHeader*)ptr - 1;
+    ViewArena* arena    = header->arena;
+
+    if (!arena)
+    {
+        ::operator delete(header);
+        ViewPool::heapViews--;
+        return;
+    }
+
+    arena->deallocate(header, header->sizeClass);
+
+    // Last view of a released arena: give all its slabs back at once
+    ViewPool::deleteArenaIfUnused(arena);
+}
+
+void ViewPool::deleteArenaIfUnused(ViewArena* arena)
+{
+    // Kept while views created in it are alive, even from the system heap, for takeLeakedViews()
+    if (!arena->released || arena->usedBlocks > 0 || arena->views > 0)
+        return;
+
+    ViewPool::arenas.erase(std::find(ViewPool::arenas.begin(), ViewPool::arenas.end(), arena));
+    delete arena;
+}
+
+ViewArena* ViewPool::createArena()
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    ViewArena* arena = new ViewArena();
+    ViewPool::arenas.push_back(arena);
+    return arena;
+}
+
+void ViewPool::releaseArena(ViewArena* arena)
+{
+    if (!arena)
+        return;
+
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    arena->released = true;
+
+    if (ViewPool::currentArena == arena)
+        ViewPool::currentArena = nullptr;
+
+    ViewPool::deleteArenaIfUnused(arena);
+}
+
+void ViewPool::setCurrentArena(ViewArena* arena)
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    if (arena && arena->released)
+        arena = nullptr;
+
+    ViewPool::currentArena = arena;
+}
+
+ViewArena* ViewPool::getCurrentArena()
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+    return ViewPool::currentArena;
+}
+
+YGNodeRef ViewPool::acquireNode()
+{
+    {
+        std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+        if (!ViewPool::freeNodes.empty())
+        {
+            YGNodeRef node = ViewPool::freeNodes.back();
+            ViewPool::freeNodes.pop_back();
+            return node;
+        }
+    }
+
+    return YGNodeNew();
+}
+
+void ViewPool::recycleNode(YGNodeRef node)
+{
+    // Same detaching as YGNodeFree()
+    if (YGNodeRef owner = node->getOwner())
+    {
+        owner->removeChild(node);
+        node->setOwner(nullptr);
+    }
+
+    for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++)
+        YGNodeGetChild(node, i)->setOwner(nullptr);
+
+    node->clearChildren();
+    YGNodeReset(node);
+
+    {
+        std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+        if (ViewPool::freeNodes.size() < MAX_FREE_NODES)
+        {
+            ViewPool::freeNodes.push_back(node);
+            return;
+        }
+    }
+
+    YGNodeFree(node);
+}
+
+void ViewPool::trim()
+{
+    std::vector<YGNodeRef> nodes;
+
+    {
+        std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+        nodes.swap(ViewPool::freeNodes);
+    }
+
+    for (YGNodeRef node : nodes)
+        YGNodeFree(node);
+}
+
+void ViewPool::viewCreated(View* view)
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    ViewArena* arena = ViewPool::currentArena;
+    if (arena)
+        arena->views++;
+
+    ViewPool::liveViews[view] = arena;
+}
+
+void ViewPool::viewDestroyed(View* view)
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    auto it = ViewPool::liveViews.find(view);
+    if (it == ViewPool::liveViews.end())
+        return;
+
+    ViewArena* arena = it->second;
+    ViewPool::liveViews.erase(it);
+
+    if (arena)
+    {
+        arena->views--;
+        ViewPool::deleteArenaIfUnused(arena);
+    }
+}
+
+std::vector<std::pair<View*, ViewArena*>> ViewPool::getLiveViews()
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+    return std::vector<std::pair<View*, ViewArena*>>(ViewPool::liveViews.begin(), ViewPool::liveViews.end());
+}
+
+std::vector<View*> ViewPool::takeLeakedViews()
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    std::vector<View*> leaked;
+
+    for (ViewArena* arena : ViewPool::arenas)
+    {
+        if (!arena->released || arena->leaksReported || arena->views == 0)
+            continue;
+
+        arena->leaksReported = true;
+
+        for (auto& [view, viewArena] : ViewPool::liveViews)
+        {
+            if (viewArena == arena)
+                leaked.push_back(view);
+        }
+    }
+
+    return leaked;
+}
+
+ViewPoolStats ViewPool::getStats()
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    ViewPoolStats stats;
+    stats.liveViews = ViewPool::liveViews.size();
+    stats.heapViews = ViewPool::heapViews;
+    stats.freeNodes = ViewPool::freeNodes.size();
+    stats.arenas    = ViewPool::arenas.size();
+
+    for (ViewArena* arena : ViewPool::arenas)
+    {
+        stats.usedBlocks += arena->usedBlocks;
+        stats.freeBlocks += arena->freeBlocks;
+        stats.slabs += arena->slabs.size();
+        stats.reservedBytes += arena->reservedBytes;
+
+        if (arena->released)
+            stats.leakedViews += arena->views;
+    }
+
+    return stats;
+}
+
+ViewPoolStats ViewPool::getStats(ViewArena* arena)
+{
+    std::lock_guard<std::mutex> lock(ViewPool::poolMutex);
+
+    ViewPoolStats stats;
+
+    for (auto& [view, viewArena] : ViewPool::liveViews)
+    {
+        if (viewArena == arena)
+            stats.liveViews++;
+    }
+
+    if (!arena)
+        arena = ViewPool::globalArena;
+
+    if (arena)
+    {
+        stats.arenas        = 1;
+        stats.usedBlocks    = arena->usedBlocks;
+        stats.freeBlocks    = arena->freeBlocks;
+        stats.slabs         = arena->slabs.size();
+        stats.reservedBytes = arena->reservedBytes;
+    }
+
+    return stats;
+}
+
+} // namespace brls
@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <fstream>
+#include <set>
 #include <string>
 #include <vector>
 #include <iomanip>
+#include <romfs/lz4.hpp>
+#include <romfs/romfs.hpp>
 #ifdef USE_BOOST_FILESYSTEM
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
@@ -31,13 +37,69 @@ namespace {
         return string;
     }
 
+    std::string toLower(std::string string) {
+        std::transform(string.begin(), string.end(), string.begin(), [](unsigned char c) { return std::tolower(c); });
+        return string;
+    }
+
+    // Compresses the file in chunks, see romfs.cpp for the format.
+    // Returns false if it's not worth it.
+    bool compress(const std::vector<std::byte> &bytes, std::vector<std::uint8_t> &output) {
+        const auto *data       = reinterpret_cast<const std::uint8_t*>(bytes.data());
+        std::size_t chunkCount = (bytes.size() + romfs::Resource::CHUNK_SIZE - 1) / romfs::Resource::CHUNK_SIZE;
+
+        std::vector<std::uint8_t> chunks;
+        std::vector<std::uint32_t> ends;
+
+        for (std::size_t i = 0; i < chunkCount; i++) {
+            std::size_t offset = i * romfs::Resource::CHUNK_SIZE;
+            romfs::lz4::compress(data + offset, std::min(romfs::Resource::CHUNK_SIZE, bytes.size() - offset), chunks);
+            ends.push_back(static_cast<std::uint32_t>(chunks.size()));
+        }
+
+        output.resize((1 + chunkCount) * sizeof(std::uint32_t));
+        std::uint32_t count = static_cast<std::uint32_t>(chunkCount);
+        std::memcpy(output.data(), &count, sizeof(count));
+        std::memcpy(output.data() + sizeof(count), ends.data(), ends.size() * sizeof(std::uint32_t));
+        output.insert(output.end(), chunks.begin(), chunks.end());
+
+        // Decompressing has a cost, only keep what saves at least 1/8 of the size
+        return output.size() < bytes.size() - bytes.size() / 8;
+    }
+
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::printf("./libromfs-generator <LIBROMFS_PROJECT_NAME> <LIBROMFS_RESOURCE_LOCATION>");
+    if (argc < 3) {
+        std::printf("./libromfs-generator <LIBROMFS_PROJECT_NAME> <LIBROMFS_RESOURCE_LOCATION> [--compress] [--store <extensions>]\n");
+        std::printf("  --compress  compress the resources, decompressed on first access\n");
+        std::printf("  --store     comma-separated extensions of the files never compressed, such as png,jpg\n");
         return 0;
     }
+
+    bool compressResources = false;
+    std::set<std::string> storedExtensions;
+
+    for (int i = 3; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--compress") {
+            compressResources = true;
+        } else if (argument == "--store" && i + 1 < argc) {
+            std::string list = argv[++i];
+            for (size_t begin = 0, end; begin <= list.size(); begin = end + 1) {
+                end = list.find_first_of(",;", begin);
+                if (end == std::string::npos)
+                    end = list.size();
+                if (end > begin)
+                    storedExtensions.insert("." + toLower(list.substr(begin, end - begin)));
+            }
+        } else {
+            std::printf("[libromfs] Unknown argument: %s\n", argument.c_str());
+            return 1;
+        }
+    }
+
     std::ofstream outputFile("libromfs_resources.cpp");
 
     std::printf("[libromfs] Resource Folder: %s\n", argv[2]);
@@ -50,7 +112,9 @@ int main(int argc, char* argv[]) {
     outputFile << "/* Resource definitions */\n";
 
     std::vector<fs::path> paths;
+    std::vector<std::size_t> originalSizes; // 0 if not compressed
     std::uint64_t identifierCount = 0;
+    std::uint64_t totalSize = 0, totalStoredSize = 0;
     for (const auto &entry : fs::recursive_directory_iterator(argv[2])) {
         auto& p = entry.path();
         if (!fs::is_regular_file(p)) continue;
@@ -63,9 +127,6 @@ int main(int argc, char* argv[]) {
             continue ;
         }
 
-        outputFile << "static std::array<std::uint8_t, " << fs::file_size(p) + 1 << "> " << "resource_" + std::string(argv[1]) + "_" << identifierCount << " = {\n";
-        outputFile << "    ";
-
         std::vector<std::byte> bytes;
         bytes.resize(fs::file_size(p));
 
@@ -73,8 +134,24 @@ int main(int argc, char* argv[]) {
         bytes.resize(std::fread(bytes.data(), 1, fs::file_size(p), file));
         std::fclose(file);
 
+        std::vector<std::uint8_t> compressed;
+        bool stored = !compressResources || storedExtensions.count(toLower(path.extension().string()))
+            || !compress(bytes, compressed);
+
+        if (stored) {
+            compressed.resize(bytes.size());
+            std::memcpy(compressed.data(), bytes.data(), bytes.size());
+        }
+
+        originalSizes.push_back(stored ? 0 : bytes.size());
+        totalSize += bytes.size();
+        totalStoredSize += compressed.size();
+
+        outputFile << "static std::array<std::uint8_t, " << compressed.size() + 1 << "> " << "resource_" + std::string(argv[1]) + "_" << identifierCount << " = {\n";
+        outputFile << "    ";
+
         outputFile << std::hex << std::uppercase << std::setfill('0') << std::setw(2);
-        for (std::byte byte : bytes) {
+        for (std::uint8_t byte : compressed) {
             outputFile << "0x" << static_cast<std::uint32_t>(byte) << ", ";
         }
         outputFile << std::dec << std::nouppercase << std::setfill(' ') << std::setw(0);
@@ -97,7 +174,10 @@ int main(int argc, char* argv[]) {
 
             std::printf("[libromfs] Bundling resource: %s\n", paths[i].string().c_str());
 
-            outputFile << "        " << "{ \"" << toPathString(paths[i].string()) << "\", romfs::Resource({ reinterpret_cast<std::byte*>(resource_" + std::string(argv[1]) + "_" << i << ".data()), " << "resource_" + std::string(argv[1]) + "_" << i << ".size() - 1 }) " << "},\n";
+            outputFile << "        " << "{ \"" << toPathString(paths[i].string()) << "\", romfs::Resource({ reinterpret_cast<std::byte*>(resource_" + std::string(argv[1]) + "_" << i << ".data()), " << "resource_" + std::string(argv[1]) + "_" << i << ".size() - 1 }";
+            if (originalSizes[i] > 0)
+                outputFile << ", " << originalSizes[i];
+            outputFile << ") " << "},\n";
         }
         outputFile << "    };";
 
@@ -132,4 +212,7 @@ int main(int argc, char* argv[]) {
     }
 
     outputFile << "\n\n";
+
+    if (compressResources)
+        std::printf("[libromfs] Compressed resources from %llu to %llu bytes\n", (unsigned long long)totalSize, (unsigned long long)totalStoredSize);
 }
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Minimal LZ4 block format codec, shared by the generator (compression)
+// and the library (decompression). Blocks are compatible with LZ4_decompress_safe().
+namespace romfs::lz4 {
+
+    constexpr std::size_t MIN_MATCH    = 4;
+    constexpr std::size_t LAST_LITERALS = 5;  // the last bytes of a block are always literals
+    constexpr std::size_t MF_LIMIT      = 12; // no match can start that close to the end
+    constexpr std::size_t MAX_OFFSET    = 65535;
+    constexpr int HASH_BITS             = 16;
+
+    inline std::uint32_t read32(const std::uint8_t *p) {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline std::uint32_t hash(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    inline void writeLength(std::vector<std::uint8_t> &out, std::size_t length) {
+        while (length >= 255) {
+            out.push_back(255);
+            length -= 255;
+        }
+        out.push_back(static_cast<std::uint8_t>(length));
+    }
+
+    inline void writeSequence(std::vector<std::uint8_t> &out, const std::uint8_t *literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength) {
+        std::uint8_t token = static_cast<std::uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+        if (matchLength > 0)
+            token |= static_cast<std::uint8_t>(matchLength - MIN_MATCH >= 15 ? 15 : matchLength - MIN_MATCH);
+
+        out.push_back(token);
+        if (literalLength >= 15)
+            writeLength(out, literalLength - 15);
+        out.insert(out.end(), literals, literals + literalLength);
+
+        if (matchLength == 0)
+            return;
+
+        out.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<std::uint8_t>(offset >> 8));
+        if (matchLength - MIN_MATCH >= 15)
+            writeLength(out, matchLength - MIN_MATCH - 15);
+    }
+
+    /**
+     * Compresses the given data as a single block, appended to out.
+     * Greedy matching with a hash table of the last position of every 4-byte sequence.
+     */
+    inline void compress(const std::uint8_t *src, std::size_t size, std::vector<std::uint8_t> &out) {
+        std::size_t anchor = 0;
+
+        if (size > MF_LIMIT) {
+            std::vector<std::uint32_t> table(std::size_t(1) << HASH_BITS, 0xFFFFFFFFu);
+            std::size_t matchLimit = size - LAST_LITERALS;
+            std::size_t pos        = 0;
+
+            while (pos + MF_LIMIT <= size) {
+                std::uint32_t sequence = read32(src + pos);
+                std::uint32_t &slot    = table[hash(sequence)];
+                std::size_t candidate  = slot;
+                slot                   = static_cast<std::uint32_t>(pos);
+
+                if (candidate == 0xFFFFFFFFu || pos - candidate > MAX_OFFSET || read32(src + candidate) != sequence) {
+                    pos++;
+                    continue;
+                }
+
+                std::size_t length = MIN_MATCH;
+                while (pos + length < matchLimit && src[candidate + length] == src[pos + length])
+                    length++;
+
+                // Extend backwards over the pending literals
+                while (pos > anchor && candidate > 0 && src[pos - 1] == src[candidate - 1]) {
+                    pos--;
+                    candidate--;
+                    length++;
+                }
+
+                writeSequence(out, src + anchor, pos - anchor, pos - candidate, length);
+
+                pos += length;
+                anchor = pos;
+            }
+        }
+
+        writeSequence(out, src + anchor, size - anchor, 0, 0);
+    }
+
+    /**
+     * Decompresses a block into exactly dstSize bytes.
+     * Returns false if the block is invalid or doesn't decompress to dstSize bytes.
+     */
+    inline bool decompress(const std::uint8_t *src, std::size_t srcSize, std::uint8_t *dst, std::size_t dstSize) {
+        const std::uint8_t *ip    = src;
+        const std::uint8_t *ipEnd = src + srcSize;
+        std::size_t op            = 0;
+
+        auto readLength = [&](std::size_t length, bool *valid) {
+            if (length != 15)
+                return length;
+
+            std::uint8_t byte;
+            do {
+                if (ip >= ipEnd) {
+                    *valid = false;
+                    return length;
+                }
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+
+            return length;
+        };
+
+        while (ip < ipEnd) {
+            bool valid          = true;
+            std::uint8_t token  = *ip++;
+            std::size_t literal = readLength(token >> 4, &valid);
+
+            if (!valid || literal > static_cast<std::size_t>(ipEnd - ip) || literal > dstSize - op)
+                return false;
+
+            std::memcpy(dst + op, ip, literal);
+            ip += literal;
+            op += literal;
+
+            // The last sequence has no match
+            if (ip == ipEnd)
+                break;
+
+            if (ipEnd - ip < 2)
+                return false;
+
+            std::size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+
+            std::size_t length = readLength(token & 0x0F, &valid) + MIN_MATCH;
+
+            if (!valid || offset == 0 || offset > op || length > dstSize - op)
+                return false;
+
+            // Byte by byte, the match can overlap what it's copying
+            const std::uint8_t *match = dst + op - offset;
+            for (std::size_t i = 0; i < length; i++)
+                dst[op + i] = match[i];
+            op += length;
+        }
+
+        return op == dstSize;
+    }
+
+}
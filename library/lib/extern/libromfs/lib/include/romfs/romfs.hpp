@@ -2,7 +2,9 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #if __cplusplus > 202002L
 #include <span>
@@ -25,17 +27,25 @@ namespace romfs {
 
     class Resource {
     public:
+        // Compressed resources are split into chunks of that size, compressed independently
+        static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
         constexpr Resource() : m_content() {}
         explicit constexpr Resource(const nonstd::span<std::byte> &content) : m_content(content) {}
 
+        // Compressed resource of the given original size, see the generator for the format
+        Resource(const nonstd::span<std::byte> &content, std::size_t size);
+
+        /**
+         * Returns the content of the resource, followed by a null byte.
+         * Compressed resources are decompressed on first access, the buffer is kept until exit.
+         */
         [[nodiscard]]
-        constexpr const std::byte* data() const {
-            return this->m_content.data();
-        }
+        const std::byte* data() const;
 
         [[nodiscard]]
-        constexpr std::size_t size() const {
-            return this->m_content.size();
+        std::size_t size() const {
+            return this->m_compressed ? this->m_size : this->m_content.size();
         }
 
         [[nodiscard]]
@@ -49,12 +59,63 @@ namespace romfs {
 //        }
 
         [[nodiscard]]
-        constexpr bool valid() const {
+        bool valid() const {
             return !this->m_content.empty() && this->m_content.data() != nullptr;
         }
 
+        [[nodiscard]]
+        bool compressed() const {
+            return this->m_compressed;
+        }
+
+        /**
+         * Size of the resource in the executable.
+         */
+        [[nodiscard]]
+        std::size_t storedSize() const {
+            return this->m_content.size();
+        }
+
+        /**
+         * Decompresses the resource into the given buffer of size() bytes, without keeping it.
+         * Returns false if the data is invalid.
+         */
+        bool decompress(std::byte *out) const;
+
+        /**
+         * Decompresses the resource one chunk at a time without keeping it, calling
+         * callback(const std::byte* data, std::size_t size) after every chunk.
+         * Uncompressed resources are given at once.
+         * Returns false if the data is invalid.
+         */
+        template<typename Callback>
+        bool stream(Callback callback) const {
+            if (!this->m_compressed) {
+                callback(this->m_content.data(), this->m_content.size());
+                return true;
+            }
+
+            std::vector<std::byte> buffer(CHUNK_SIZE);
+            for (std::size_t i = 0; i < this->chunkCount(); i++) {
+                std::size_t size = 0;
+                if (!this->decompressChunk(i, buffer.data(), &size))
+                    return false;
+                callback(static_cast<const std::byte*>(buffer.data()), size);
+            }
+
+            return true;
+        }
+
     private:
+        struct Cache;
+
+        std::size_t chunkCount() const;
+        bool decompressChunk(std::size_t index, std::byte *out, std::size_t *size) const;
+
         const nonstd::span<const std::byte> m_content;
+        std::size_t m_size  = 0;
+        bool m_compressed   = false;
+        std::shared_ptr<Cache> m_cache; // decompressed content, shared by the copies of the resource
     };
 
     namespace impl {
@@ -1,6 +1,11 @@
 #include <romfs/romfs.hpp>
+#include <romfs/lz4.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <map>
+#include <mutex>
 
 const std::map<fs::path, romfs::Resource>& ROMFS_CONCAT(ROMFS_NAME, _get_resources)();
 const std::vector<fs::path>& ROMFS_CONCAT(ROMFS_NAME, _get_paths)();
@@ -8,6 +13,82 @@ const std::string& ROMFS_CONCAT(ROMFS_NAME, _get_name)();
 
 namespace romfs {
 
+    /*
+     * Compressed resources are made of:
+     *   - the number of chunks (uint32)
+     *   - the end offset of every compressed chunk from the end of this table (uint32 each)
+     *   - the chunks, every one decompressing to CHUNK_SIZE bytes except the last one
+     */
+
+    struct Resource::Cache {
+        std::once_flag once;
+        std::vector<std::byte> buffer;
+    };
+
+    Resource::Resource(const nonstd::span<std::byte> &content, std::size_t size)
+        : m_content(content), m_size(size), m_compressed(true), m_cache(std::make_shared<Cache>()) {}
+
+    std::size_t Resource::chunkCount() const {
+        if (this->m_content.size() < sizeof(std::uint32_t))
+            return 0;
+
+        return romfs::lz4::read32(reinterpret_cast<const std::uint8_t*>(this->m_content.data()));
+    }
+
+    bool Resource::decompressChunk(std::size_t index, std::byte *out, std::size_t *size) const {
+        const auto *base  = reinterpret_cast<const std::uint8_t*>(this->m_content.data());
+        std::size_t count = this->chunkCount();
+        std::size_t table = (1 + count) * sizeof(std::uint32_t);
+
+        if (index >= count || index * CHUNK_SIZE >= this->m_size || table > this->m_content.size())
+            return false;
+
+        std::size_t begin = index == 0 ? 0 : romfs::lz4::read32(base + index * sizeof(std::uint32_t));
+        std::size_t end   = romfs::lz4::read32(base + (index + 1) * sizeof(std::uint32_t));
+
+        if (begin > end || table + end > this->m_content.size())
+            return false;
+
+        *size = std::min(CHUNK_SIZE, this->m_size - index * CHUNK_SIZE);
+        return romfs::lz4::decompress(base + table + begin, end - begin, reinterpret_cast<std::uint8_t*>(out), *size);
+    }
+
+    bool Resource::decompress(std::byte *out) const {
+        if (!this->m_compressed) {
+            std::memcpy(out, this->m_content.data(), this->m_content.size());
+            return true;
+        }
+
+        std::size_t offset = 0;
+
+        for (std::size_t i = 0; i < this->chunkCount() && offset < this->m_size; i++) {
+            std::size_t size = 0;
+            if (!this->decompressChunk(i, out + offset, &size))
+                return false;
+            offset += size;
+        }
+
+        return offset == this->m_size;
+    }
+
+    const std::byte* Resource::data() const {
+        if (!this->m_compressed)
+            return this->m_content.data();
+
+        std::call_once(this->m_cache->once, [this] {
+            // Null-terminated like uncompressed resources
+            std::vector<std::byte> buffer(this->m_size + 1, std::byte(0));
+
+            if (this->decompress(buffer.data()))
+                this->m_cache->buffer = std::move(buffer);
+            else
+                std::fprintf(stderr, "[libromfs] Invalid compressed resource data\n");
+        });
+
+        // nullptr if the data is invalid
+        return this->m_cache->buffer.empty() ? nullptr : this->m_cache->buffer.data();
+    }
+
     const romfs::Resource &impl::ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(const fs::path &path) {
         try {
             return ROMFS_CONCAT(ROMFS_NAME, _get_resources)().at(path);
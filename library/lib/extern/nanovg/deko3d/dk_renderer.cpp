@@ -496,6 +496,20 @@ namespace nvg {
         return 1;
     }
 
+    // borealis addition: data only holds the region
+    int DkRenderer::UpdateTextureRegion(const DKNVGcontext &ctx, int image, int x, int y, int w, int h, const unsigned char *data) {
+        const std::shared_ptr<Texture> texture = this->FindTexture(image);
+
+        /* Could not find a texture. */
+        if (texture == nullptr) {
+            return 0;
+        }
+
+        UpdateImage(texture->GetImage(), m_data_mem_pool, m_device, m_queue, texture->GetDescriptor().type, x, y, w, h, data);
+        return 1;
+    }
+    // end borealis addition
+
     int DkRenderer::GetTextureSize(const DKNVGcontext &ctx, int image, int *w, int *h) {
         const auto descriptor = this->GetTextureDescriptor(ctx, image);
         if (descriptor == nullptr) {
@@ -408,6 +408,8 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 	ctx->strokeTriCount = 0;
 	ctx->textTriCount = 0;
 	ctx->textTextureDirty = 0;
+
+	fonsNextFrame(ctx->fs);
 }
 
 void nvgCancelFrame(NVGcontext* ctx)
@@ -865,6 +867,11 @@ void nvgUpdateImage(NVGcontext* ctx, int image, const unsigned char* data)
 	ctx->params.renderUpdateTexture(ctx->params.userPtr, image, 0,0, w,h, data);
 }
 
+void nvgUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	ctx->params.renderUpdateTextureRegion(ctx->params.userPtr, image, x,y, w,h, data);
+}
+
 void nvgImageSize(NVGcontext* ctx, int image, int* w, int* h)
 {
 	ctx->params.renderGetTextureSize(ctx->params.userPtr, image, w, h);
@@ -2366,6 +2373,16 @@ void nvgResetFallbackFontsId(NVGcontext* ctx, int baseFont)
 	fonsResetFallbackFont(ctx->fs, baseFont);
 }
 
+void nvgSetMissingGlyphCallback(NVGcontext* ctx, int (*callback)(void* uptr, int baseFont, unsigned int codepoint), void* uptr)
+{
+	fonsSetMissingGlyphCallback(ctx->fs, callback, uptr);
+}
+
+struct FONScontext* nvgGetFontStash(NVGcontext* ctx)
+{
+	return ctx->fs;
+}
+
 void nvgResetFallbackFonts(NVGcontext* ctx, const char* baseFont)
 {
 	nvgResetFallbackFontsId(ctx, nvgFindFont(ctx, baseFont));
@@ -2469,10 +2486,19 @@ static int nvg__allocTextAtlas(NVGcontext* ctx)
 		ctx->fontImages[ctx->fontImageIdx+1] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
 	}
 	++ctx->fontImageIdx;
-	fonsResetAtlas(ctx->fs, iw, ih);
+	fonsEvictAtlas(ctx->fs, iw, ih);
 	return 1;
 }
 
+int nvgGrowTextAtlas(NVGcontext* ctx)
+{
+	int iw = 0, ih = 0;
+	fonsGetAtlasSize(ctx->fs, &iw, &ih);
+	if (iw >= NVG_MAX_FONTIMAGE_SIZE && ih >= NVG_MAX_FONTIMAGE_SIZE)
+		return 0;
+	return nvg__allocTextAtlas(ctx);
+}
+
 static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts)
 {
 	NVGstate* state = nvg__getState(ctx);
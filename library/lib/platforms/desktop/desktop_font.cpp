@@ -15,8 +15,6 @@
     limitations under the License.
 */
 
-#include <unistd.h>
-
 #include <borealis/core/application.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/platforms/desktop/desktop_font.hpp>
@@ -33,14 +31,16 @@ const static std::vector<std::string> fontExts = {
     ".otf",
 };
 
-bool DesktopFontLoader::loadFontsExist(NVGcontext* vg, std::vector<std::string> fontPaths, std::string fontName, std::string fallbackFont) {
+bool DesktopFontLoader::loadFontsExist(NVGcontext* vg, std::vector<std::string> fontPaths, std::string fontName, std::string fallbackFont, std::vector<CodepointRange> ranges) {
     for (auto &fontPath: fontPaths) {
         for (auto &fontExt: fontExts) {
             std::string fullPath = fontPath + fontExt;
-            if (access(fullPath.c_str(), F_OK) != -1) {
-                this->loadFontFromFile(fontName, fullPath);
+            if (AssetStore::exists(fullPath)) {
                 if (!fallbackFont.empty()) {
-                    nvgAddFallbackFontId(vg, Application::getFont(fallbackFont), Application::getFont(fontName));
+                    // System fonts are big, only open them when a glyph is missing
+                    this->addLazyFallbackFont(fontName, fullPath, fallbackFont, ranges);
+                } else {
+                    this->loadFontFromFile(fontName, fullPath);
                 }
                 brls::Logger::info("Using {} font: {}", fontName, fullPath);
                 return true;
@@ -50,28 +50,22 @@ bool DesktopFontLoader::loadFontsExist(NVGcontext* vg, std::vector<std::string>
     return false;
 }
 
-bool DesktopFontLoader::loadFont(const std::string& name, const std::string& path) {
-#ifdef USE_LIBROMFS
-    if (path.empty()) return false;
-    if (path.rfind("@res/", 0) == 0)
-    {
-        // font is inside the romfs
-        try
-        {
-            auto& font = romfs::get(path.substr(5));
-            if (font.valid() && Application::loadFontFromMemory(name, (void*)font.data(), font.size(), false))
-                return true;
-        }
-        catch (...)
-        {
-        }
-    } else
+std::vector<std::string> DesktopFontLoader::getPreloadPaths() {
+    return {
+        USER_FONT_PATH,
+        INTER_FONT_PATH,
+        USER_EMOJI_PATH,
+        USER_ICON_PATH,
+        INTER_ICON_PATH,
+#ifndef USE_LIBROMFS
+        BRLS_ASSET("material/MaterialIcons-Regular.ttf"),
 #endif
-    if (access(path.c_str(), F_OK) != -1 && Application::loadFontFromFile(name, path)) {
-        return true;
-    }
+    };
+}
 
-    return false;
+bool DesktopFontLoader::loadFont(const std::string& name, const std::string& path) {
+    // Files and resources (embedded or not) are all read through the asset store
+    return !path.empty() && AssetStore::exists(path) && Application::loadFontFromFile(name, path);
 }
 
 void DesktopFontLoader::loadFonts()
@@ -126,10 +120,10 @@ void DesktopFontLoader::loadFonts()
     std::vector<std::string> simplifiedChineseFonts;
 #endif
     if (!simplifiedChineseFonts.empty()) {
-        loadFontsExist(vg, simplifiedChineseFonts, FONT_CHINESE_SIMPLIFIED, FONT_REGULAR);
+        loadFontsExist(vg, simplifiedChineseFonts, FONT_CHINESE_SIMPLIFIED, FONT_REGULAR, CODEPOINTS_CJK);
     }
     if (!koreanFonts.empty()) {
-        loadFontsExist(vg, koreanFonts, FONT_KOREAN_REGULAR, FONT_REGULAR);
+        loadFontsExist(vg, koreanFonts, FONT_KOREAN_REGULAR, FONT_REGULAR, CODEPOINTS_HANGUL);
     }
 
     // Load Emoji
@@ -58,6 +58,14 @@ using winrt::Windows::UI::ViewManagement::UISettings;
 #include <ifaddrs.h>
 #endif
 
+#if defined(__linux__) && !defined(ANDROID)
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#endif
+
 
 namespace brls
 {
@@ -385,6 +393,99 @@ void dbusUnInhibit(DBusConnection* connection, uint32_t cookie)
 
 static std::unique_ptr<DBusConnection, std::function<void(DBusConnection*)>> dbus_conn(connectSessionBus(),
     closeSessionBus);
+
+static std::string sysfsRead(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string value;
+    std::getline(file, value);
+    return value;
+}
+
+static std::vector<std::string> sysfsList(const std::string& path)
+{
+    std::vector<std::string> names;
+    DIR* dir = opendir(path.c_str());
+    if (!dir)
+        return names;
+
+    while (struct dirent* entry = readdir(dir))
+    {
+        if (entry->d_name[0] != '.')
+            names.emplace_back(entry->d_name);
+    }
+    closedir(dir);
+    return names;
+}
+
+/// @return the first battery directory in /sys/class/power_supply, or an empty string
+static std::string linux_battery_path()
+{
+    for (const std::string& name : sysfsList("/sys/class/power_supply"))
+    {
+        std::string path = "/sys/class/power_supply/" + name;
+        if (sysfsRead(path + "/type") == "Battery" && sysfsRead(path + "/present") != "0")
+            return path;
+    }
+    return "";
+}
+
+static bool linux_interface_up(const std::string& name)
+{
+    return sysfsRead("/sys/class/net/" + name + "/operstate") == "up";
+}
+
+/// @return the names of the wireless interfaces
+static std::vector<std::string> linux_wlan_interfaces()
+{
+    std::vector<std::string> interfaces;
+    for (const std::string& name : sysfsList("/sys/class/net"))
+    {
+        if (access(("/sys/class/net/" + name + "/wireless").c_str(), F_OK) == 0)
+            interfaces.push_back(name);
+    }
+    return interfaces;
+}
+
+/// @return -1 no wifi connected
+///         link quality of the connected interface otherwise, from 0 to 100
+static int linux_wlan_quality()
+{
+    std::vector<std::string> interfaces = linux_wlan_interfaces();
+
+    // /proc/net/wireless: two header lines, then "iface: status link level noise ..."
+    std::ifstream file("/proc/net/wireless");
+    std::string line;
+    for (int i = 0; std::getline(file, line); i++)
+    {
+        if (i < 2)
+            continue;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+
+        std::string name = line.substr(line.find_first_not_of(' '), colon - line.find_first_not_of(' '));
+        if (!linux_interface_up(name))
+            continue;
+
+        int status = 0;
+        float link = 0;
+        if (sscanf(line.c_str() + colon + 1, "%x %f", &status, &link) != 2)
+            continue;
+
+        return std::min(100, std::max(0, (int)(link * 100 / 70)));
+    }
+
+    // Connected without a quality report (some drivers)
+    for (const std::string& name : interfaces)
+    {
+        if (linux_interface_up(name))
+            return 100;
+    }
+
+    return -1;
+}
 #endif
 
 DesktopPlatform::DesktopPlatform()
@@ -470,6 +571,8 @@ bool DesktopPlatform::canShowBatteryLevel()
     if (!GetSystemPowerStatus(&status))
         return false;
     return !(status.BatteryFlag & BATTERY_FLAG_NO_BATTERY);
+#elif defined(__linux__) && !defined(ANDROID)
+    return !linux_battery_path().empty();
 #else
     return false;
 #endif
@@ -482,6 +585,8 @@ bool DesktopPlatform::canShowWirelessLevel()
     return true;
 #elif defined(_WIN32)
     return true;
+#elif defined(__linux__) && !defined(ANDROID)
+    return !linux_wlan_interfaces().empty() || hasEthernetConnection();
 #else
     return false;
 #endif
@@ -498,6 +603,11 @@ int DesktopPlatform::getBatteryLevel()
     if (!GetSystemPowerStatus(&status))
         return 0;
     return status.BatteryLifePercent;
+#elif defined(__linux__) && !defined(ANDROID)
+    std::string path = linux_battery_path();
+    if (path.empty())
+        return 100;
+    return atoi(sysfsRead(path + "/capacity").c_str());
 #else
     return 100;
 #endif
@@ -514,6 +624,11 @@ bool DesktopPlatform::isBatteryCharging()
     if (!GetSystemPowerStatus(&status))
         return false;
     return (status.BatteryFlag & BATTERY_FLAG_CHARGING) != 0;
+#elif defined(__linux__) && !defined(ANDROID)
+    std::string path = linux_battery_path();
+    if (path.empty())
+        return false;
+    return sysfsRead(path + "/status") == "Charging";
 #else
     return false;
 #endif
@@ -528,6 +643,8 @@ bool DesktopPlatform::hasWirelessConnection()
     return winrt_wlan_quality() > 0;
 #elif defined(_WIN32)
     return win32_wlan_quality() > 0;
+#elif defined(__linux__) && !defined(ANDROID)
+    return linux_wlan_quality() >= 0;
 #else
     return true;
 #endif
@@ -544,6 +661,8 @@ int DesktopPlatform::getWirelessLevel()
     return (win32_wlan_quality() * 4 - 1) / 100;
 #elif defined(ANDROID)
     return 0;
+#elif defined(__linux__)
+    return (std::max(linux_wlan_quality(), 0) * 4 - 1) / 100;
 #else
     return 0;
 #endif
@@ -619,6 +738,16 @@ bool DesktopPlatform::hasEthernetConnection()
     HeapFree(heap, 0, addrs);
 #elif defined(ANDROID)
     return has_eth;
+#elif defined(__linux__)
+    // Physical (backed by a device), non-wireless ethernet interfaces
+    for (const std::string& name : sysfsList("/sys/class/net"))
+    {
+        std::string path = "/sys/class/net/" + name;
+        if (access((path + "/device").c_str(), F_OK) != 0 || access((path + "/wireless").c_str(), F_OK) == 0)
+            continue;
+        if (sysfsRead(path + "/type") == "1" && linux_interface_up(name))
+            return true;
+    }
 #endif
     return has_eth;
 }
@@ -14,8 +14,10 @@
     limitations under the License.
 */
 
+#include <atomic>
 #include <borealis/core/application.hpp>
 #include <borealis/core/logger.hpp>
+#include <borealis/core/render_pipeline.hpp>
 #include <borealis/platforms/glfw/glfw_video.hpp>
 
 // nanovg implementation
@@ -46,12 +48,9 @@ std::unique_ptr<brls::D3D11Context> D3D11_CONTEXT;
 #endif
 
 #if defined(__linux__) || defined(_WIN32)
+#include <borealis/core/asset_store.hpp>
+
 #include "stb_image.h"
-#ifdef USE_LIBROMFS
-#include <romfs/romfs.hpp>
-#else
-#include <unistd.h>
-#endif
 #endif
 
 #ifdef _WIN32
@@ -64,6 +63,14 @@ namespace brls
 
 static double scaleFactor = 1.0;
 
+#ifdef BOREALIS_USE_OPENGL
+// Applied by the thread owning the GL context, which is not the UI thread when the render pipeline runs
+static std::atomic<int> viewportWidth      = 0;
+static std::atomic<int> viewportHeight     = 0;
+static std::atomic<bool> viewportDirty     = false;
+static std::atomic<bool> swapIntervalDirty = false;
+#endif
+
 static int mini(int x, int y)
 {
     return x < y ? x : y;
@@ -134,7 +141,9 @@ static void glfwWindowFramebufferSizeCallback(GLFWwindow* window, int width, int
     if (!width || !height)
         return;
 #ifdef BOREALIS_USE_OPENGL
-    glViewport(0, 0, width, height);
+    viewportWidth  = width;
+    viewportHeight = height;
+    viewportDirty  = true;
     int wWidth, wHeight;
     glfwGetWindowSize(window, &wWidth, &wHeight);
     scaleFactor = width * 1.0 / wWidth;
@@ -268,25 +277,17 @@ GLFWVideoContext::GLFWVideoContext(const std::string& windowTitle, uint32_t wind
 #if defined(__linux__) || defined(_WIN32)
     // Set window icon
     GLFWimage images[1];
-#ifdef USE_LIBROMFS
-    try
+    std::shared_ptr<Asset> icon = AssetStore::open("@res/icon/icon.png");
+    if (icon)
     {
-        auto& icon       = romfs::get("icon/icon.png");
-        images[0].pixels = stbi_load_from_memory((stbi_uc*)icon.data(), icon.size(), &images[0].width, &images[0].height, 0, 4);
-        glfwSetWindowIcon(this->window, 1, images);
-    }
-    catch (...)
-    {
-    }
-#else
-    const char* icon_path = BRLS_ASSET("icon/icon.png");
-    if (access(icon_path, F_OK) != -1)
-    {
-        images[0].pixels = stbi_load(icon_path, &images[0].width, &images[0].height, 0, 4);
-        glfwSetWindowIcon(this->window, 1, images);
+        images[0].pixels = stbi_load_from_memory(icon->data(), (int)icon->size(), &images[0].width, &images[0].height, 0, 4);
+        if (images[0].pixels)
+        {
+            glfwSetWindowIcon(this->window, 1, images);
+            stbi_image_free(images[0].pixels);
+        }
     }
 #endif
-#endif
 
 #if defined(__APPLE__) || defined(__linux__) || defined(_WIN32)
     // Set window position
@@ -375,6 +376,10 @@ GLFWVideoContext::GLFWVideoContext(const std::string& windowTitle, uint32_t wind
         return;
     }
 
+#ifdef BOREALIS_USE_OPENGL
+    RenderPipeline::install(this->nvgContext);
+#endif
+
     // Setup window state
     int width, height;
     glfwGetFramebufferSize(window, &width, &height);
@@ -424,6 +429,24 @@ void GLFWVideoContext::beginFrame()
 #elif defined(BOREALIS_USE_D3D11)
     D3D11_CONTEXT->beginFrame();
 #endif
+
+#ifdef BOREALIS_USE_OPENGL
+    if (viewportDirty.exchange(false))
+        glViewport(0, 0, viewportWidth, viewportHeight);
+
+    if (swapIntervalDirty.exchange(false))
+        glfwSwapInterval(1);
+#endif
+}
+
+bool GLFWVideoContext::makeCurrent(bool current)
+{
+#if defined(BOREALIS_USE_OPENGL) && !defined(__SWITCH__) && !defined(__PSV__)
+    glfwMakeContextCurrent(current ? this->window : nullptr);
+    return true;
+#else
+    return false;
+#endif
 }
 
 void GLFWVideoContext::endFrame()
@@ -575,7 +598,7 @@ void GLFWVideoContext::fullScreen(bool fs)
         }
     }
 #ifdef BOREALIS_USE_OPENGL
-    glfwSwapInterval(1);
+    swapIntervalDirty = true;
 #endif
 }
 
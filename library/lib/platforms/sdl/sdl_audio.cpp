@@ -0,0 +1,273 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <math.h>
+
+#include <algorithm>
+#include <borealis/core/asset_store.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/platforms/sdl/sdl_audio.hpp>
+#include <cstring>
+
+namespace brls
+{
+
+const std::string SOUNDS_MAP[_SOUND_MAX] = {
+    "", // SOUND_NONE
+    "focus_change", // SOUND_FOCUS_CHANGE
+    "focus_error", // SOUND_FOCUS_ERROR
+    "click", // SOUND_CLICK
+    "back", // SOUND_BACK
+    "focus_sidebar", // SOUND_FOCUS_SIDEBAR
+    "click_error", // SOUND_CLICK_ERROR
+    "honk", // SOUND_HONK
+    "click_sidebar", // SOUND_CLICK_SIDEBAR
+    "touch_unfocus", // SOUND_TOUCH_UNFOCUS
+    "touch", // SOUND_TOUCH
+    "slider_tick", // SOUND_SLIDER_TICK
+    "slider_release" // SOUND_SLIDER_RELEASE
+};
+
+// Short decaying tones generated for the sounds without a file
+struct Tone
+{
+    float frequency; // Hz
+    float duration; // ms
+    float volume;
+};
+
+static const Tone SOUND_TONES[_SOUND_MAX] = {
+    { 0, 0, 0 }, // SOUND_NONE
+    { 1320, 30, 0.25f }, // SOUND_FOCUS_CHANGE
+    { 220, 80, 0.4f }, // SOUND_FOCUS_ERROR
+    { 880, 45, 0.35f }, // SOUND_CLICK
+    { 660, 45, 0.35f }, // SOUND_BACK
+    { 1100, 30, 0.25f }, // SOUND_FOCUS_SIDEBAR
+    { 180, 90, 0.4f }, // SOUND_CLICK_ERROR
+    { 370, 250, 0.5f }, // SOUND_HONK
+    { 990, 45, 0.35f }, // SOUND_CLICK_SIDEBAR
+    { 440, 40, 0.25f }, // SOUND_TOUCH_UNFOCUS
+    { 1200, 25, 0.25f }, // SOUND_TOUCH
+    { 2000, 10, 0.2f }, // SOUND_SLIDER_TICK
+    { 1000, 30, 0.3f }, // SOUND_SLIDER_RELEASE
+};
+
+SDLAudioPlayer::SDLAudioPlayer()
+{
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+    {
+        Logger::error("sdl: failed to initialize audio: {}", SDL_GetError());
+        return;
+    }
+
+    SDL_AudioSpec spec;
+    SDL_zero(spec);
+    spec.freq     = SAMPLE_RATE;
+    spec.format   = AUDIO_F32SYS;
+    spec.channels = 1;
+    spec.samples  = BUFFER_SAMPLES;
+    spec.callback = SDLAudioPlayer::audioCallback;
+    spec.userdata = this;
+
+    // SDL converts the mix to the format of the device if needed
+    this->device = SDL_OpenAudioDevice(nullptr, 0, &spec, nullptr, 0);
+    if (this->device == 0)
+    {
+        Logger::error("sdl: failed to open audio device: {}", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return;
+    }
+
+    // All the sounds are ready before the callback can read them
+    for (size_t sound = 1; sound < _SOUND_MAX; sound++)
+        this->loadSound((enum Sound)sound);
+
+    SDL_PauseAudioDevice(this->device, 0);
+
+    Logger::info("sdl: audio driver: {}", SDL_GetCurrentAudioDriver());
+}
+
+SDLAudioPlayer::~SDLAudioPlayer()
+{
+    if (this->device == 0)
+        return;
+
+    // Waits for the callback to return
+    SDL_CloseAudioDevice(this->device);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+void SDLAudioPlayer::loadSound(enum Sound sound)
+{
+    std::string path             = "@res/sounds/" + SOUNDS_MAP[sound] + ".wav";
+    std::shared_ptr<Asset> asset = AssetStore::open(path);
+    SDL_RWops* file              = asset ? SDL_RWFromConstMem(asset->data(), (int)asset->size()) : nullptr;
+
+    SDL_AudioSpec spec;
+    Uint8* buffer  = nullptr;
+    Uint32 length  = 0;
+    bool converted = false;
+
+    if (file && SDL_LoadWAV_RW(file, 1, &spec, &buffer, &length))
+    {
+        SDL_AudioCVT cvt;
+        if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_F32SYS, 1, SAMPLE_RATE) >= 0)
+        {
+            // Converted in place, in a buffer big enough for the result
+            std::vector<Uint8> data((size_t)length * cvt.len_mult);
+            memcpy(data.data(), buffer, length);
+
+            cvt.buf = data.data();
+            cvt.len = length;
+
+            if (SDL_ConvertAudio(&cvt) == 0)
+            {
+                const float* samples = (const float*)data.data();
+                this->sounds[sound].assign(samples, samples + cvt.len_cvt / sizeof(float));
+                converted = true;
+            }
+        }
+
+        SDL_FreeWAV(buffer);
+
+        if (!converted)
+            Logger::warning("sdl: cannot convert sound {}: {}", path, SDL_GetError());
+    }
+
+    if (converted)
+        return;
+
+    // No file, generate the sound
+    Tone tone     = SOUND_TONES[sound];
+    size_t frames = (size_t)(tone.duration * SAMPLE_RATE / 1000);
+
+    this->sounds[sound].resize(frames);
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        float time     = (float)i / SAMPLE_RATE;
+        float progress = (float)i / frames;
+        float envelope = expf(-5.0f * progress) * std::min(1.0f, i / (SAMPLE_RATE * 0.002f)); // 2ms attack
+
+        this->sounds[sound][i] = tone.volume * envelope * sinf(2.0f * (float)M_PI * tone.frequency * time);
+    }
+}
+
+bool SDLAudioPlayer::load(enum Sound sound)
+{
+    // Everything is loaded with the device
+    return this->device != 0 && sound < _SOUND_MAX && (sound == SOUND_NONE || !this->sounds[sound].empty());
+}
+
+bool SDLAudioPlayer::play(enum Sound sound, float pitch)
+{
+    if (!this->load(sound))
+        return false;
+
+    if (sound == SOUND_NONE)
+        return true;
+
+    // Single producer: only the UI thread plays sounds
+    size_t tail = this->queueTail.load(std::memory_order_relaxed);
+    size_t next = (tail + 1) % QUEUE_SIZE;
+
+    if (next == this->queueHead.load(std::memory_order_acquire))
+        return false; // the callback is late, drop the sound
+
+    this->queue[tail] = { sound, pitch };
+    this->queueTail.store(next, std::memory_order_release);
+
+    return true;
+}
+
+void SDLCALL SDLAudioPlayer::audioCallback(void* userdata, Uint8* stream, int length)
+{
+    ((SDLAudioPlayer*)userdata)->mix((float*)stream, length / sizeof(float));
+}
+
+void SDLAudioPlayer::startVoice(PlayRequest request)
+{
+    // Replace the voice closest to its end if they are all playing
+    Voice* voice   = &this->voices[0];
+    double longest = -1;
+
+    for (Voice& candidate : this->voices)
+    {
+        if (!candidate.samples)
+        {
+            voice = &candidate;
+            break;
+        }
+
+        double progress = candidate.position / candidate.length;
+        if (progress > longest)
+        {
+            voice   = &candidate;
+            longest = progress;
+        }
+    }
+
+    const std::vector<float>& samples = this->sounds[request.sound];
+
+    voice->samples  = samples.data();
+    voice->length   = samples.size();
+    voice->position = 0;
+    voice->step     = request.pitch > 0 ? request.pitch : 1.0f;
+}
+
+void SDLAudioPlayer::mix(float* output, size_t frames)
+{
+    // Start the voices requested since the last callback
+    size_t head = this->queueHead.load(std::memory_order_relaxed);
+    while (head != this->queueTail.load(std::memory_order_acquire))
+    {
+        this->startVoice(this->queue[head]);
+
+        head = (head + 1) % QUEUE_SIZE;
+        this->queueHead.store(head, std::memory_order_release);
+    }
+
+    std::fill(output, output + frames, 0.0f);
+
+    for (Voice& voice : this->voices)
+    {
+        if (!voice.samples)
+            continue;
+
+        for (size_t i = 0; i < frames; i++)
+        {
+            size_t index = (size_t)voice.position;
+            if (index >= voice.length)
+            {
+                voice.samples = nullptr;
+                break;
+            }
+
+            // Linear interpolation for the pitch
+            float fraction = (float)(voice.position - index);
+            float current  = voice.samples[index];
+            float next     = index + 1 < voice.length ? voice.samples[index + 1] : 0.0f;
+
+            output[i] += (current + (next - current) * fraction) * VOLUME;
+            voice.position += voice.step;
+        }
+    }
+
+    for (size_t i = 0; i < frames; i++)
+        output[i] = std::min(std::max(output[i], -1.0f), 1.0f);
+}
+
+} // namespace brls
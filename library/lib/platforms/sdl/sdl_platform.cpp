@@ -70,7 +70,7 @@ SDLPlatform::SDLPlatform()
     }
 
     // Platform impls
-    this->audioPlayer = new NullAudioPlayer();
+    this->audioPlayer = new SDLAudioPlayer();
 
     // override local
     if (Platform::APP_LOCALE_DEFAULT == LOCALE_AUTO)
@@ -15,6 +15,7 @@
 */
 
 #include <borealis/core/application.hpp>
+#include <borealis/core/asset_store.hpp>
 #include <borealis/platforms/switch/switch_input.hpp>
 
 namespace brls
@@ -470,12 +471,9 @@ void SwitchInputManager::initCursor(NVGcontext* vg)
         return;
     if (vg)
     {
-#ifdef USE_LIBROMFS
-        auto image          = romfs::get("img/sys/cursor.png");
-        this->cursorTexture = nvgCreateImageMem(vg, NVG_IMAGE_NEAREST, (unsigned char*)image.data(), image.size());
-#else
-        this->cursorTexture = nvgCreateImage(vg, BRLS_ASSET("img/sys/cursor.png"), NVG_IMAGE_NEAREST);
-#endif
+        std::shared_ptr<Asset> image = AssetStore::open("@res/img/sys/cursor.png");
+        if (image)
+            this->cursorTexture = nvgCreateImageMem(vg, NVG_IMAGE_NEAREST, (unsigned char*)image->data(), image->size());
 
         int width, height;
         nvgImageSize(vg, cursorTexture, &width, &height);
@@ -35,6 +35,8 @@ limitations under the License.
 namespace brls
 {
 
+static const ThemeColor BACKGROUND_COLOR = Theme::color("brls/background");
+
 static constexpr const unsigned STATIC_CMD_SIZE = 0x1000;
 
 SwitchVideoContext::SwitchVideoContext()
@@ -140,7 +142,7 @@ void SwitchVideoContext::recordStaticCommands()
 
     // Clear the color and depth buffers
     Theme theme              = Application::getTheme();
-    NVGcolor backgroundColor = theme["brls/background"];
+    NVGcolor backgroundColor = theme[BACKGROUND_COLOR];
     this->cmdbuf.clearColor(0, DkColorMask_RGBA, backgroundColor.r, backgroundColor.g, backgroundColor.b, 1.0f);
 
     this->cmdbuf.clearDepthStencil(true, 1.0f, 0xFF, 0);
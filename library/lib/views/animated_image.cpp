@@ -0,0 +1,246 @@
+/*
+    Copyright 2024 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/thread.hpp>
+#include <borealis/views/animated_image.hpp>
+
+namespace brls
+{
+
+AnimatedImageTicking::AnimatedImageTicking(AnimatedImage* image)
+    : image(image)
+{
+}
+
+bool AnimatedImageTicking::onUpdate(Time delta)
+{
+    return this->image->onTick(delta);
+}
+
+AnimatedImage::AnimatedImage()
+    : ticking(this)
+{
+    // Replaces the Image attribute
+    this->registerFilePathXMLAttribute("image", [this](const std::string& value)
+        { this->setImageFromFile(value); });
+
+    this->registerBoolXMLAttribute("playing", [this](bool value)
+        { this->setPlaying(value); });
+}
+
+AnimatedImage::~AnimatedImage()
+{
+    this->stopStream();
+}
+
+void AnimatedImage::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+{
+    this->drawn = true;
+
+    // The ticking stops by itself when the view is not drawn anymore
+    if (this->playing && this->stream && this->texture != 0 && !this->ticking.isRunning())
+        this->ticking.start();
+
+    Image::draw(vg, x, y, width, height, style, ctx);
+}
+
+void AnimatedImage::setImageFromRes(const std::string& name)
+{
+    this->setImageFromFile("@res/" + name);
+}
+
+void AnimatedImage::setImageFromFile(const std::string& path)
+{
+    std::unique_ptr<GifDecoder> decoder = GifDecoder::openFile(path);
+
+    if (!decoder)
+    {
+        this->stopStream();
+        Image::setImageFromFile(path);
+        return;
+    }
+
+    this->play(std::move(decoder));
+}
+
+void AnimatedImage::setImageFromMem(const unsigned char* data, int size)
+{
+    std::unique_ptr<GifDecoder> decoder = GifDecoder::openMemory(data, size);
+
+    if (!decoder)
+    {
+        this->stopStream();
+        Image::setImageFromMem(data, size);
+        return;
+    }
+
+    this->play(std::move(decoder));
+}
+
+void AnimatedImage::clear()
+{
+    this->stopStream();
+    Image::clear();
+}
+
+void AnimatedImage::setPlaying(bool playing)
+{
+    this->playing = playing;
+
+    if (!playing)
+        this->ticking.stop();
+}
+
+bool AnimatedImage::isPlaying()
+{
+    return this->playing;
+}
+
+void AnimatedImage::play(std::unique_ptr<GifDecoder> decoder)
+{
+    this->stopStream();
+    Image::clear();
+
+    // The texture is updated in place, it cannot be shared
+    this->setFreeTexture(true);
+
+    this->stream          = std::make_shared<Stream>();
+    this->stream->decoder = std::move(decoder);
+    this->stream->owner   = this;
+
+    this->frameDelay = 0;
+    this->elapsed    = 0;
+
+    this->decodeNextFrame();
+}
+
+void AnimatedImage::stopStream()
+{
+    this->ticking.stop();
+
+    if (!this->stream)
+        return;
+
+    // A decoding task may still be running, it drops its frame when done
+    this->stream->owner = nullptr;
+    this->stream        = nullptr;
+}
+
+void AnimatedImage::decodeNextFrame()
+{
+    std::shared_ptr<Stream> stream = this->stream;
+
+    if (!stream || stream->decoding || stream->frames.size() >= BUFFERED_FRAMES)
+        return;
+
+    // Nothing else to decode for still GIFs
+    if (this->texture != 0 && stream->decoder->getFrameCount() == 1)
+        return;
+
+    std::shared_ptr<Frame> frame;
+    if (!stream->spareFrames.empty())
+    {
+        frame = stream->spareFrames.back();
+        stream->spareFrames.pop_back();
+    }
+    else
+    {
+        frame = std::make_shared<Frame>();
+        frame->pixels.resize((size_t)stream->decoder->getWidth() * stream->decoder->getHeight() * 4);
+    }
+
+    stream->decoding = true;
+
+    brls::async([stream, frame]()
+        {
+            bool decoded = stream->decoder->decodeFrame(frame->pixels.data(), &frame->delay);
+
+            brls::sync([stream, frame, decoded]()
+                {
+                    stream->decoding = false;
+
+                    AnimatedImage* image = stream->owner;
+                    if (!image)
+                        return;
+
+                    if (!decoded)
+                    {
+                        Logger::error("AnimatedImage: cannot decode frame");
+                        return;
+                    }
+
+                    // The first frame is displayed right away
+                    if (image->texture == 0)
+                        image->showFrame(frame);
+                    else
+                        stream->frames.push_back(frame);
+
+                    image->decodeNextFrame(); }); });
+}
+
+void AnimatedImage::showFrame(std::shared_ptr<Frame> frame)
+{
+    NVGcontext* vg = Application::getNVGContext();
+
+    if (this->texture == 0)
+    {
+        int flags = this->getImageFlags() & ~NVG_IMAGE_GENERATE_MIPMAPS;
+        this->innerSetImage(nvgCreateImageRGBA(vg, this->stream->decoder->getWidth(), this->stream->decoder->getHeight(), flags, frame->pixels.data()));
+    }
+    else
+    {
+        nvgUpdateImage(vg, this->texture, frame->pixels.data());
+    }
+
+    this->frameDelay = frame->delay < MIN_FRAME_DELAY ? DEFAULT_FRAME_DELAY : frame->delay;
+    this->stream->spareFrames.push_back(frame);
+}
+
+bool AnimatedImage::onTick(Time delta)
+{
+    // Paused when not drawn since the last tick, decoding then stops once enough frames are ready
+    if (!this->drawn || !this->playing || !this->stream)
+        return false;
+
+    this->drawn = false;
+    this->elapsed += delta;
+
+    // Keep the current frame if the next one is late
+    if (this->elapsed < this->frameDelay || this->stream->frames.empty())
+        return true;
+
+    std::shared_ptr<Frame> frame = this->stream->frames.front();
+    this->stream->frames.pop_front();
+
+    this->elapsed -= this->frameDelay;
+    this->showFrame(frame);
+
+    // Don't rush through the next frames after a hitch
+    if (this->elapsed >= this->frameDelay)
+        this->elapsed = 0;
+
+    this->decodeNextFrame();
+    return true;
+}
+
+View* AnimatedImage::create()
+{
+    return new AnimatedImage();
+}
+
+} // namespace brls
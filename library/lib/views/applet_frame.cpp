@@ -221,7 +221,17 @@ void AppletFrame::handleXMLElement(tinyxml2::XMLElement* element)
     if (this->contentView)
         fatal("brls:AppletFrame can only have one child XML element");
 
-    View* view = View::createFromXMLElement(element);
+    this->addXMLChildView(View::createFromXMLElement(element));
+}
+
+bool AppletFrame::canAddXMLChildView()
+{
+    // The second child XML element goes to handleXMLElement() to fail there
+    return !this->contentView;
+}
+
+void AppletFrame::addXMLChildView(View* view)
+{
     contentViewStack.push_back(view);
     setContentView(view);
 }
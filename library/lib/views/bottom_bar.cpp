@@ -14,11 +14,11 @@
     limitations under the License.
 */
 
+#include <fmt/core.h>
+
 #include <borealis/views/bottom_bar.hpp>
 #include <chrono>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 
 #ifdef PS4
 #include <borealis/platforms/ps4/ps4_sysmodule.hpp>
@@ -105,32 +105,33 @@ void BottomBar::draw(NVGcontext* vg, float x, float y, float width, float height
 
 void BottomBar::updateText()
 {
+    // The text only changes once per second: only format it when the second changes
 #ifdef PS4
-    OrbisDateTime lt{};
+    OrbisDateTime lt {};
     if (sceRtcGetCurrentClockLocalTime)
         sceRtcGetCurrentClockLocalTime(&lt);
-    tm tm{};
-    tm.tm_hour = lt.hour;
-    tm.tm_min = lt.minute;
-    tm.tm_sec = lt.second;
+    long now = lt.hour * 3600 + lt.minute * 60 + lt.second;
+#else
+    time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+#endif
+    if (now == lastTime)
+        return;
+    lastTime = now;
+
+#ifdef PS4
+    bottomText = fmt::format("{:02d}:{:02d}:{:02d}", lt.hour, lt.minute, lt.second);
 #else
-    auto timeNow   = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(timeNow);
-    auto tm = *std::localtime(&in_time_t);
+    struct tm tm = *std::localtime(&now);
+    bottomText   = fmt::format("{:02d}:{:02d}:{:02d}", tm.tm_hour, tm.tm_min, tm.tm_sec);
 #endif
-    std::stringstream ss;
-    ss << std::put_time(&tm, "%H:%M:%S");
-    if (ss.str() != bottomText)
+
+    if (Application::getFPSStatus())
+    {
+        time->setText(bottomText + " | FPS:" + std::to_string(Application::getFPS()));
+    }
+    else
     {
-        bottomText = ss.str();
-        if (Application::getFPSStatus())
-        {
-            time->setText(bottomText + " | FPS:" + std::to_string(Application::getFPS()));
-        }
-        else
-        {
-            time->setText(bottomText);
-        }
+        time->setText(bottomText);
     }
 }
 
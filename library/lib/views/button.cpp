@@ -140,6 +140,12 @@ void Button::applyStyle()
         this->setBorderColor(theme[borderColor]);
 }
 
+void Button::onThemeChanged()
+{
+    Box::onThemeChanged();
+    this->applyStyle();
+}
+
 void Button::onFocusGained()
 {
     Box::onFocusGained();
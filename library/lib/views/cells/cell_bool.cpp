@@ -23,6 +23,9 @@ using namespace brls::literals;
 namespace brls
 {
 
+static const ThemeColor VALUE_COLOR    = Theme::color("brls/list/listItem_value_color");
+static const ThemeColor DISABLED_COLOR = Theme::color("brls/text_disabled");
+
 BooleanCell::BooleanCell()
 {
     baseDetailTextSize = detail->getFontSize();
@@ -67,7 +70,13 @@ void BooleanCell::updateUI()
 {
     Theme theme = Application::getTheme();
     detail->setText(state ? "hints/on"_i18n : "hints/off"_i18n);
-    detail->setTextColor(state ? theme["brls/list/listItem_value_color"] : theme["brls/text_disabled"]);
+    detail->setTextColor(state ? theme[VALUE_COLOR] : theme[DISABLED_COLOR]);
+}
+
+void BooleanCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    this->updateUI();
 }
 
 void BooleanCell::scaleTick()
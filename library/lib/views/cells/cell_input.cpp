@@ -21,9 +21,12 @@
 namespace brls
 {
 
+static const ThemeColor VALUE_COLOR    = Theme::color("brls/list/listItem_value_color");
+static const ThemeColor DISABLED_COLOR = Theme::color("brls/text_disabled");
+
 InputCell::InputCell()
 {
-    detail->setTextColor(Application::getTheme()["brls/list/listItem_value_color"]);
+    detail->setTextColor(Application::getTheme()[VALUE_COLOR]);
 
     this->registerClickAction([this](View* view)
         {
@@ -61,18 +64,21 @@ void InputCell::setPlaceholder(std::string placeholder)
 }
 
 void InputCell::updateUI()
+{
+    this->detail->setText(this->value.empty() ? placeholder : value);
+    this->updateTextColor();
+}
+
+void InputCell::updateTextColor()
 {
     Theme theme = Application::getTheme();
-    if (this->value.empty())
-    {
-        this->detail->setText(placeholder);
-        this->detail->setTextColor(theme["brls/text_disabled"]);
-    }
-    else
-    {
-        this->detail->setText(value);
-        this->detail->setTextColor(theme["brls/list/listItem_value_color"]);
-    }
+    this->detail->setTextColor(this->value.empty() ? theme[DISABLED_COLOR] : theme[VALUE_COLOR]);
+}
+
+void InputCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    this->updateTextColor();
 }
 
 View* InputCell::create()
@@ -82,7 +88,7 @@ View* InputCell::create()
 
 InputNumericCell::InputNumericCell()
 {
-    detail->setTextColor(Application::getTheme()["brls/list/listItem_value_color"]);
+    detail->setTextColor(Application::getTheme()[VALUE_COLOR]);
 
     this->registerClickAction([this](View* view)
         {
@@ -114,9 +120,14 @@ void InputNumericCell::setValue(long value)
 
 void InputNumericCell::updateUI()
 {
-    Theme theme = Application::getTheme();
     this->detail->setText(std::to_string(value));
-    this->detail->setTextColor(theme["brls/list/listItem_value_color"]);
+    this->detail->setTextColor(Application::getTheme()[VALUE_COLOR]);
+}
+
+void InputNumericCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    this->detail->setTextColor(Application::getTheme()[VALUE_COLOR]);
 }
 
 View* InputNumericCell::create()
@@ -19,6 +19,10 @@
 namespace brls
 {
 
+static const ThemeColor VALUE_COLOR      = Theme::color("brls/list/listItem_value_color");
+static const ThemeColor BACKGROUND_COLOR = Theme::color("brls/background");
+static const ThemeColor TEXT_COLOR       = Theme::color("brls/text");
+
 const std::string radioCellXML = R"xml(
     <brls:Box
         width="auto"
@@ -76,13 +80,13 @@ void CheckBox::draw(NVGcontext* vg, float x, float y, float width, float height,
     int thickness = roundf(radius * 0.10f);
 
     // Background
-    nvgFillColor(vg, a(ctx->theme["brls/list/listItem_value_color"]));
+    nvgFillColor(vg, a(ctx->theme[VALUE_COLOR]));
     nvgBeginPath(vg);
     nvgCircle(vg, centerX, centerY, radius);
     nvgFill(vg);
 
     // Check mark
-    nvgFillColor(vg, a(ctx->theme["brls/background"]));
+    nvgFillColor(vg, a(ctx->theme[BACKGROUND_COLOR]));
 
     // Long stroke
     nvgSave(vg);
@@ -126,7 +130,13 @@ void RadioCell::setSelected(bool selected)
 
     this->selected = selected;
     this->checkbox->setVisibility(selected ? Visibility::VISIBLE : Visibility::GONE);
-    this->title->setTextColor(selected ? theme["brls/list/listItem_value_color"] : theme["brls/text"]);
+    this->title->setTextColor(selected ? theme[VALUE_COLOR] : theme[TEXT_COLOR]);
+}
+
+void RadioCell::onThemeChanged()
+{
+    RecyclerCell::onThemeChanged();
+    this->setSelected(this->selected);
 }
 
 bool RadioCell::getSelected()
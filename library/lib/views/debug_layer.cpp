@@ -15,6 +15,7 @@
 */
 
 #include <borealis/core/application.hpp>
+#include <borealis/core/memory.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/views/debug_layer.hpp>
 #include <borealis/views/label.hpp>
@@ -35,13 +36,28 @@ DebugLayer::DebugLayer()
     setJustifyContent(JustifyContent::FLEX_START);
     setAlignItems(AlignItems::FLEX_END);
 
+    this->memoryLabel = new Label();
+    this->memoryLabel->setPositionType(PositionType::ABSOLUTE);
+    this->memoryLabel->setPositionTop(5);
+    this->memoryLabel->setPositionLeft(5);
+    this->memoryLabel->setMaxWidth(brls::Application::contentWidth / 2 - 10);
+    this->memoryLabel->setFontSize(8);
+    this->memoryLabel->setTextColor(RGBA(200, 200, 200, 200));
+    this->memoryLabel->setBackgroundColor(RGBA(0, 0, 0, 160));
+    this->addView(this->memoryLabel);
+
+    this->updateMemory();
+    this->memoryTimer.setCallback([this]()
+        { this->updateMemory(); });
+    this->memoryTimer.start(1000);
+
     Box* contentView = new Box(Axis::COLUMN);
     this->addView(contentView);
     contentView->setWidth(brls::Application::contentWidth / 2);
     contentView->setPadding(5);
     contentView->setBackgroundColor(RGBA(0, 0, 0, 160));
     YGNodeStyleSetFlexDirection(contentView->getYGNode(), YGFlexDirectionColumnReverse);
-    Logger::getLogEvent()->subscribe([this, contentView](Logger::TimePoint now, LogLevel level, const std::string& log)
+    Logger::subscribeLogEvent([this, contentView](Logger::TimePoint now, LogLevel level, const std::string& log)
         { brls::sync([this, now, level, contentView, log]
               {
             uint64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -101,4 +117,9 @@ DebugLayer::DebugLayer()
                 contentView->removeView(contentView->getChildren()[contentView->getChildren().size() - 1]); }); });
 }
 
+void DebugLayer::updateMemory()
+{
+    this->memoryLabel->setText(MemoryTracker::describe(MemoryTracker::getStats()));
+}
+
 } // namespace brls
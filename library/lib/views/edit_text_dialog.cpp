@@ -13,6 +13,9 @@
 namespace brls
 {
 
+static const ThemeColor TEXT_COLOR          = Theme::color("brls/text");
+static const ThemeColor TEXT_DISABLED_COLOR = Theme::color("brls/text_disabled");
+
     const std::string editTextDialogXML = R"xml(
     <brls:Box
         id="brls/container"
@@ -165,6 +168,11 @@ namespace brls
             this->label->getY() + this->label->getHeight() });
     }
 
+    void EditTextDialog::onPositionChanged()
+    {
+        this->onLayout();
+    }
+
     Event<Point>* EditTextDialog::getLayoutEvent()
     {
         return &this->layoutEvent;
@@ -187,15 +195,18 @@ namespace brls
 
     void EditTextDialog::updateUI()
     {
+        // The label is resized by its text, the dialog isn't
+        this->invalidateLayoutFrame();
+
         if (content.empty())
         {
-            label->setTextColor(Application::getTheme().getColor("brls/text_disabled"));
+            label->setTextColor(Application::getTheme().getColor(TEXT_DISABLED_COLOR));
             label->setText(hint);
             label->setCursor((int)CursorPosition::START);
         }
         else
         {
-            label->setTextColor(Application::getTheme().getColor("brls/text"));
+            label->setTextColor(Application::getTheme().getColor(TEXT_COLOR));
             label->setText(content);
         }
     }
@@ -23,6 +23,8 @@
 namespace brls
 {
 
+static const ThemeColor INDICATOR_COLOR = Theme::color("brls/text");
+
 #define SCROLLING_INDICATOR_HEIGHT 4
 
 HScrollingFrame::HScrollingFrame()
@@ -36,7 +38,6 @@ HScrollingFrame::HScrollingFrame()
 
     setupScrollingIndicator();
 
-    input = Application::getPlatform()->getInputManager();
     this->setFocusable(true);
     this->setMaximumAllowedXMLElements(1);
 
@@ -99,10 +100,18 @@ HScrollingFrame::HScrollingFrame()
     setHideHighlightBorder(true);
 }
 
+void HScrollingFrame::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    if (scrollingIndicator)
+        scrollingIndicator->setColor(Application::getTheme()["brls/text"]);
+}
+
 void HScrollingFrame::setupScrollingIndicator()
 {
     Theme theme        = Application::getTheme();
-    scrollingIndicator = new Rectangle(theme["brls/text"]);
+    scrollingIndicator = new Rectangle(theme[INDICATOR_COLOR]);
     scrollingIndicator->setSize(Size(0, SCROLLING_INDICATOR_HEIGHT));
     scrollingIndicator->setCornerRadius(SCROLLING_INDICATOR_HEIGHT / 2);
     scrollingIndicator->detach();
@@ -184,7 +193,7 @@ void HScrollingFrame::naturalScrollingBehaviour()
     if (focused || childFocused)
     {
         ControllerState state;
-        input->updateUnifiedControllerState(&state);
+        Application::getInputManager()->updateUnifiedControllerState(&state);
         float rightLimit = this->getContentWidth() - this->getScrollingAreaWidth();
 
         // Sets true on border hit to play sound only once
@@ -315,6 +324,7 @@ void HScrollingFrame::setContentView(View* view)
     view->setCulled(false);
     view->setHeight(this->getHeight());
 
+    this->invalidateLayoutFrame();
     Box::addView(view); // will invalidate the scrolling box, hence calling onLayout and invalidating the contentView
 }
 
@@ -27,6 +27,8 @@ using namespace brls::literals;
 namespace brls
 {
 
+static const ThemeColor DISABLED_COLOR = Theme::color("brls/text_disabled");
+
 const std::string hintXML = R"xml(
     <brls:Box
         width="auto"
@@ -69,11 +71,25 @@ Hint::Hint(Action action, bool allowAButtonTouch)
             { action.actionListener(this); }));
     }
 
-    if (!action.available || Application::isInputBlocks())
+    this->disabled = !action.available || Application::isInputBlocks();
+
+    if (this->disabled)
+    {
+        Theme theme = Application::getTheme();
+        icon->setTextColor(theme[DISABLED_COLOR]);
+        hint->setTextColor(theme[DISABLED_COLOR]);
+    }
+}
+
+void Hint::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    if (this->disabled)
     {
         Theme theme = Application::getTheme();
-        icon->setTextColor(theme["brls/text_disabled"]);
-        hint->setTextColor(theme["brls/text_disabled"]);
+        icon->setTextColor(theme[DISABLED_COLOR]);
+        hint->setTextColor(theme[DISABLED_COLOR]);
     }
 }
 
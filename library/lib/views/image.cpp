@@ -16,7 +16,13 @@
     limitations under the License.
 */
 
+#include <stb_image.h>
+
 #include <borealis/core/application.hpp>
+#include <borealis/core/asset_store.hpp>
+#include <borealis/core/image_scaler.hpp>
+#include <borealis/core/sprite_atlas.hpp>
+#include <borealis/core/trace.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/image.hpp>
 
@@ -63,7 +69,7 @@ static float measureHeight(YGNodeRef node, float width, YGMeasureMode widthMode,
 static YGSize imageMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
 {
     Image* image                 = (Image*)node->getContext();
-    int texture                  = image->getTexture();
+    bool hasTexture              = image->hasTexture();
     float originalWidth          = image->getOriginalImageWidth();
     float originalHeight         = image->getOriginalImageHeight();
     ImageScalingType scalingType = image->getScalingType();
@@ -73,7 +79,7 @@ static YGSize imageMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
         .height = height,
     };
 
-    if (texture == 0)
+    if (!hasTexture)
         return size;
 
     // Stretched mode: we don't care about the size of the image
@@ -162,6 +168,17 @@ Image::Image()
             { "nearest", ImageInterpolation::NEAREST },
         });
 
+    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
+        "decodeQuality", ImageDecodeQuality, this->setDecodeQuality,
+        {
+            { "original", ImageDecodeQuality::ORIGINAL },
+            { "fast", ImageDecodeQuality::FAST },
+            { "high", ImageDecodeQuality::HIGH },
+        });
+
+    this->registerBoolXMLAttribute("mipmaps", [this](bool value)
+        { this->setMipmaps(value); });
+
     this->registerFilePathXMLAttribute("image", [this](const std::string& value)
         { this->setImageFromFile(value); }
 
@@ -178,18 +195,50 @@ void Image::draw(NVGcontext* vg, float x, float y, float width, float height, St
     float coordX = x + this->imageX;
     float coordY = y + this->imageY;
 
-    this->paint.xform[4] = coordX;
-    this->paint.xform[5] = coordY;
+    float fillX      = x;
+    float fillY      = y;
+    float fillWidth  = width;
+    float fillHeight = height;
 
-    nvgBeginPath(vg);
-    if (getClipsToBounds())
+    if (!getClipsToBounds())
+    {
+        fillX      = coordX;
+        fillY      = coordY;
+        fillWidth  = this->imageWidth;
+        fillHeight = this->imageHeight;
+    }
+
+    if (this->sprite != 0)
     {
-        nvgRoundedRect(vg, x, y, width, height, getCornerRadius());
+        // The sprite moves when its atlas page is compacted
+        const SpriteAtlas::Sprite* sprite = SpriteAtlas::get(this->sprite);
+        if (!sprite)
+            return;
+
+        float scaleX  = this->imageWidth / sprite->width;
+        float scaleY  = this->imageHeight / sprite->height;
+        this->texture = sprite->image;
+        this->paint   = nvgImagePattern(vg, coordX - sprite->x * scaleX, coordY - sprite->y * scaleY, sprite->pageSize * scaleX, sprite->pageSize * scaleY, 0, sprite->image, 1.0f);
+
+        // Only fill the image, the rest of the page holds other ones
+        float right  = std::min(fillX + fillWidth, coordX + this->imageWidth);
+        float bottom = std::min(fillY + fillHeight, coordY + this->imageHeight);
+        fillX        = std::max(fillX, coordX);
+        fillY        = std::max(fillY, coordY);
+        fillWidth    = right - fillX;
+        fillHeight   = bottom - fillY;
+
+        if (fillWidth <= 0 || fillHeight <= 0)
+            return;
     }
     else
     {
-        nvgRoundedRect(vg, coordX, coordY, this->imageWidth, this->imageHeight, getCornerRadius());
+        this->paint.xform[4] = coordX;
+        this->paint.xform[5] = coordY;
     }
+
+    nvgBeginPath(vg);
+    nvgRoundedRect(vg, fillX, fillY, fillWidth, fillHeight, getCornerRadius());
     nvgFillPaint(vg, a(this->paint));
     nvgFill(vg);
 }
@@ -197,6 +246,29 @@ void Image::draw(NVGcontext* vg, float x, float y, float width, float height, St
 void Image::onLayout()
 {
     this->invalidateImageBounds();
+
+    // Decode the image again if it was downscaled for a smaller view
+    if (this->texture == 0 || this->sourcePath.empty() || this->reloadPending)
+        return;
+
+    if (this->textureWidth >= this->originalImageWidth && this->textureHeight >= this->originalImageHeight)
+        return;
+
+    int width, height;
+    this->getDecodeSize((int)this->originalImageWidth, (int)this->originalImageHeight, &width, &height);
+    if (width <= this->textureWidth && height <= this->textureHeight)
+        return;
+
+    // Not during the layout, setting the image invalidates it
+    this->reloadPending = true;
+
+    ASYNC_RETAIN
+    brls::sync([ASYNC_TOKEN]()
+        {
+            ASYNC_RELEASE
+            this->reloadPending = false;
+            if (!this->sourcePath.empty())
+                this->setImageFromFile(this->sourcePath); });
 }
 
 void Image::setImageAlign(ImageAlignment align)
@@ -275,11 +347,11 @@ void Image::invalidateImageBounds()
     this->paint    = nvgImagePattern(vg, 0, 0, this->imageWidth, this->imageHeight, 0, this->texture, 1.0f);
 }
 
-size_t Image::checkCache(const std::string& path)
+size_t Image::checkCache(const std::string& path, int sourceWidth, int sourceHeight)
 {
     if (this->texture > 0)
     {
-        brls::TextureCache::instance().removeCache(this->texture);
+        brls::TextureCache::instance().removeCache(this->sprite != 0 ? this->sprite : this->texture);
         brls::Logger::verbose("cache remove: {} {}", path, this->texture);
     }
 
@@ -287,7 +359,7 @@ size_t Image::checkCache(const std::string& path)
     if (tex > 0)
     {
         brls::Logger::verbose("cache hit: {} {}", path, tex);
-        this->innerSetImage(tex);
+        this->setTexture(tex, sourceWidth, sourceHeight);
         return tex;
     }
 
@@ -296,18 +368,7 @@ size_t Image::checkCache(const std::string& path)
 
 void Image::setImageFromRes(const std::string& path)
 {
-    // Let TextureCache to manage when to delete texture
-    this->setFreeTexture(false);
-
-#ifdef USE_LIBROMFS
-    if (checkCache("@res/" + path) > 0)
-        return;
-    auto image = romfs::get(path);
-    this->setImageFromMem((unsigned char*)image.data(), (int)image.size());
-    TextureCache::instance().addCache("@res/" + path, this->texture);
-#else
-    this->setImageFromFile(std::string(BRLS_RESOURCES) + path);
-#endif
+    this->setImageFromFile("@res/" + path);
 }
 
 void Image::setInterpolation(ImageInterpolation interpolation)
@@ -315,40 +376,202 @@ void Image::setInterpolation(ImageInterpolation interpolation)
     this->interpolation = interpolation;
 }
 
+void Image::setDecodeQuality(ImageDecodeQuality quality)
+{
+    this->decodeQuality = quality;
+}
+
+ImageDecodeQuality Image::getDecodeQuality()
+{
+    return this->decodeQuality;
+}
+
+void Image::setDecodeSize(float width, float height)
+{
+    this->decodeWidth  = width;
+    this->decodeHeight = height;
+}
+
+void Image::setMipmaps(bool mipmaps)
+{
+    this->mipmaps = mipmaps;
+}
+
 int Image::getImageFlags()
 {
+    int flags = this->mipmaps ? NVG_IMAGE_GENERATE_MIPMAPS : 0;
+
     if (this->interpolation == ImageInterpolation::NEAREST)
-        return NVG_IMAGE_NEAREST;
+        flags |= NVG_IMAGE_NEAREST;
 
-    return 0;
+    return flags;
+}
+
+void Image::getDecodeSize(int sourceWidth, int sourceHeight, int* width, int* height)
+{
+    *width  = sourceWidth;
+    *height = sourceHeight;
+
+    if (this->decodeQuality == ImageDecodeQuality::ORIGINAL || this->scalingType == ImageScalingType::CENTER || sourceWidth <= 0 || sourceHeight <= 0)
+        return;
+
+    float targetWidth  = this->decodeWidth;
+    float targetHeight = this->decodeHeight;
+
+    // Size of the view, from its style if not laid out yet
+    if (targetWidth <= 0 && targetHeight <= 0)
+    {
+        YGValue styleWidth  = YGNodeStyleGetWidth(this->ygNode);
+        YGValue styleHeight = YGNodeStyleGetHeight(this->ygNode);
+
+        targetWidth  = styleWidth.unit == YGUnitPoint ? styleWidth.value : ntz(this->getWidth());
+        targetHeight = styleHeight.unit == YGUnitPoint ? styleHeight.value : ntz(this->getHeight());
+    }
+
+    float scaleX = targetWidth > 0 ? targetWidth / sourceWidth : 0.0f;
+    float scaleY = targetHeight > 0 ? targetHeight / sourceHeight : 0.0f;
+    float scale;
+
+    // With a single known dimension, the other one follows the aspect ratio
+    if (scaleX == 0.0f || scaleY == 0.0f)
+        scale = std::max(scaleX, scaleY);
+    else if (this->scalingType == ImageScalingType::FIT)
+        scale = std::min(scaleX, scaleY);
+    else
+        scale = std::max(scaleX, scaleY);
+
+    scale *= Application::windowScale * Application::getPlatform()->getVideoContext()->getScaleFactor();
+
+    if (scale <= 0.0f || scale >= 1.0f)
+        return;
+
+    *width  = std::max((int)lroundf(sourceWidth * scale), 1);
+    *height = std::max((int)lroundf(sourceHeight * scale), 1);
+}
+
+void Image::loadImage(const std::string& cacheKey, const unsigned char* data, int size)
+{
+    NVGcontext* vg = Application::getNVGContext();
+
+    int sourceWidth = 0, sourceHeight = 0, components = 0;
+    bool known      = stbi_info_from_memory(data, size, &sourceWidth, &sourceHeight, &components);
+
+    int width = sourceWidth, height = sourceHeight;
+    if (known)
+        this->getDecodeSize(sourceWidth, sourceHeight, &width, &height);
+
+    bool downscale = width != sourceWidth || height != sourceHeight;
+
+    // Every decoded size of a file has its own texture
+    std::string key = cacheKey;
+    if (!key.empty() && downscale)
+        key += fmt::format("#{}x{}", width, height);
+    if (!key.empty() && this->mipmaps)
+        key += "#mipmaps";
+
+    if (!key.empty() && checkCache(key, sourceWidth, sourceHeight) > 0)
+        return;
+
+    // Small cached images are packed into the atlas, whose pages are linear without mipmaps
+    bool atlas = !key.empty() && known && SpriteAtlas::isEnabled() && this->getImageFlags() == 0
+        && width <= SpriteAtlas::MAX_SPRITE_SIZE && height <= SpriteAtlas::MAX_SPRITE_SIZE;
+
+    int tex = 0;
+
+    if (!downscale && !atlas)
+    {
+        BRLS_TRACE_SCOPE("image/decode_upload");
+        tex = nvgCreateImageMem(vg, this->getImageFlags(), const_cast<unsigned char*>(data), size);
+    }
+    else
+    {
+        // Same options as nvgCreateImage()
+        stbi_set_unpremultiply_on_load(1);
+        stbi_convert_iphone_png_to_rgb(1);
+
+        unsigned char* pixels        = nullptr;
+        const unsigned char* decoded = nullptr;
+        std::vector<unsigned char> scaled;
+
+        {
+            BRLS_TRACE_SCOPE("image/decode");
+            pixels  = stbi_load_from_memory(data, size, &sourceWidth, &sourceHeight, &components, 4);
+            decoded = pixels;
+
+            if (pixels && downscale)
+            {
+                ImageFilter filter = this->decodeQuality == ImageDecodeQuality::HIGH ? ImageFilter::LANCZOS : ImageFilter::BOX;
+
+                scaled.resize((size_t)width * height * 4);
+                ImageScaler::resize(pixels, sourceWidth, sourceHeight, scaled.data(), width, height, filter);
+                decoded = scaled.data();
+
+                Logger::verbose("Image: decoded {}x{} image at {}x{}", sourceWidth, sourceHeight, width, height);
+            }
+        }
+
+        if (pixels)
+        {
+            BRLS_TRACE_SCOPE("image/upload");
+
+            if (atlas)
+                tex = SpriteAtlas::add(vg, decoded, width, height);
+
+            if (tex == 0)
+                tex = nvgCreateImageRGBA(vg, width, height, this->getImageFlags(), decoded);
+
+            stbi_image_free(pixels);
+        }
+    }
+
+    this->setTexture(tex, sourceWidth, sourceHeight);
+
+    if (!key.empty())
+        TextureCache::instance().addCache(key, tex);
+}
+
+void Image::setTexture(int tex, int sourceWidth, int sourceHeight)
+{
+    this->sourceWidth  = sourceWidth;
+    this->sourceHeight = sourceHeight;
+
+    // Sprites are drawn from their atlas page
+    if (SpriteAtlas::isSprite(tex))
+    {
+        const SpriteAtlas::Sprite* sprite = SpriteAtlas::get(tex);
+
+        this->nextSprite = tex;
+        tex              = sprite ? sprite->image : 0;
+    }
+
+    this->innerSetImage(tex);
+
+    this->sourceWidth  = 0;
+    this->sourceHeight = 0;
+    this->nextSprite   = 0;
 }
 
 void Image::setImageFromFile(const std::string& path)
 {
     // Let TextureCache to manage when to delete texture
     this->setFreeTexture(false);
+    this->sourcePath = path;
 
-#ifdef USE_LIBROMFS
-    if (path.rfind("@res/", 0) == 0)
-        return this->setImageFromRes(path.substr(5));
-#endif
-    if (checkCache(path) > 0)
+    // Mapped or embedded, decoded without being copied first
+    std::shared_ptr<Asset> asset = AssetStore::open(path);
+    if (!asset)
+    {
+        Logger::error("Cannot open image \"{}\"", path);
         return;
+    }
 
-    // Load texture
-    int tex = nvgCreateImage(Application::getNVGContext(), path.c_str(), this->getImageFlags());
-    innerSetImage(tex);
-
-    // Save cache
-    TextureCache::instance().addCache(path, tex);
+    this->loadImage(path, asset->data(), (int)asset->size());
 }
 
 void Image::setImageFromMem(const unsigned char* data, int size)
 {
-    NVGcontext* vg = Application::getNVGContext();
-
-    // Load texture
-    innerSetImage(nvgCreateImageMem(vg, 0, const_cast<unsigned char*>(data), size));
+    this->sourcePath.clear();
+    this->loadImage("", data, size);
 }
 
 void Image::setImageAsync(std::function<void(std::function<void(const std::string&, size_t length)>)> cb)
@@ -373,36 +596,68 @@ void Image::innerSetImage(int tex)
 
     NVGcontext* vg = Application::getNVGContext();
 
-    // Free the old texture if necessary
-    if (this->texture != 0 && this->freeTexture)
+    // Free the old texture if necessary, pages belong to the atlas
+    if (this->texture != 0 && this->freeTexture && this->sprite == 0)
         nvgDeleteImage(vg, this->texture);
 
+    this->freeSpriteTexture();
+
     // Set the new texture
     this->texture = tex;
+    this->sprite  = this->nextSprite;
 
-    int width, height;
-    nvgImageSize(vg, this->texture, &width, &height);
-    this->originalImageWidth  = (float)width;
-    this->originalImageHeight = (float)height;
+    if (this->sprite != 0)
+    {
+        const SpriteAtlas::Sprite* sprite = SpriteAtlas::get(this->sprite);
+        this->textureWidth                = sprite->width;
+        this->textureHeight               = sprite->height;
+    }
+    else
+    {
+        nvgImageSize(vg, this->texture, &this->textureWidth, &this->textureHeight);
+    }
 
+    // Layout with the dimensions of the image, not of its downscaled texture
+    bool downscaled           = this->sourceWidth > 0 && this->sourceHeight > 0;
+    this->originalImageWidth  = (float)(downscaled ? this->sourceWidth : this->textureWidth);
+    this->originalImageHeight = (float)(downscaled ? this->sourceHeight : this->textureHeight);
+
+    this->invalidateLayoutFrame();
     this->invalidate();
 }
 
 void Image::clear()
 {
+    this->sourcePath.clear();
+
     if (this->texture == 0)
         return;
 
-    if (this->freeTexture)
+    if (this->freeTexture && this->sprite == 0)
         nvgDeleteImage(Application::getNVGContext(), this->texture);
+    else
+        TextureCache::instance().removeCache(this->sprite != 0 ? this->sprite : this->texture);
+
+    this->freeSpriteTexture();
 
     this->texture = 0;
+    this->sprite  = 0;
+}
+
+void Image::freeSpriteTexture()
+{
+    if (this->spriteTexture == 0)
+        return;
+
+    nvgDeleteImage(Application::getNVGContext(), this->spriteTexture);
+    this->spriteTexture = 0;
 }
 
 void Image::setScalingType(ImageScalingType scalingType)
 {
     this->scalingType = scalingType;
 
+    this->invalidateLayoutFrame();
     this->invalidate();
 }
 
@@ -418,9 +673,33 @@ float Image::getOriginalImageWidth()
 
 int Image::getTexture()
 {
+    // Never hand out the whole atlas page
+    if (this->sprite != 0)
+    {
+        if (this->spriteTexture == 0)
+            this->spriteTexture = SpriteAtlas::createTexture(Application::getNVGContext(), this->sprite);
+
+        return this->spriteTexture;
+    }
+
     return this->texture;
 }
 
+bool Image::hasTexture()
+{
+    return this->texture != 0;
+}
+
+int Image::getTextureWidth()
+{
+    return this->textureWidth;
+}
+
+int Image::getTextureHeight()
+{
+    return this->textureHeight;
+}
+
 void Image::setFreeTexture(bool value)
 {
     this->freeTexture = value;
@@ -431,6 +710,11 @@ bool Image::getFreeTexture()
     return this->freeTexture;
 }
 
+bool Image::ownsTexture()
+{
+    return this->freeTexture && this->texture != 0 && this->sprite == 0;
+}
+
 float Image::getOriginalImageHeight()
 {
     return this->originalImageHeight;
@@ -438,10 +722,12 @@ float Image::getOriginalImageHeight()
 
 Image::~Image()
 {
-    if (this->freeTexture && this->texture != 0)
+    if (this->freeTexture && this->texture != 0 && this->sprite == 0)
         nvgDeleteImage(Application::getNVGContext(), this->texture);
     else
-        TextureCache::instance().removeCache(this->texture);
+        TextureCache::instance().removeCache(this->sprite != 0 ? this->sprite : this->texture);
+
+    this->freeSpriteTexture();
 }
 
 View* Image::create()
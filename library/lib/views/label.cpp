@@ -18,14 +18,21 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/thread.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/label.hpp>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
 namespace brls
 {
 
 #define ELLIPSIS "\u2026"
 
+static const ThemeColor TEXT_COLOR = Theme::color("brls/text");
+
 static size_t strLen(const std::string& str)
 {
     size_t res = 0, inc = 0;
@@ -69,9 +76,17 @@ static void computeLabelHeight(Label* label, float width, YGMeasureMode widthMod
     }
 }
 
+// Setup nvg state for the measurements
+static void setupMeasureState(NVGcontext* vg, Label* label)
+{
+    nvgFontSize(vg, label->getFontSize());
+    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    nvgFontFaceId(vg, label->getFont());
+    nvgTextLineHeight(vg, label->getLineHeight());
+}
+
 static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
 {
-    NVGcontext* vg       = Application::getNVGContext();
     auto* label          = (Label*)YGNodeGetContext(node);
     std::string fullText = label->getFullText();
 
@@ -103,22 +118,9 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
         width     = NAN;
     }
 
-    // Setup nvg state for the measurements
-    nvgFontSize(vg, label->getFontSize());
-    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-    nvgFontFaceId(vg, label->getFont());
-    nvgTextLineHeight(vg, label->getLineHeight());
-
-    // Measure the needed width for the ellipsis
     float bounds[4];
-    nvgTextBounds(vg, 0, 0, ELLIPSIS, nullptr, bounds);
-    float ellipsisWidth = bounds[2] - bounds[0];
-    label->setEllipsisWidth(ellipsisWidth);
-
-    // Measure the needed width for the fullText
-    nvgTextBounds(vg, 0, 0, fullText.c_str(), nullptr, bounds);
+    label->getTextBounds(bounds);
     float requiredWidth = bounds[2] - bounds[0] - 0.5f;
-    label->setRequiredWidth(requiredWidth);
 
     // XXX: This is an approximation since the given width here may not match the actual final width of the view
     float availableWidth = std::isnan(width) ? std::numeric_limits<float>::max() : width;
@@ -147,10 +149,7 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
     // Is wrapping necessary and allowed ?
     if ((availableWidth < requiredWidth || fullText.find("\n") != std::string::npos) && !label->isSingleLine())
     {
-        float boxBounds[4];
-        nvgTextBoxBounds(vg, 0, 0, availableWidth, fullText.c_str(), nullptr, boxBounds);
-
-        float requiredHeight = boxBounds[3] - boxBounds[1];
+        float requiredHeight = label->getWrappedTextHeight(availableWidth);
 
         // Undefined height mode, always wrap
         if (heightMode == YGMeasureModeUndefined)
@@ -200,7 +199,7 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
 
 void Label::setCursor(int cursor) {
     this->cursor = cursor;
-    this->cursor_blink = brls::getCPUTimeUsec();
+    this->cursor_blink = brls::getUITimeUsec();
 }
 
 Label::Label()
@@ -212,7 +211,7 @@ Label::Label()
     this->font        = Application::getDefaultFont();
     this->fontSize    = style["brls/label/default_font_size"];
     this->lineHeight  = style["brls/label/default_line_height"];
-    this->textColor   = theme["brls/text"];
+    this->textColor   = theme[TEXT_COLOR];
     this->fontQuality = 1.0f;
 
     this->setHighlightPadding(style["brls/label/highlight_padding"]);
@@ -330,58 +329,184 @@ void Label::onParentFocusLost(View* focusedView)
 
 void Label::setTextColor(NVGcolor color)
 {
-    this->textColor = color;
+    this->textColor        = color;
+    this->defaultTextColor = false;
 }
 
+void Label::onThemeChanged()
+{
+    if (this->defaultTextColor)
+        this->textColor = Application::getTheme()["brls/text"];
+
+    View::onThemeChanged();
+}
+
+#if defined(OPENCC) && not defined(USE_LIBROMFS)
+// Last conversions made by Label::STConverter(), texts set again and again
+// (clocks, progress, recycled cells) are only converted once
+class ConversionCache
+{
+  public:
+    static constexpr size_t MAX_BYTES = 256 * 1024;
+
+    bool get(const std::string& text, std::string* converted)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        auto entry = this->entries.find(text);
+        if (entry == this->entries.end())
+            return false;
+
+        // Move to the front, the least recently used conversions are at the back
+        this->order.splice(this->order.begin(), this->order, entry->second);
+        *converted = entry->second->second;
+        return true;
+    }
+
+    void set(const std::string& text, const std::string& converted)
+    {
+        size_t bytes = text.size() * 2 + converted.size();
+        if (bytes > MAX_BYTES)
+            return;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (this->entries.count(text))
+            return;
+
+        while (!this->order.empty() && this->bytes + bytes > MAX_BYTES)
+        {
+            auto& last = this->order.back();
+            this->bytes -= last.first.size() * 2 + last.second.size();
+            this->entries.erase(last.first);
+            this->order.pop_back();
+        }
+
+        this->order.emplace_front(text, converted);
+        this->entries[text] = this->order.begin();
+        this->bytes += bytes;
+    }
+
+  private:
+    std::mutex mutex;
+    std::list<std::pair<std::string, std::string>> order;
+    std::unordered_map<std::string, std::list<std::pair<std::string, std::string>>::iterator> entries;
+    size_t bytes = 0;
+};
+
+static ConversionCache conversionCache;
+#endif
+
 std::string Label::STConverter(const std::string& text)
 {
 #if defined(OPENCC) && not defined(USE_LIBROMFS)
     static bool skip = Application::getLocale() != LOCALE_ZH_HANT && Application::getLocale() != LOCALE_ZH_TW;
     if (skip || !OPENCC_ON)
         return text;
+
+    std::string converted;
+    if (conversionCache.get(text, &converted))
+        return converted;
+
     static opencc::SimpleConverter converter = opencc::SimpleConverter(std::string(BRLS_RESOURCES) + "opencc/s2t.json");
-    return converter.Convert(text);
+    converted = converter.Convert(text);
+    conversionCache.set(text, converted);
+    return converted;
 #endif
     return text;
 }
 
-void Label::setText(const std::string& text)
+static bool needsConversion()
 {
 #ifdef OPENCC
     static bool trans = Application::getLocale() == LOCALE_ZH_HANT || Application::getLocale() == LOCALE_ZH_TW;
-    if (trans && OPENCC_ON)
+    return trans && Label::OPENCC_ON;
+#else
+    return false;
+#endif
+}
+
+void Label::setText(const std::string& text)
+{
+    this->textRequest++;
+
+    if (needsConversion())
+        this->applyText(Label::STConverter(text));
+    else
+        this->applyText(text);
+}
+
+void Label::setTextAsync(const std::string& text)
+{
+    if (!needsConversion() || text.size() < Label::ASYNC_CONVERSION_LENGTH)
     {
-        this->truncatedText = Label::STConverter(text);
-        this->fullText      = this->truncatedText;
-        this->stringLength  = strLen(this->fullText);
+        this->setText(text);
+        return;
     }
-    else
+
+    // Newer texts set in the meantime win over this one
+    size_t request = ++this->textRequest;
+
+    ASYNC_RETAIN
+    brls::async([ASYNC_TOKEN, text, request]()
+        {
+            std::string converted = Label::STConverter(text);
+            brls::sync([ASYNC_TOKEN, converted, request]()
+                {
+                    ASYNC_RELEASE
+                    if (request == this->textRequest)
+                        this->applyText(converted);
+                });
+        });
+}
+
+void Label::applyText(const std::string& text)
+{
+    if (text == this->fullText)
+        return;
+
+    this->fullText        = text;
+    this->stringLength    = strLen(text);
+    this->textBoundsValid = false;
+
+    // The frame of a label of fixed size doesn't depend on its text:
+    // truncate the new text in place instead of laying out the whole tree again
+    if (this->hasFixedSize())
     {
-        this->truncatedText = text;
-        this->fullText      = text;
-        this->stringLength  = strLen(this->fullText);
+        float bounds[4];
+        this->getTextBounds(bounds);
+        this->onLayout();
+        return;
     }
-    this->invalidate();
-#else
+
     this->truncatedText = text;
-    this->fullText      = text;
-    this->stringLength  = strLen(text);
 
+    this->invalidateLayoutFrame();
     this->invalidate();
-#endif
+}
+
+bool Label::hasFixedSize()
+{
+    // Yoga doesn't measure nodes whose both dimensions are set, so their text is never wrapped
+    return YGNodeStyleGetWidth(this->ygNode).unit == YGUnitPoint
+        && YGNodeStyleGetHeight(this->ygNode).unit == YGUnitPoint
+        && this->getWidth() > 0 && !this->isWrapping;
 }
 
 void Label::setSingleLine(bool singleLine)
 {
     this->singleLine = singleLine;
 
+    this->invalidateLayoutFrame();
     this->invalidate();
 }
 
 void Label::setFontSize(float value)
 {
-    this->fontSize = value;
+    this->fontSize        = value;
+    this->textBoundsValid = false;
 
+    this->invalidateLayoutFrame();
     this->invalidate();
 }
 
@@ -394,8 +519,10 @@ void Label::setFontQuality(float value)
 
 void Label::setLineHeight(float value)
 {
-    this->lineHeight = value;
+    this->lineHeight      = value;
+    this->textBoundsValid = false;
 
+    this->invalidateLayoutFrame();
     this->invalidate();
 }
 
@@ -498,7 +625,7 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
         // 绘制编辑游标
         if (this->cursor >= (int)CursorPosition::END) {
             // blink
-            auto blink = ((brls::getCPUTimeUsec() - cursor_blink) >> 10) % 1000 ;
+            auto blink = ((brls::getUITimeUsec() - cursor_blink) >> 10) % 1000 ;
             if (blink > 500)
                 return;
 
@@ -681,6 +808,46 @@ std::string Label::getFullText()
     return this->fullText;
 }
 
+void Label::getTextBounds(float* bounds)
+{
+    if (!this->textBoundsValid)
+    {
+        NVGcontext* vg = Application::getNVGContext();
+        setupMeasureState(vg, this);
+
+        // Measure the needed width for the ellipsis
+        nvgTextBounds(vg, 0, 0, ELLIPSIS, nullptr, this->textBounds);
+        this->setEllipsisWidth(this->textBounds[2] - this->textBounds[0]);
+
+        // Measure the needed width for the fullText
+        nvgTextBounds(vg, 0, 0, this->fullText.c_str(), nullptr, this->textBounds);
+        this->setRequiredWidth(this->textBounds[2] - this->textBounds[0] - 0.5f);
+
+        this->textBoundsValid = true;
+        this->wrappedWidth    = NAN;
+    }
+
+    memcpy(bounds, this->textBounds, sizeof(this->textBounds));
+}
+
+float Label::getWrappedTextHeight(float width)
+{
+    // Also false while wrappedWidth is NAN
+    if (!this->textBoundsValid || this->wrappedWidth != width)
+    {
+        NVGcontext* vg = Application::getNVGContext();
+        setupMeasureState(vg, this);
+
+        float boxBounds[4];
+        nvgTextBoxBounds(vg, 0, 0, width, this->fullText.c_str(), nullptr, boxBounds);
+
+        this->wrappedHeight = boxBounds[3] - boxBounds[1];
+        this->wrappedWidth  = width;
+    }
+
+    return this->wrappedHeight;
+}
+
 void Label::setRequiredWidth(float requiredWidth)
 {
     this->requiredWidth = requiredWidth;
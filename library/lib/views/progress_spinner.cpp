@@ -21,6 +21,8 @@
 namespace brls
 {
 
+static const ThemeColor BAR_COLOR = Theme::color("brls/spinner/bar_color");
+
 ProgressSpinner::ProgressSpinner(ProgressSpinnerSize size)
     : size(size)
 {
@@ -60,8 +62,8 @@ void ProgressSpinner::animate(bool animate)
 
 void ProgressSpinner::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
-    Theme theme       = Application::getTheme();
-    NVGcolor barColor = a(theme["brls/spinner/bar_color"]);
+    NVGcolor themeColor = ctx->theme[BAR_COLOR];
+    NVGcolor barColor   = a(themeColor);
 
     // Each bar of the spinner
     switch (size)
@@ -69,7 +71,7 @@ void ProgressSpinner::draw(NVGcontext* vg, float x, float y, float width, float
         case NORMAL:
             for (int i = 0 + animationValue; i < 8 + animationValue; i++)
             {
-                barColor.a = fmax((i - animationValue) / 8.0f, theme["brls/spinner/bar_color"].a) * this->getAlpha();
+                barColor.a = fmax((i - animationValue) / 8.0f, themeColor.a) * this->getAlpha();
                 nvgSave(vg);
                 nvgTranslate(vg, x + width / 2, y + height / 2);
                 nvgRotate(vg, nvgDegToRad(i * 45)); // Internal angle of octagon
@@ -86,7 +88,7 @@ void ProgressSpinner::draw(NVGcontext* vg, float x, float y, float width, float
         case LARGE:
             for (int i = 0 + animationValue; i < 12 + animationValue; i++)
             {
-                barColor.a = fmax((i - animationValue) / 12.0f, theme["brls/spinner/bar_color"].a) * this->getAlpha();
+                barColor.a = fmax((i - animationValue) / 12.0f, themeColor.a) * this->getAlpha();
                 nvgSave(vg);
                 nvgTranslate(vg, x + width / 2, y + height / 2);
                 nvgRotate(vg, nvgDegToRad(i * 30)); // Internal angle of octagon
@@ -400,7 +400,7 @@ void RecyclerFrame::cellsRecyclingLoop()
         queueReusableCell(minCell);
         this->contentBox->removeView(minCell, false);
 
-        Logger::debug("Cell #{} - destroyed", visibleMin);
+        Logger::deferred<LogLevel::LOG_DEBUG>("Cell #{} - destroyed", visibleMin);
 
         visibleMin++;
     }
@@ -421,7 +421,7 @@ void RecyclerFrame::cellsRecyclingLoop()
         queueReusableCell(maxCell);
         this->contentBox->removeView(maxCell, false);
 
-        Logger::debug("Cell #{} - destroyed", visibleMax);
+        Logger::deferred<LogLevel::LOG_DEBUG>("Cell #{} - destroyed", visibleMax);
 
         visibleMax--;
     }
@@ -491,7 +491,7 @@ void RecyclerFrame::addCellAt(size_t index, size_t downSide)
         cacheFramesData[index].height = cellFrame.getHeight();
     }
 
-    Logger::debug("Cell #{} - added", index);
+    Logger::deferred<LogLevel::LOG_DEBUG>("Cell #{} - added", index);
 }
 
 void RecyclerFrame::onLayout()
@@ -23,6 +23,8 @@
 namespace brls
 {
 
+static const ThemeColor INDICATOR_COLOR = Theme::color("brls/text");
+
 #define SCROLLING_INDICATOR_WIDTH 4
 
 ScrollingFrame::ScrollingFrame()
@@ -36,7 +38,6 @@ ScrollingFrame::ScrollingFrame()
 
     setupScrollingIndicator();
 
-    input = Application::getPlatform()->getInputManager();
     this->setFocusable(true);
     this->setMaximumAllowedXMLElements(1);
 
@@ -99,10 +100,18 @@ ScrollingFrame::ScrollingFrame()
     setHideHighlightBorder(true);
 }
 
+void ScrollingFrame::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    if (scrollingIndicator)
+        scrollingIndicator->setColor(Application::getTheme()["brls/text"]);
+}
+
 void ScrollingFrame::setupScrollingIndicator()
 {
     Theme theme        = Application::getTheme();
-    scrollingIndicator = new Rectangle(theme["brls/text"]);
+    scrollingIndicator = new Rectangle(theme[INDICATOR_COLOR]);
     scrollingIndicator->setSize(Size(SCROLLING_INDICATOR_WIDTH, 0));
     scrollingIndicator->setCornerRadius(SCROLLING_INDICATOR_WIDTH / 2);
     scrollingIndicator->detach();
@@ -184,7 +193,7 @@ void ScrollingFrame::naturalScrollingBehaviour()
     if (focused || childFocused)
     {
         ControllerState state{};
-        input->updateUnifiedControllerState(&state);
+        Application::getInputManager()->updateUnifiedControllerState(&state);
         float bottomLimit = this->getContentHeight() - this->getScrollingAreaHeight();
 
         // Sets true on border hit to play sound only once
@@ -315,6 +324,7 @@ void ScrollingFrame::setContentView(View* view)
     view->setCulled(false);
     view->setWidth(this->getWidth());
 
+    this->invalidateLayoutFrame();
     Box::addView(view); // will invalidate the scrolling box, hence calling onLayout and invalidating the contentView
 }
 
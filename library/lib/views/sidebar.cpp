@@ -26,6 +26,10 @@ using namespace brls::literals;
 namespace brls
 {
 
+static const ThemeColor ACTIVE_ITEM_COLOR = Theme::color("brls/sidebar/active_item");
+static const ThemeColor TEXT_COLOR        = Theme::color("brls/text");
+static const ThemeColor SEPARATOR_COLOR   = Theme::color("brls/sidebar/separator");
+
 const std::string sidebarItemXML = R"xml(
     <brls:Box
         width="auto"
@@ -110,17 +114,25 @@ void SidebarItem::setActive(bool active)
         this->activeEvent.fire(this);
 
         this->accent->setVisibility(Visibility::VISIBLE);
-        this->label->setTextColor(theme["brls/sidebar/active_item"]);
+        this->label->setTextColor(theme[ACTIVE_ITEM_COLOR]);
     }
     else
     {
         this->accent->setVisibility(Visibility::INVISIBLE);
-        this->label->setTextColor(theme["brls/text"]);
+        this->label->setTextColor(theme[TEXT_COLOR]);
     }
 
     this->active = active;
 }
 
+void SidebarItem::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    Theme theme = Application::getTheme();
+    this->label->setTextColor(this->active ? theme[ACTIVE_ITEM_COLOR] : theme[TEXT_COLOR]);
+}
+
 void SidebarItem::onFocusGained()
 {
     Box::onFocusGained();
@@ -236,7 +248,7 @@ void SidebarSeparator::draw(NVGcontext* vg, float x, float y, float width, float
     float midY = y + height / 2;
 
     nvgBeginPath(vg);
-    nvgFillColor(vg, a(ctx->theme["brls/sidebar/separator"]));
+    nvgFillColor(vg, a(ctx->theme[SEPARATOR_COLOR]));
     nvgRect(vg, x, midY, width, 1);
     nvgFill(vg);
 }
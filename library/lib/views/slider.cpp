@@ -22,10 +22,13 @@
 namespace brls
 {
 
+static const ThemeColor POINTER_COLOR        = Theme::color("brls/slider/pointer_color");
+static const ThemeColor POINTER_BORDER_COLOR = Theme::color("brls/slider/pointer_border_color");
+static const ThemeColor LINE_FILLED_COLOR    = Theme::color("brls/slider/line_filled");
+static const ThemeColor LINE_EMPTY_COLOR     = Theme::color("brls/slider/line_empty");
+
 Slider::Slider()
 {
-    input = Application::getPlatform()->getInputManager();
-
     line      = new Rectangle();
     lineEmpty = new Rectangle();
     pointer   = new Rectangle();
@@ -56,11 +59,11 @@ Slider::Slider()
     pointer->setFocusable(true);
 
     Theme theme = Application::getTheme();
-    pointer->setColor(theme["brls/slider/pointer_color"]);
-    pointer->setBorderColor(theme["brls/slider/pointer_border_color"]);
+    pointer->setColor(theme[POINTER_COLOR]);
+    pointer->setBorderColor(theme[POINTER_BORDER_COLOR]);
 
-    line->setColor(theme["brls/slider/line_filled"]);
-    lineEmpty->setColor(theme["brls/slider/line_empty"]);
+    line->setColor(theme[LINE_FILLED_COLOR]);
+    lineEmpty->setColor(theme[LINE_EMPTY_COLOR]);
 
     pointer->registerAction(
         "Right Click Blocker", BUTTON_NAV_RIGHT, [](View* view)
@@ -134,7 +137,7 @@ void Slider::buttonsProcessing()
     if (pointer->isFocused())
     {
         ControllerState state;
-        input->updateUnifiedControllerState(&state);
+        Application::getInputManager()->updateUnifiedControllerState(&state);
         static bool repeat = false;
 
         if (state.buttons[BUTTON_NAV_RIGHT] && state.buttons[BUTTON_NAV_LEFT])
@@ -191,9 +194,29 @@ void Slider::setProgress(float progress)
     updateUI();
 }
 
+void Slider::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    Theme theme = Application::getTheme();
+    line->setColor(theme[LINE_FILLED_COLOR]);
+    lineEmpty->setColor(theme[LINE_EMPTY_COLOR]);
+
+    // The hidden pointer is drawn as part of the line
+    if (pointer->getBorderThickness() > 0.0f)
+    {
+        pointer->setColor(theme[POINTER_COLOR]);
+        pointer->setBorderColor(theme[POINTER_BORDER_COLOR]);
+    }
+    else
+    {
+        pointer->setColor(theme[LINE_FILLED_COLOR]);
+    }
+}
+
 void Slider::hidePointer() {
     Theme theme = Application::getTheme();
-    pointer->setColor(theme["brls/slider/line_filled"]);
+    pointer->setColor(theme[LINE_FILLED_COLOR]);
     pointer->setTranslationX(-3.5);
     pointer->setWidth(14);
     pointer->setHeight(7);
@@ -204,8 +227,8 @@ void Slider::hidePointer() {
 
 void Slider::showPointer() {
     Theme theme = Application::getTheme();
-    pointer->setColor(theme["brls/slider/pointer_color"]);
-    pointer->setBorderColor(theme["brls/slider/pointer_border_color"]);
+    pointer->setColor(theme[POINTER_COLOR]);
+    pointer->setBorderColor(theme[POINTER_BORDER_COLOR]);
     pointer->setHeight(38);
     pointer->setWidth(38);
     pointer->setCornerRadius(19);
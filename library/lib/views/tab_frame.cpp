@@ -100,6 +100,11 @@ void TabFrame::addSeparator()
     this->sidebar->addSeparator();
 }
 
+bool TabFrame::canAddXMLChildView()
+{
+    return false;
+}
+
 void TabFrame::handleXMLElement(tinyxml2::XMLElement* element)
 {
     std::string name = element->Name();
@@ -16,7 +16,7 @@
 
 #include "borealis/views/widgets/battery.hpp"
 
-#include "borealis/core/thread.hpp"
+#include <algorithm>
 
 #define BATTERY_MAX_WIDTH 23.0f
 
@@ -41,33 +41,46 @@ BatteryWidget::BatteryWidget()
     level->setSize(Size(BATTERY_MAX_WIDTH, 10));
     level->detach();
 
-    applyBackTheme(platform->getThemeVariant());
-    applyLevelTheme(platform->getThemeVariant());
+    applyBackTheme(Application::getThemeVariant());
+    applyLevelTheme(Application::getThemeVariant());
 
     addView(level);
     addView(back);
+
+    applyStatus(*SystemStatusService::getSnapshot());
+    statusSubscription = SystemStatusService::subscribe([this](std::shared_ptr<const SystemStatus> status)
+        { applyStatus(*status); });
+    subscribed = true;
 }
 
-void BatteryWidget::updateState()
+BatteryWidget::~BatteryWidget()
 {
-    static Time time = 0;
-    Time now         = getCPUTimeUsec();
-    if ((now - time) > 5000000)
-    {
-        brls::Logger::verbose("isBatteryCharging: {}; batteryLevel: {}", isBatteryCharging, batteryLevel);
-#ifdef ANDROID
-        isBatteryCharging = Application::getPlatform()->isBatteryCharging();
-        batteryLevel      = Application::getPlatform()->getBatteryLevel() / 100.0f;
-#else
-        ASYNC_RETAIN
-        brls::async([ASYNC_TOKEN]()
-            {
-                ASYNC_RELEASE
-                isBatteryCharging = Application::getPlatform()->isBatteryCharging();
-                batteryLevel      = Application::getPlatform()->getBatteryLevel() / 100.0f; });
-#endif
-        time = now;
-    }
+    if (subscribed)
+        SystemStatusService::unsubscribe(statusSubscription);
+}
+
+void BatteryWidget::applyStatus(const SystemStatus& status)
+{
+    isBatteryCharging = status.batteryCharging;
+    batteryLevel      = std::min(std::max(status.batteryLevel, 0), 100) / 100.0f;
+
+    if (isBatteryCharging)
+        level->setColor(RGB(140, 251, 79));
+    else
+        applyLevelTheme(Application::getThemeVariant());
+
+    level->setWidth(BATTERY_MAX_WIDTH * batteryLevel);
+}
+
+void BatteryWidget::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    if (!subscribed)
+        return;
+
+    applyBackTheme(Application::getThemeVariant());
+    applyStatus(*SystemStatusService::getSnapshot());
 }
 
 void BatteryWidget::applyBackTheme(ThemeVariant theme)
@@ -96,18 +109,6 @@ void BatteryWidget::applyLevelTheme(ThemeVariant theme)
     }
 }
 
-void BatteryWidget::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
-{
-    this->updateState();
-    if (isBatteryCharging)
-        level->setColor(RGB(140, 251, 79));
-    else
-        applyLevelTheme(platform->getThemeVariant());
-
-    level->setWidth(BATTERY_MAX_WIDTH * batteryLevel);
-    Box::draw(vg, x, y, width, height, style, ctx);
-}
-
 View* BatteryWidget::create()
 {
     return new BatteryWidget();
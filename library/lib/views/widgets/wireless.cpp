@@ -16,15 +16,6 @@
 
 #include "borealis/views/widgets/wireless.hpp"
 
-#include "borealis/core/thread.hpp"
-
-#ifdef __SWITCH__
-extern "C"
-{
-#include <switch/services/nifm.h>
-}
-#endif
-
 namespace brls
 {
 
@@ -61,14 +52,32 @@ WirelessWidget::WirelessWidget()
     ethernet->setScalingType(ImageScalingType::FIT);
     ethernet->detach();
 
-    platform = Application::getPlatform();
-    applyTheme(platform->getThemeVariant());
+    applyTheme(Application::getThemeVariant());
 
     addView(_0);
     addView(_1);
     addView(_2);
     addView(_3);
     addView(ethernet);
+
+    applyStatus(*SystemStatusService::getSnapshot());
+    statusSubscription = SystemStatusService::subscribe([this](std::shared_ptr<const SystemStatus> status)
+        { applyStatus(*status); });
+    subscribed = true;
+}
+
+WirelessWidget::~WirelessWidget()
+{
+    if (subscribed)
+        SystemStatusService::unsubscribe(statusSubscription);
+}
+
+void WirelessWidget::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    if (subscribed)
+        applyTheme(Application::getThemeVariant());
 }
 
 void WirelessWidget::applyTheme(ThemeVariant theme)
@@ -92,58 +101,9 @@ void WirelessWidget::applyTheme(ThemeVariant theme)
     }
 }
 
-void WirelessWidget::updateState()
-{
-    static Time time = 0;
-    Time now         = getCPUTimeUsec();
-    if ((now - time) > 5000000 || time == 0)
-    {
-        brls::Logger::verbose("hasWirelessConnection: {}; wifiLevel: {}", hasWirelessConnection, wifiLevel);
-#ifdef ANDROID
-        hasEthernetConnection = Application::getPlatform()->hasEthernetConnection();
-        hasWirelessConnection = Application::getPlatform()->hasWirelessConnection();
-        wifiLevel             = Application::getPlatform()->getWirelessLevel();
-#else
-        ASYNC_RETAIN
-        brls::async([ASYNC_TOKEN]()
-            {
-                ASYNC_RELEASE
-#ifdef __SWITCH__
-                // Reduce service calls
-                // and fix support for emulator (Ryujinx) as it doesn't support :
-                // nifmIsWirelessCommunicationEnabled() / nifmIsEthernetCommunicationEnabled().
-                NifmInternetConnectionType type;
-                u32 wifiSignal;
-                NifmInternetConnectionStatus status;
-                Result ret            = nifmGetInternetConnectionStatus(&type, &wifiSignal, &status);
-                hasEthernetConnection = type == NifmInternetConnectionType_Ethernet;
-                hasWirelessConnection = type == NifmInternetConnectionType_WiFi;
-                if (ret != 0)
-                {
-                    hasEthernetConnection = false;
-                    hasWirelessConnection = false;
-                    wifiLevel             = 0;
-                }
-                else
-                {
-                    wifiLevel = (int)wifiSignal;
-                }
-#else
-                hasEthernetConnection = Application::getPlatform()->hasEthernetConnection();
-                hasWirelessConnection = Application::getPlatform()->hasWirelessConnection();
-                wifiLevel             = Application::getPlatform()->getWirelessLevel();
-#endif
-            });
-#endif
-        time = now;
-    }
-}
-
-void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+void WirelessWidget::applyStatus(const SystemStatus& status)
 {
-    updateState();
-
-    if (hasEthernetConnection)
+    if (status.ethernetConnected)
     {
         _0->setVisibility(Visibility::GONE);
         _1->setVisibility(Visibility::GONE);
@@ -151,7 +111,7 @@ void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float h
         _3->setVisibility(Visibility::GONE);
         ethernet->setVisibility(Visibility::VISIBLE);
     }
-    else if (!hasWirelessConnection)
+    else if (!status.wirelessConnected)
     {
         _0->setVisibility(Visibility::VISIBLE);
         _1->setVisibility(Visibility::GONE);
@@ -167,7 +127,7 @@ void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float h
         _3->setVisibility(Visibility::VISIBLE);
         ethernet->setVisibility(Visibility::GONE);
 
-        switch (wifiLevel)
+        switch (status.wirelessLevel)
         {
             case 0:
                 _1->setAlpha(0.2f);
@@ -191,8 +151,6 @@ void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float h
                 break;
         }
     }
-
-    Box::draw(vg, x, y, width, height, style, ctx);
 }
 
 View* WirelessWidget::create()